@@ -0,0 +1,69 @@
+#include "test.h"
+#include <tick/adaptive_mutex.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_basic_lockable<tick::adaptive_mutex>);
+    TICK_TRAIT_CHECK(tick::is_lockable<tick::adaptive_mutex>);
+    TICK_TRAIT_CHECK(tick::is_timed_lockable<tick::adaptive_mutex>);
+    static_assert(!tick::is_shared_lockable<tick::adaptive_mutex>(), "Mutex is shared");
+    static_assert(!tick::is_lockable<const tick::adaptive_mutex>(), "Const mutex is lockable");
+};
+
+TICK_TEST_CASE()
+{
+    tick::adaptive_mutex m;
+    TICK_TEST_CHECK(m.try_lock());
+    TICK_TEST_CHECK(!m.try_lock());
+    m.unlock();
+    {
+        std::lock_guard<tick::adaptive_mutex> lock(m);
+        TICK_TEST_CHECK(!m.try_lock());
+    }
+    TICK_TEST_CHECK(m.try_lock_for(std::chrono::milliseconds(1)));
+    m.unlock();
+}
+
+TICK_TEST_CASE()
+{
+    // More threads than cores, so that some of them have to sleep
+    const int threads = 8;
+    const int iterations = 20000;
+    tick::adaptive_mutex m;
+    long counter = 0;
+    std::vector<std::thread> workers;
+    for(int i=0;i<threads;i++) workers.emplace_back([&]
+    {
+        for(int j=0;j<iterations;j++)
+        {
+            std::lock_guard<tick::adaptive_mutex> lock(m);
+            counter++;
+        }
+    });
+    for(std::thread& t:workers) t.join();
+    TICK_TEST_CHECK(counter == long(threads) * iterations);
+}
+
+TICK_TEST_CASE()
+{
+    tick::adaptive_mutex m;
+    m.lock();
+    bool timed_out = false;
+    bool acquired = false;
+    std::thread t([&]
+    {
+        timed_out = !m.try_lock_for(std::chrono::milliseconds(20));
+        acquired = m.try_lock_until(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+        if (acquired) m.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    m.unlock();
+    t.join();
+    TICK_TEST_CHECK(timed_out);
+    TICK_TEST_CHECK(acquired);
+}
@@ -0,0 +1,228 @@
+#include "test.h"
+#include <tick/algorithm.h>
+#include <tick/trait_check.h>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <vector>
+
+// A sequence stored as a list of vectors. The last segment is always empty,
+// so the end iterator points to the start of it.
+struct chunked_iterator
+{
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef int* pointer;
+    typedef int& reference;
+
+    std::list<std::vector<int>>::iterator segment;
+    int* local;
+
+    int& operator*() const
+    {
+        return *local;
+    }
+
+    int* operator->() const
+    {
+        return local;
+    }
+
+    chunked_iterator& operator++()
+    {
+        if (++local == segment->data() + segment->size())
+        {
+            ++segment;
+            local = segment->data();
+        }
+        return *this;
+    }
+
+    chunked_iterator operator++(int)
+    {
+        chunked_iterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    friend bool operator==(const chunked_iterator& x, const chunked_iterator& y)
+    {
+        return x.local == y.local;
+    }
+
+    friend bool operator!=(const chunked_iterator& x, const chunked_iterator& y)
+    {
+        return x.local != y.local;
+    }
+};
+
+namespace tick {
+
+template<>
+struct segmented_iterator_traits<chunked_iterator>
+{
+    typedef std::list<std::vector<int>>::iterator segment_iterator;
+    typedef int* local_iterator;
+
+    static segment_iterator segment(const chunked_iterator& i)
+    {
+        return i.segment;
+    }
+
+    static local_iterator local(const chunked_iterator& i)
+    {
+        return i.local;
+    }
+
+    static local_iterator begin(segment_iterator s)
+    {
+        return s->data();
+    }
+
+    static local_iterator end(segment_iterator s)
+    {
+        return s->data() + s->size();
+    }
+
+    static chunked_iterator compose(segment_iterator s, local_iterator l)
+    {
+        if (l == end(s)) l = (++s)->data();
+        chunked_iterator i = { s, l };
+        return i;
+    }
+};
+
+}
+
+struct chunked
+{
+    std::list<std::vector<int>> segments;
+
+    chunked(std::initializer_list<std::size_t> sizes)
+    {
+        for(std::size_t n:sizes) segments.push_back(std::vector<int>(n));
+        segments.push_back(std::vector<int>(1));
+    }
+
+    chunked_iterator begin()
+    {
+        chunked_iterator i = { segments.begin(), segments.front().data() };
+        return i;
+    }
+
+    chunked_iterator end()
+    {
+        chunked_iterator i = { std::prev(segments.end()), segments.back().data() };
+        return i;
+    }
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_segmented_iterator<chunked_iterator>);
+    static_assert(std::is_base_of<tick::tag<tick::is_segmented_iterator>, tick::most_refined<tick::is_segmented_iterator<chunked_iterator>>>(), "Not segmented");
+    static_assert(!std::is_base_of<tick::tag<tick::is_segmented_iterator>, tick::most_refined<tick::is_segmented_iterator<int*>>>(), "Segmented");
+};
+
+TICK_TEST_CASE()
+{
+    chunked c = { 3, 1, 4 };
+    std::vector<int> v(8);
+    std::iota(v.begin(), v.end(), 1);
+    TICK_TEST_CHECK(tick::copy(v.begin(), v.end(), c.begin()) == c.end());
+    TICK_TEST_CHECK(std::equal(v.begin(), v.end(), c.begin()));
+
+    std::vector<int> out;
+    tick::copy(c.begin(), c.end(), std::back_inserter(out));
+    TICK_TEST_CHECK(out == v);
+
+    int sum = 0;
+    tick::for_each(c.begin(), c.end(), [&](int x) { sum += x; });
+    TICK_TEST_CHECK(sum == 36);
+
+    for(int i=1;i<=8;i++) TICK_TEST_CHECK(*tick::find(c.begin(), c.end(), i) == i);
+    TICK_TEST_CHECK(tick::find(c.begin(), c.end(), 9) == c.end());
+    chunked_iterator second = std::next(c.begin(), 4);
+    TICK_TEST_CHECK(tick::find(second, c.end(), 2) == c.end());
+    TICK_TEST_CHECK(tick::find(c.begin(), second, 5) == second);
+
+    tick::fill(std::next(c.begin()), std::next(c.begin(), 7), 0);
+    std::vector<int> filled = { 1, 0, 0, 0, 0, 0, 0, 8 };
+    TICK_TEST_CHECK(std::equal(filled.begin(), filled.end(), c.begin()));
+}
+
+TICK_TEST_CASE()
+{
+    std::deque<int> d(10000);
+    tick::fill(d.begin(), d.end(), 1);
+    TICK_TEST_CHECK(std::count(d.begin(), d.end(), 1) == 10000);
+
+    std::vector<int> v(9000);
+    std::iota(v.begin(), v.end(), 0);
+    std::deque<int>::iterator it = tick::copy(v.begin(), v.end(), d.begin() + 500);
+    TICK_TEST_CHECK(it == d.begin() + 9500);
+    TICK_TEST_CHECK(std::equal(v.begin(), v.end(), d.begin() + 500));
+    TICK_TEST_CHECK(d[499] == 1 and d[9500] == 1);
+
+    std::vector<int> out(d.size());
+    TICK_TEST_CHECK(tick::copy(d.cbegin(), d.cend(), out.begin()) == out.end());
+    TICK_TEST_CHECK(std::equal(d.begin(), d.end(), out.begin()));
+
+    std::deque<int> copy(d.size());
+    TICK_TEST_CHECK(tick::copy(d.begin(), d.end(), copy.begin()) == copy.end());
+    TICK_TEST_CHECK(d == copy);
+
+    TICK_TEST_CHECK(tick::find(d.begin(), d.end(), 8999) == d.begin() + 9499);
+    TICK_TEST_CHECK(tick::find(d.cbegin(), d.cend(), -1) == d.cend());
+
+    long long sum = 0;
+    tick::for_each(d.begin() + 500, d.begin() + 9500, [&](int x) { sum += x; });
+    TICK_TEST_CHECK(sum == 8999LL * 9000 / 2);
+
+    // Ends exactly at the end of a block
+    std::deque<int> blocks(v.begin(), v.begin() + 512);
+    TICK_TEST_CHECK(tick::copy(v.begin() + 1, v.begin() + 513, blocks.begin()) == blocks.end());
+    TICK_TEST_CHECK(blocks.front() == 1 and blocks.back() == 512);
+}
+
+enum class color : unsigned char
+{
+    red, green, blue
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(tick::detail::is_memcmp_comparable<const int*, int*>(), "Not memcmp comparable");
+    static_assert(tick::detail::is_memcmp_comparable<std::pair<int, int>*, std::pair<int, int>*>(), "Not memcmp comparable");
+    static_assert(!tick::detail::is_memcmp_comparable<double*, double*>(), "Memcmp comparable");
+    static_assert(!tick::detail::is_memcmp_comparable<int*, long*>(), "Memcmp comparable");
+    static_assert(!tick::detail::is_memcmp_comparable<std::vector<int>::iterator, int*>(), "Memcmp comparable");
+};
+
+TICK_TEST_CASE()
+{
+    std::pair<long long, long long> a[] = { {1, 2}, {3, 4}, {5, 6} };
+    std::pair<long long, long long> b[] = { {1, 2}, {3, 4}, {5, 7} };
+    TICK_TEST_CHECK(tick::equal(a, a + 2, b));
+    TICK_TEST_CHECK(!tick::equal(a, a + 3, b));
+    TICK_TEST_CHECK(tick::equal(a, a, b));
+    TICK_TEST_CHECK(tick::equal(a, a + 2, b, b + 2));
+    TICK_TEST_CHECK(!tick::equal(a, a + 2, b, b + 3));
+
+    color c[] = { color::red, color::blue };
+    const color* cc = c;
+    TICK_TEST_CHECK(tick::equal(c, c + 2, cc));
+
+    // Floats compare by value, not by representation
+    double zeros[] = { 0.0 };
+    double negative_zeros[] = { -0.0 };
+    TICK_TEST_CHECK(tick::equal(zeros, zeros + 1, negative_zeros));
+
+    std::list<int> l = { 1, 2, 3 };
+    std::vector<int> v = { 1, 2, 3 };
+    TICK_TEST_CHECK(tick::equal(l.begin(), l.end(), v.begin()));
+    TICK_TEST_CHECK(!tick::equal(l.begin(), l.end(), v.begin(), v.begin() + 2));
+    TICK_TEST_CHECK(tick::equal(l.begin(), l.end(), l.begin(), l.end()));
+}
@@ -0,0 +1,73 @@
+#include "test.h"
+#include <tick/allocate_at_least.h>
+#include <tick/pool_allocator.h>
+#include <tick/small_vector.h>
+#include <tick/trait_check.h>
+#include <tick/traits/is_always_equal_allocator.h>
+#include <tick/traits/is_propagating_allocator.h>
+
+template<class T>
+struct propagating_allocator : std::allocator<T>
+{
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+    template<class U>
+    struct rebind
+    {
+        typedef propagating_allocator<U> other;
+    };
+    propagating_allocator()
+    {}
+    template<class U>
+    propagating_allocator(const propagating_allocator<U>&)
+    {}
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_size_feedback_allocator<tick::pool_allocator<int>>);
+    TICK_TRAIT_CHECK(tick::is_propagating_allocator<propagating_allocator<int>>);
+    static_assert(!tick::is_always_equal_allocator<propagating_allocator<int>>(), "Allocator is always equal");
+    static_assert(!tick::is_always_equal_allocator<tick::pool_allocator<int>>(), "Allocator is always equal");
+};
+
+TICK_TEST_CASE()
+{
+    std::allocator<int> a;
+    auto r = tick::allocate_at_least(a, 3);
+    TICK_TEST_CHECK(r.count == 3);
+    a.deallocate(r.ptr, r.count);
+
+    tick::pool p;
+    tick::pool_allocator<char> pa(p);
+    auto pr = tick::allocate_at_least(pa, 3);
+    TICK_TEST_CHECK(pr.count == 16);
+    pa.deallocate(pr.ptr, pr.count);
+}
+
+TICK_TEST_CASE()
+{
+    tick::pool p;
+    // The vector uses the whole size class as capacity
+    tick::small_vector<char, 1, tick::pool_allocator<char>> v{tick::pool_allocator<char>(p)};
+    v.push_back('a');
+    v.push_back('b');
+    TICK_TEST_CHECK(v.capacity() == 16);
+    for(int i=0;i<14;i++) v.push_back('c');
+    TICK_TEST_CHECK(v.capacity() == 16);
+}
+
+TICK_TEST_CASE()
+{
+    typedef tick::small_vector<int, 1, propagating_allocator<int>> vector;
+    vector x = { 1, 2, 3 };
+    vector y = { 4, 5 };
+    const int* data = x.data();
+    swap(x, y);
+    TICK_TEST_CHECK(y.data() == data);
+    x = std::move(y);
+    TICK_TEST_CHECK(x.data() == data);
+    TICK_TEST_CHECK(x.size() == 3);
+}
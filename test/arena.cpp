@@ -0,0 +1,60 @@
+#include "test.h"
+#include <tick/arena.h>
+#include <tick/traits/is_allocator.h>
+#include <tick/trait_check.h>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_allocator<tick::arena_allocator<int>>);
+    TICK_TRAIT_CHECK(tick::is_allocator<tick::arena_allocator<std::pair<const int, int>>>);
+};
+
+TICK_TEST_CASE()
+{
+    tick::arena a(256);
+    char* p = static_cast<char*>(a.allocate(10, 1));
+    char* q = static_cast<char*>(a.allocate(10, 1));
+    TICK_TEST_CHECK(q == p + 10);
+    void* aligned = a.allocate(8, 64);
+    TICK_TEST_CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    // Larger than a block
+    void* big = a.allocate(1024, 8);
+    TICK_TEST_CHECK(big != nullptr);
+
+    a.reset();
+    TICK_TEST_CHECK(a.allocate(10, 1) == p);
+    a.release();
+}
+
+TICK_TEST_CASE()
+{
+    tick::arena a;
+    tick::arena b;
+    typedef tick::arena_allocator<int> alloc;
+    TICK_TEST_CHECK(alloc(a) == alloc(a));
+    TICK_TEST_CHECK(alloc(a) != alloc(b));
+    TICK_TEST_CHECK(tick::arena_allocator<long>(alloc(a)) == alloc(a));
+
+    std::vector<int, alloc> v{alloc(a)};
+    for(int i=0;i<1000;i++) v.push_back(i);
+    TICK_TEST_CHECK(v[999] == 999);
+
+    std::vector<int, alloc> w{alloc(b)};
+    w = std::move(v);
+    TICK_TEST_CHECK(w.get_allocator() == alloc(b));
+    TICK_TEST_CHECK(w.size() == 1000);
+
+    typedef std::pair<const int, int> pair;
+    std::map<int, int, std::less<int>, tick::arena_allocator<pair>> m{tick::arena_allocator<pair>(a)};
+    std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, tick::arena_allocator<pair>> um{10, std::hash<int>(), std::equal_to<int>(), tick::arena_allocator<pair>(a)};
+    for(int i=0;i<100;i++)
+    {
+        m[i] = i;
+        um[i] = i;
+    }
+    TICK_TEST_CHECK(m.size() == 100);
+    TICK_TEST_CHECK(um.at(42) == 42);
+}
@@ -0,0 +1,39 @@
+#include "test.h"
+#include <tick/cache_padded.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(sizeof(tick::cache_padded<char>) == 64, "Not padded to a cache line");
+    static_assert(alignof(tick::cache_padded<char>) == 64, "Not aligned to a cache line");
+    static_assert(sizeof(tick::cache_padded<char[100]>) == 128, "Not padded to whole cache lines");
+};
+
+struct counters
+{
+    tick::cache_padded<std::atomic<int>> first;
+    tick::cache_padded<std::atomic<int>> second;
+};
+
+TICK_TEST_CASE()
+{
+    counters c;
+    std::uintptr_t first = reinterpret_cast<std::uintptr_t>(&c.first.get());
+    std::uintptr_t second = reinterpret_cast<std::uintptr_t>(&c.second.get());
+    TICK_TEST_CHECK(first % 64 == 0);
+    TICK_TEST_CHECK(second - first >= 64);
+}
+
+TICK_TEST_CASE()
+{
+    tick::cache_padded<std::string> s(3, 'x');
+    TICK_TEST_CHECK(*s == "xxx");
+    TICK_TEST_CHECK(s->size() == 3);
+    s.get() += "y";
+    const tick::cache_padded<std::string>& cs = s;
+    TICK_TEST_CHECK(cs.get() == "xxxy");
+    tick::cache_padded<int> zero;
+    TICK_TEST_CHECK(*zero == 0);
+}
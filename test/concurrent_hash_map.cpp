@@ -0,0 +1,106 @@
+#include "test.h"
+#include <tick/concurrent_hash_map.h>
+#include <tick/traits/is_range.h>
+#include <tick/traits/is_unordered_associative_container.h>
+#include <tick/trait_check.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef tick::concurrent_hash_map<int, int> int_map;
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_unordered_associative_container<int_map::snapshot_type>);
+    TICK_TRAIT_CHECK(tick::is_range<const int_map::snapshot_type>);
+};
+
+TICK_TEST_CASE()
+{
+    int_map m(4);
+    TICK_TEST_CHECK(m.shards() == 4);
+    TICK_TEST_CHECK(m.empty());
+    TICK_TEST_CHECK(m.insert_or_assign(1, 10));
+    TICK_TEST_CHECK(!m.insert_or_assign(1, 11));
+    TICK_TEST_CHECK(m.try_emplace(2, 20));
+    TICK_TEST_CHECK(!m.try_emplace(2, 21));
+    TICK_TEST_CHECK(m.size() == 2);
+
+    int x = 0;
+    TICK_TEST_CHECK(m.find(1, x));
+    TICK_TEST_CHECK(x == 11);
+    TICK_TEST_CHECK(m.find(2, x));
+    TICK_TEST_CHECK(x == 20);
+    TICK_TEST_CHECK(!m.find(3, x));
+    TICK_TEST_CHECK(m.contains(2));
+    TICK_TEST_CHECK(!m.contains(3));
+
+    TICK_TEST_CHECK(m.visit(2, [](std::pair<const int, int>& p) { p.second++; }));
+    TICK_TEST_CHECK(!m.visit(3, [](std::pair<const int, int>& p) { p.second++; }));
+    const int_map& cm = m;
+    int seen = 0;
+    TICK_TEST_CHECK(cm.visit(2, [&](const std::pair<const int, int>& p) { seen = p.second; }));
+    TICK_TEST_CHECK(seen == 21);
+
+    TICK_TEST_CHECK(m.erase(1) == 1);
+    TICK_TEST_CHECK(m.erase(1) == 0);
+    TICK_TEST_CHECK(m.size() == 1);
+    m.clear();
+    TICK_TEST_CHECK(m.empty());
+}
+
+TICK_TEST_CASE()
+{
+    tick::concurrent_hash_map<std::string, std::unique_ptr<int>> m(1);
+    std::string key = "a";
+    TICK_TEST_CHECK(m.try_emplace(std::move(key), new int(1)));
+    TICK_TEST_CHECK(m.insert_or_assign(std::string("b"), std::unique_ptr<int>(new int(2))));
+    int sum = 0;
+    m.for_each([&](std::pair<const std::string, std::unique_ptr<int>>& p) { sum += *p.second; });
+    TICK_TEST_CHECK(sum == 3);
+}
+
+TICK_TEST_CASE()
+{
+    int_map m(8);
+    for(int i=0;i<1000;i++) m.insert_or_assign(i, i * 2);
+    int_map::snapshot_type s = m.snapshot();
+    TICK_TEST_CHECK(s.size() == 1000);
+    for(int i=0;i<1000;i++) TICK_TEST_CHECK(s.at(i) == i * 2);
+
+    std::atomic<long> sum(0);
+    m.parallel_for_each([&](std::pair<const int, int>& p)
+    {
+        p.second++;
+        sum += p.second;
+    }, 3);
+    TICK_TEST_CHECK(sum == 999 * 1000 + 1000);
+    const int_map& cm = m;
+    long again = 0;
+    cm.for_each([&](const std::pair<const int, int>& p) { again += p.second; });
+    TICK_TEST_CHECK(again == sum);
+}
+
+TICK_TEST_CASE()
+{
+    int_map m(16);
+    std::vector<std::thread> threads;
+    for(int t=0;t<4;t++) threads.emplace_back([&m, t]
+    {
+        for(int i=0;i<2000;i++)
+        {
+            int k = t * 2000 + i;
+            m.insert_or_assign(k, k);
+            m.visit(k, [](std::pair<const int, int>& p) { p.second++; });
+            if (i % 2 == 0) m.erase(k);
+        }
+    });
+    for(std::thread& t:threads) t.join();
+    TICK_TEST_CHECK(m.size() == 4000);
+    int x = 0;
+    TICK_TEST_CHECK(m.find(1, x));
+    TICK_TEST_CHECK(x == 2);
+    TICK_TEST_CHECK(!m.contains(2));
+}
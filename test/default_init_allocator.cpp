@@ -0,0 +1,79 @@
+#include "test.h"
+#include <tick/default_init_allocator.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Fills new storage with a marker, so it shows which elements were zeroed
+template<class T>
+struct marking_allocator : std::allocator<T>
+{
+    template<class U>
+    struct rebind
+    {
+        typedef marking_allocator<U> other;
+    };
+
+    marking_allocator()
+    {}
+
+    template<class U>
+    marking_allocator(const marking_allocator<U>&)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        T* p = std::allocator<T>::allocate(n);
+        std::memset(static_cast<void*>(p), 0xab, n * sizeof(T));
+        return p;
+    }
+};
+
+template<class T>
+using default_init_vector = std::vector<T, tick::default_init_allocator<marking_allocator<T>>>;
+
+struct trivial
+{
+    int x;
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_allocator<tick::default_init_allocator<std::allocator<int>>>);
+    TICK_TRAIT_CHECK(tick::is_sequence_container<default_init_vector<int>>);
+    TICK_TRAIT_CHECK(tick::is_emplace_constructible<default_init_vector<int>, int>);
+    TICK_TRAIT_CHECK(tick::is_emplace_constructible<default_init_vector<std::string>, const char*>);
+    static_assert(std::is_same<
+        std::allocator_traits<tick::default_init_allocator<std::allocator<int>>>::rebind_alloc<char>,
+        tick::default_init_allocator<std::allocator<char>>
+    >(), "Rebind keeps the adaptor");
+};
+
+TICK_TEST_CASE()
+{
+    default_init_vector<unsigned char> v;
+    v.reserve(16);
+    v.resize(16);
+    for(unsigned char c:v) TICK_TEST_CHECK(c == 0xab);
+    v.resize(20, 1);
+    TICK_TEST_CHECK(v.back() == 1);
+    v.emplace_back();
+    TICK_TEST_CHECK(v.size() == 21);
+
+    default_init_vector<trivial> t(4);
+    for(auto&& x:t) TICK_TEST_CHECK(x.x == int(0xabababab));
+}
+
+TICK_TEST_CASE()
+{
+    default_init_vector<std::string> v(3);
+    for(auto&& s:v) TICK_TEST_CHECK(s.empty());
+    v.emplace_back("abc");
+    TICK_TEST_CHECK(v.back() == "abc");
+
+    default_init_vector<std::string> w = v;
+    TICK_TEST_CHECK(w == v);
+    TICK_TEST_CHECK(w.get_allocator() == v.get_allocator());
+}
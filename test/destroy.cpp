@@ -0,0 +1,94 @@
+#include "test.h"
+#include <tick/destroy.h>
+#include <tick/small_vector.h>
+#include <tick/trait_check.h>
+#include <list>
+#include <memory>
+#include <new>
+#include <string>
+
+static int destroyed = 0;
+
+struct counted
+{
+    ~counted()
+    {
+        destroyed++;
+    }
+};
+
+// Counts every destroy, even for trivial types
+template<class T>
+struct destroy_counting_allocator : std::allocator<T>
+{
+    template<class U>
+    struct rebind
+    {
+        typedef destroy_counting_allocator<U> other;
+    };
+
+    destroy_counting_allocator()
+    {}
+
+    template<class U>
+    destroy_counting_allocator(const destroy_counting_allocator<U>&)
+    {}
+
+    template<class U>
+    void destroy(U* p)
+    {
+        destroyed++;
+        p->~U();
+    }
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_trivially_destructible<int>);
+    static_assert(!tick::is_trivially_destructible<counted>(), "Destructor is trivial");
+    static_assert(tick::detail::is_trivially_destroying_allocator<std::allocator<int>, int>(), "Allocator destroys");
+    static_assert(!tick::detail::is_trivially_destroying_allocator<std::allocator<std::string>, std::string>(), "Allocator does not destroy");
+    static_assert(!tick::detail::is_trivially_destroying_allocator<destroy_counting_allocator<int>, int>(), "Allocator does not destroy");
+};
+
+TICK_TEST_CASE()
+{
+    alignas(counted) unsigned char buffer[4 * sizeof(counted)];
+    counted* p = reinterpret_cast<counted*>(buffer);
+    for(int i=0;i<4;i++) ::new(static_cast<void*>(p + i)) counted();
+    destroyed = 0;
+    tick::destroy(p, p + 2);
+    TICK_TEST_CHECK(destroyed == 2);
+    TICK_TEST_CHECK(tick::destroy_n(p + 2, 2) == p + 4);
+    TICK_TEST_CHECK(destroyed == 4);
+
+    std::string* s = std::allocator<std::string>().allocate(2);
+    ::new(static_cast<void*>(s)) std::string(100, 'x');
+    ::new(static_cast<void*>(s + 1)) std::string(100, 'y');
+    tick::destroy(s, s + 2);
+    std::allocator<std::string>().deallocate(s, 2);
+
+    int a[3] = { 1, 2, 3 };
+    TICK_TEST_CHECK(tick::destroy_n(a, 3) == a + 3);
+    std::list<int> l = { 1, 2 };
+    TICK_TEST_CHECK(tick::destroy_n(l.begin(), 2) == l.end());
+}
+
+TICK_TEST_CASE()
+{
+    destroy_counting_allocator<int> a;
+    int x[3] = { 1, 2, 3 };
+    destroyed = 0;
+    tick::destroy(a, x, x + 3);
+    TICK_TEST_CHECK(destroyed == 3);
+
+    tick::small_vector<int, 2, destroy_counting_allocator<int>> v = { 1, 2, 3, 4 };
+    destroyed = 0;
+    v.clear();
+    TICK_TEST_CHECK(destroyed == 4);
+
+    tick::small_vector<counted, 2> c(3);
+    destroyed = 0;
+    c.clear();
+    TICK_TEST_CHECK(destroyed == 3);
+}
@@ -0,0 +1,227 @@
+#include "test.h"
+#include <tick/epoch_domain.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static std::atomic<int> destroyed(0);
+
+struct counted
+{
+    int value;
+    counted(int x=0) : value(x)
+    {}
+    ~counted()
+    {
+        destroyed++;
+    }
+};
+
+// Counts the deallocations made through any copy of the allocator
+template<class T>
+struct counting_allocator
+{
+    typedef T value_type;
+    int* deallocations;
+
+    counting_allocator(int* d) : deallocations(d)
+    {}
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>& a) : deallocations(a.deallocations)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        (*deallocations)++;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<class U>
+    bool operator==(const counting_allocator<U>& a) const
+    {
+        return deallocations == a.deallocations;
+    }
+
+    template<class U>
+    bool operator!=(const counting_allocator<U>& a) const
+    {
+        return deallocations != a.deallocations;
+    }
+};
+
+TICK_TEST_CASE()
+{
+    destroyed = 0;
+    tick::epoch_domain domain;
+    tick::epoch_domain::participant self(domain);
+    for(int i=0;i<10;i++) self.retire(new counted(i));
+    TICK_TEST_CHECK(self.pending() == 10);
+    TICK_TEST_CHECK(destroyed == 0);
+    // Nothing else is pinned, so each call moves to the next epoch
+    self.reclaim();
+    self.reclaim();
+    TICK_TEST_CHECK(self.pending() == 0);
+    TICK_TEST_CHECK(destroyed == 10);
+}
+
+TICK_TEST_CASE()
+{
+    destroyed = 0;
+    tick::epoch_domain domain;
+    tick::epoch_domain::participant reader(domain);
+    tick::epoch_domain::participant writer(domain);
+    {
+        auto g = reader.pin();
+        TICK_TEST_CHECK(reader.is_pinned());
+        {
+            auto nested = reader.pin();
+        }
+        TICK_TEST_CHECK(reader.is_pinned());
+        writer.retire(new counted());
+        for(int i=0;i<5;i++) writer.reclaim();
+        // The reader may still see the object
+        TICK_TEST_CHECK(destroyed == 0);
+    }
+    TICK_TEST_CHECK(!reader.is_pinned());
+    writer.reclaim();
+    writer.reclaim();
+    TICK_TEST_CHECK(destroyed == 1);
+}
+
+TICK_TEST_CASE()
+{
+    destroyed = 0;
+    int deallocations = 0;
+    counting_allocator<counted> a(&deallocations);
+    tick::epoch_domain domain;
+    {
+        tick::epoch_domain::participant other(domain);
+        auto g = other.pin();
+        {
+            tick::epoch_domain::participant self(domain);
+            counted* p = std::allocator_traits<counting_allocator<counted>>::allocate(a, 1);
+            std::allocator_traits<counting_allocator<counted>>::construct(a, p, 1);
+            // Retired with an allocator for a different type
+            self.retire(counting_allocator<char>(a), p);
+            self.retire(new counted(), [](counted* q) { delete q; });
+            self.reclaim();
+            TICK_TEST_CHECK(self.pending() == 2);
+        }
+        // The participant handed its nodes to the domain
+        TICK_TEST_CHECK(destroyed == 0);
+    }
+    {
+        tick::epoch_domain::participant next(domain);
+        next.reclaim();
+        next.reclaim();
+        next.reclaim();
+    }
+    TICK_TEST_CHECK(destroyed == 2);
+    TICK_TEST_CHECK(deallocations == 1);
+}
+
+TICK_TEST_CASE()
+{
+    // The domain frees what is left when destroyed
+    destroyed = 0;
+    {
+        tick::epoch_domain domain;
+        tick::epoch_domain::participant self(domain);
+        auto g = self.pin();
+        self.retire(new counted());
+    }
+    TICK_TEST_CHECK(destroyed == 1);
+}
+
+// A lock free stack, where nodes are popped while other threads read them
+struct stack
+{
+    struct node
+    {
+        int value;
+        node* next;
+    };
+    std::atomic<node*> head;
+
+    stack() : head(nullptr)
+    {}
+
+    ~stack()
+    {
+        for(node* p = head.load();p != nullptr;)
+        {
+            node* next = p->next;
+            delete p;
+            p = next;
+        }
+    }
+
+    void push(int x)
+    {
+        node* n = new node{ x, head.load() };
+        while(!head.compare_exchange_weak(n->next, n))
+        {}
+    }
+
+    bool pop(tick::epoch_domain::participant& self, int& x)
+    {
+        auto g = self.pin();
+        node* n = head.load();
+        while(n != nullptr and !head.compare_exchange_weak(n, n->next))
+        {}
+        if (n == nullptr) return false;
+        x = n->value;
+        self.retire(n);
+        return true;
+    }
+
+    int sum_top(tick::epoch_domain::participant& self, int k)
+    {
+        auto g = self.pin();
+        int sum = 0;
+        for(node* n = head.load();n != nullptr and k > 0;n = n->next, k--) sum += n->value;
+        return sum;
+    }
+};
+
+TICK_TEST_CASE()
+{
+    tick::epoch_domain domain;
+    stack s;
+    const int count = 20000;
+    std::atomic<long> popped(0);
+    std::atomic<int> pops(0);
+    std::vector<std::thread> threads;
+    for(int t=0;t<2;t++) threads.emplace_back([&]
+    {
+        tick::epoch_domain::participant self(domain);
+        for(int i=1;i<=count;i++)
+        {
+            s.push(i);
+            int x;
+            if (s.pop(self, x))
+            {
+                popped += x;
+                pops++;
+            }
+        }
+    });
+    for(int t=0;t<2;t++) threads.emplace_back([&]
+    {
+        tick::epoch_domain::participant self(domain);
+        long sum = 0;
+        while(pops.load() < count) sum += s.sum_top(self, 8);
+        (void)sum;
+    });
+    for(std::thread& t:threads) t.join();
+    tick::epoch_domain::participant self(domain);
+    int x;
+    while(s.pop(self, x)) popped += x;
+    TICK_TEST_CHECK(popped == 2L * count * (count + 1) / 2);
+}
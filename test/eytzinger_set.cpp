@@ -0,0 +1,91 @@
+#include "test.h"
+#include <tick/eytzinger_set.h>
+#include <tick/flat_set.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+struct unordered_key
+{};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_random_access_iterator<tick::eytzinger_set<int>::iterator>);
+    static_assert(!tick::is_mutable_random_access_iterator<tick::eytzinger_set<int>::iterator>(), "Set iterator is mutable");
+    static_assert(tick::detail::is_eytzinger_compare<int, std::greater<int>>(), "Not ordered");
+    static_assert(!tick::detail::is_eytzinger_compare<unordered_key, std::less<unordered_key>>(), "Ordered without operator<");
+};
+
+TICK_TEST_CASE()
+{
+    tick::eytzinger_set<int> s = { 5, 3, 1, 3, 4 };
+    TICK_TEST_CHECK(s.size() == 4);
+    // The root of the tree is the median
+    TICK_TEST_CHECK(*s.begin() == 4);
+    TICK_TEST_CHECK(s.contains(3));
+    TICK_TEST_CHECK(!s.contains(2));
+    TICK_TEST_CHECK(s.count(5) == 1);
+    TICK_TEST_CHECK(*s.lower_bound(2) == 3);
+    TICK_TEST_CHECK(*s.upper_bound(3) == 4);
+    TICK_TEST_CHECK(*s.lower_bound(0) == 1);
+    TICK_TEST_CHECK(s.lower_bound(6) == s.end());
+    TICK_TEST_CHECK(s.upper_bound(5) == s.end());
+
+    tick::eytzinger_set<int> empty;
+    TICK_TEST_CHECK(empty.empty());
+    TICK_TEST_CHECK(empty.lower_bound(1) == empty.end());
+    TICK_TEST_CHECK(!empty.contains(1));
+}
+
+TICK_TEST_CASE()
+{
+    // Every size up to a few complete levels, to cover full and partial
+    // last levels
+    for(int n=0;n<300;n++)
+    {
+        tick::flat_set<int> keys;
+        for(int i=0;i<n;i++) keys.insert(i * 2);
+        tick::eytzinger_set<int> s(tick::sorted_unique, keys);
+        TICK_TEST_CHECK(s.size() == keys.size());
+        TICK_TEST_CHECK(std::is_permutation(s.begin(), s.end(), keys.begin()));
+        for(int i=-1;i<2*n+1;i++)
+        {
+            auto it = s.lower_bound(i);
+            auto rit = keys.lower_bound(i);
+            TICK_TEST_CHECK((it == s.end()) == (rit == keys.end()));
+            if (it != s.end()) TICK_TEST_CHECK(*it == *rit);
+            auto uit = s.upper_bound(i);
+            auto urit = keys.upper_bound(i);
+            TICK_TEST_CHECK((uit == s.end()) == (urit == keys.end()));
+            if (uit != s.end()) TICK_TEST_CHECK(*uit == *urit);
+            TICK_TEST_CHECK(s.count(i) == keys.count(i));
+        }
+    }
+}
+
+TICK_TEST_CASE()
+{
+    std::vector<std::string> words = { "pear", "apple", "fig", "kiwi", "apple", "lime" };
+    tick::eytzinger_set<std::string, std::greater<std::string>> s(words.begin(), words.end());
+    std::set<std::string, std::greater<std::string>> ref(words.begin(), words.end());
+    TICK_TEST_CHECK(s.size() == ref.size());
+    for(const char* w:{ "a", "apple", "b", "fig", "kiwi", "lime", "pear", "z" })
+    {
+        TICK_TEST_CHECK(s.contains(w) == (ref.count(w) == 1));
+        auto it = s.lower_bound(w);
+        auto rit = ref.lower_bound(w);
+        TICK_TEST_CHECK((it == s.end()) == (rit == ref.end()));
+        if (it != s.end()) TICK_TEST_CHECK(*it == *rit);
+    }
+    // The source range is left unchanged
+    TICK_TEST_CHECK(words.front() == "pear");
+
+    tick::eytzinger_set<std::string, std::greater<std::string>> t;
+    swap(s, t);
+    TICK_TEST_CHECK(s.empty());
+    TICK_TEST_CHECK(t.size() == 5);
+    TICK_TEST_CHECK(t == tick::eytzinger_set<std::string, std::greater<std::string>>(words.begin(), words.end()));
+}
@@ -0,0 +1,262 @@
+#include "test.h"
+#include <tick/flat_hash_map.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_unordered_associative_container<tick::flat_hash_map<int, int>>);
+    TICK_TRAIT_CHECK(tick::is_unordered_associative_container<tick::flat_hash_map<std::string, std::string>>);
+    TICK_TRAIT_CHECK(tick::is_forward_iterator<tick::flat_hash_map<int, int>::iterator>);
+    TICK_TRAIT_CHECK(tick::is_forward_iterator<tick::flat_hash_map<int, int>::const_iterator>);
+    static_assert(!tick::is_associative_container<tick::flat_hash_map<int, int>>(), "Is an associative container");
+    // Growing a table of ints relocates without recording where each element went
+    static_assert(noexcept(tick::detail::hash_mix(std::declval<const std::hash<int>&>()(std::declval<const int&>()))), "Hashing an int can throw");
+};
+
+TICK_TEST_CASE()
+{
+    tick::flat_hash_map<int, int> m;
+    TICK_TEST_CHECK(m.empty());
+    TICK_TEST_CHECK(m.begin() == m.end());
+    TICK_TEST_CHECK(m.find(1) == m.end());
+    TICK_TEST_CHECK(m.bucket_count() == 0);
+
+    for(int i=0;i<1000;i++) TICK_TEST_CHECK(m.insert(std::make_pair(i, i * 2)).second);
+    TICK_TEST_CHECK(m.size() == 1000);
+    TICK_TEST_CHECK(!m.insert(std::make_pair(5, 0)).second);
+    TICK_TEST_CHECK(m.load_factor() <= m.max_load_factor());
+    for(int i=0;i<1000;i++) TICK_TEST_CHECK(m.at(i) == i * 2);
+    for(int i=1000;i<2000;i++) TICK_TEST_CHECK(m.count(i) == 0);
+    TICK_TEST_CHECK(std::distance(m.begin(), m.end()) == 1000);
+
+    for(int i=0;i<1000;i+=2) TICK_TEST_CHECK(m.erase(i) == 1);
+    TICK_TEST_CHECK(m.erase(0) == 0);
+    TICK_TEST_CHECK(m.size() == 500);
+    for(int i=0;i<1000;i++) TICK_TEST_CHECK(m.contains(i) == (i % 2 == 1));
+
+    // Reuses the room left by the erased elements
+    for(int round=0;round<10;round++)
+    {
+        for(int i=0;i<1000;i+=2) m[i] = round;
+        for(int i=0;i<1000;i+=2) m.erase(i);
+    }
+    TICK_TEST_CHECK(m.size() == 500);
+    TICK_TEST_CHECK(m.bucket_count() < 4096);
+
+    std::size_t n = 0;
+    for(auto it = m.begin();it != m.end();)
+    {
+        if (it->first % 4 == 1) it = m.erase(it);
+        else ++it, ++n;
+    }
+    TICK_TEST_CHECK(m.size() == n);
+    TICK_TEST_CHECK(m.size() == 250);
+
+    m.clear();
+    TICK_TEST_CHECK(m.empty());
+    TICK_TEST_CHECK(m.begin() == m.end());
+    m.rehash(0);
+    TICK_TEST_CHECK(m.bucket_count() == 0);
+}
+
+TICK_TEST_CASE()
+{
+    tick::flat_hash_map<std::string, int> m = { { "one", 1 }, { "two", 2 } };
+    m["three"] = 3;
+    TICK_TEST_CHECK(m.size() == 3);
+    TICK_TEST_CHECK(m.at("two") == 2);
+    TICK_TEST_CHECK(m.try_emplace("one", 5).second == false);
+    TICK_TEST_CHECK(m.insert_or_assign("one", 5).second == false);
+    TICK_TEST_CHECK(m["one"] == 5);
+    TICK_TEST_CHECK(m.emplace("four", 4).second);
+
+    bool thrown = false;
+    try { m.at("five"); }
+    catch(const std::out_of_range&) { thrown = true; }
+    TICK_TEST_CHECK(thrown);
+
+    tick::flat_hash_map<std::string, int> copy = m;
+    TICK_TEST_CHECK(copy == m);
+    copy["five"] = 5;
+    TICK_TEST_CHECK(copy != m);
+
+    tick::flat_hash_map<std::string, int> moved = std::move(copy);
+    TICK_TEST_CHECK(copy.empty());
+    TICK_TEST_CHECK(moved.size() == 5);
+    swap(moved, m);
+    TICK_TEST_CHECK(m.size() == 5);
+    TICK_TEST_CHECK(moved.size() == 4);
+    moved = m;
+    TICK_TEST_CHECK(moved == m);
+
+    std::map<std::string, int> sorted(m.begin(), m.end());
+    TICK_TEST_CHECK(sorted.size() == 5);
+    TICK_TEST_CHECK(sorted.begin()->first == "five");
+}
+
+struct bad_hash
+{
+    std::size_t operator()(int) const
+    {
+        return 0;
+    }
+};
+
+TICK_TEST_CASE()
+{
+    // Every key collides, so the probes go through every group
+    tick::flat_hash_map<int, std::unique_ptr<int>, bad_hash> m;
+    for(int i=0;i<100;i++) m.try_emplace(i, new int(i));
+    for(int i=0;i<100;i++) TICK_TEST_CHECK(*m.at(i) == i);
+    for(int i=0;i<100;i+=3) m.erase(i);
+    for(int i=0;i<100;i++) TICK_TEST_CHECK(m.count(i) == (i % 3 == 0 ? 0u : 1u));
+    m.reserve(1000);
+    for(int i=0;i<100;i++) TICK_TEST_CHECK(m.count(i) == (i % 3 == 0 ? 0u : 1u));
+}
+
+TICK_TEST_CASE()
+{
+    // The argument refers to an element, and the insert makes the table
+    // grow, which moves the elements
+    tick::flat_hash_map<int, std::vector<int>> m;
+    for(int i=0;i<14;i++) m.try_emplace(i, 40, i);
+    TICK_TEST_CHECK(m.bucket_count() == 15);
+    TICK_TEST_CHECK(m.try_emplace(1000, m.at(0)).second);
+    TICK_TEST_CHECK(m.bucket_count() > 15);
+    TICK_TEST_CHECK(m.at(1000).size() == 40);
+    TICK_TEST_CHECK(m.at(0).size() == 40);
+
+    for(int i=1001;m.bucket_count() == 31 and m.size() < 27;i++) m.try_emplace(i, 40, i);
+    TICK_TEST_CHECK(m.size() == 27);
+    TICK_TEST_CHECK(m.insert_or_assign(2000, m.at(1)).second);
+    TICK_TEST_CHECK(m.at(2000).size() == 40 and m.at(2000)[0] == 1);
+
+    for(int i=3000;m.size() < 55;i++) m.try_emplace(i, 40, i);
+    TICK_TEST_CHECK(m.bucket_count() == 63);
+    TICK_TEST_CHECK(m.try_emplace(4000, m.at(2).begin(), m.at(2).end()).second);
+    TICK_TEST_CHECK(m.at(4000).size() == 40 and m.at(4000)[0] == 2);
+}
+
+// A key that throws once it has been copied a given number of times
+struct fragile_key
+{
+    static int copies_left;
+    int value;
+
+    fragile_key(int x) : value(x)
+    {}
+
+    fragile_key(const fragile_key& rhs) : value(rhs.value)
+    {
+        if (copies_left == 0) throw std::runtime_error("fragile_key");
+        if (copies_left > 0) copies_left--;
+    }
+
+    friend bool operator==(const fragile_key& x, const fragile_key& y)
+    {
+        return x.value == y.value;
+    }
+};
+
+int fragile_key::copies_left = -1;
+
+struct fragile_key_hash
+{
+    std::size_t operator()(const fragile_key& k) const
+    {
+        return std::hash<int>()(k.value);
+    }
+};
+
+TICK_TEST_CASE()
+{
+    // The keys are const, so they are copied when the table grows, and a
+    // throw leaves the elements where they were
+    tick::flat_hash_map<fragile_key, std::vector<int>, fragile_key_hash> m;
+    for(int i=0;i<14;i++) m.try_emplace(i, 40, i);
+    TICK_TEST_CHECK(m.bucket_count() == 15);
+    fragile_key::copies_left = 5;
+    bool thrown = false;
+    try { m.try_emplace(100, 40, 100); }
+    catch(const std::runtime_error&) { thrown = true; }
+    fragile_key::copies_left = -1;
+    TICK_TEST_CHECK(thrown);
+    TICK_TEST_CHECK(m.size() == 14);
+    TICK_TEST_CHECK(m.bucket_count() == 15);
+    for(int i=0;i<14;i++) TICK_TEST_CHECK(m.at(i).size() == 40 and m.at(i)[0] == i);
+    TICK_TEST_CHECK(m.count(100) == 0);
+
+    fragile_key::copies_left = 3;
+    thrown = false;
+    try { m.reserve(1000); }
+    catch(const std::runtime_error&) { thrown = true; }
+    fragile_key::copies_left = -1;
+    TICK_TEST_CHECK(thrown);
+    TICK_TEST_CHECK(m.bucket_count() == 15);
+    for(int i=0;i<14;i++) TICK_TEST_CHECK(m.at(i).size() == 40 and m.at(i)[0] == i);
+
+    m.reserve(1000);
+    TICK_TEST_CHECK(m.bucket_count() > 15);
+    TICK_TEST_CHECK(m.size() == 14);
+    for(int i=0;i<14;i++) TICK_TEST_CHECK(m.at(i).size() == 40 and m.at(i)[0] == i);
+}
+
+template<class T>
+struct stateful_allocator : std::allocator<T>
+{
+    typedef std::false_type is_always_equal;
+    template<class U>
+    struct rebind
+    {
+        typedef stateful_allocator<U> other;
+    };
+    int id;
+    stateful_allocator(int i=0) : id(i)
+    {}
+    template<class U>
+    stateful_allocator(const stateful_allocator<U>& a) : id(a.id)
+    {}
+    friend bool operator==(const stateful_allocator& x, const stateful_allocator& y)
+    {
+        return x.id == y.id;
+    }
+    friend bool operator!=(const stateful_allocator& x, const stateful_allocator& y)
+    {
+        return x.id != y.id;
+    }
+};
+
+TICK_TEST_CASE()
+{
+    // A copy that throws part way through frees what was built
+    typedef std::pair<const fragile_key, std::vector<int>> value_type;
+    typedef tick::flat_hash_map<fragile_key, std::vector<int>, fragile_key_hash, std::equal_to<fragile_key>, stateful_allocator<value_type>> map_type;
+    map_type m;
+    for(int i=0;i<20;i++) m.try_emplace(i, 40, i);
+    for(int copies=0;copies<3;copies++)
+    {
+        fragile_key::copies_left = 10;
+        bool thrown = false;
+        try
+        {
+            if (copies == 0) map_type copy(m);
+            else if (copies == 1) map_type copy(m, stateful_allocator<value_type>(1));
+            else map_type moved(std::move(m), stateful_allocator<value_type>(1));
+        }
+        catch(const std::runtime_error&) { thrown = true; }
+        fragile_key::copies_left = -1;
+        TICK_TEST_CHECK(thrown);
+    }
+    // The elements that were moved before the throw are left moved from
+    TICK_TEST_CHECK(m.size() == 20);
+    map_type copy(m, stateful_allocator<value_type>(1));
+    TICK_TEST_CHECK(copy == m);
+    map_type moved(std::move(copy), stateful_allocator<value_type>(2));
+    TICK_TEST_CHECK(moved == m);
+}
@@ -0,0 +1,59 @@
+#include "test.h"
+#include <tick/flat_map.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <map>
+#include <string>
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_container<tick::flat_map<int, int>>);
+    TICK_TRAIT_CHECK(tick::is_reversible_container<tick::flat_map<int, int>>);
+    TICK_TRAIT_CHECK(tick::is_associative_container<tick::flat_map<int, int>>);
+    TICK_TRAIT_CHECK(tick::is_associative_container<tick::flat_map<std::string, std::string>>);
+    static_assert(!tick::is_sequence_container<tick::flat_map<int, int>>(), "Not a sequence container");
+};
+
+TICK_TEST_CASE()
+{
+    tick::flat_map<std::string, int> m = { { "two", 2 }, { "one", 1 }, { "two", 3 } };
+    TICK_TEST_CHECK(m.size() == 2);
+    // The first element with a key wins, like std::map
+    TICK_TEST_CHECK(m.at("two") == 2);
+    TICK_TEST_CHECK(m.begin()->first == "one");
+
+    m["three"] = 3;
+    TICK_TEST_CHECK(m.size() == 3);
+    TICK_TEST_CHECK(m["three"] == 3);
+    TICK_TEST_CHECK(!m.try_emplace("one", 10).second);
+    TICK_TEST_CHECK(m.at("one") == 1);
+    TICK_TEST_CHECK(!m.insert_or_assign("one", 10).second);
+    TICK_TEST_CHECK(m.at("one") == 10);
+    TICK_TEST_CHECK(m.emplace("four", 4).second);
+    TICK_TEST_CHECK(m.erase("two") == 1);
+    TICK_TEST_CHECK(m.find("two") == m.end());
+    TICK_TEST_CHECK(m.count("four") == 1);
+}
+
+TICK_TEST_CASE()
+{
+    std::map<int, int> ref;
+    for(int i=0;i<500;i++) ref[i * 3] = i;
+    tick::flat_map<int, int> m(tick::sorted_unique, ref.begin(), ref.end());
+    TICK_TEST_CHECK(m.size() == ref.size());
+    TICK_TEST_CHECK(std::equal(m.begin(), m.end(), ref.begin(), [](const std::pair<int, int>& x, const std::pair<const int, int>& y)
+    {
+        return x.first == y.first and x.second == y.second;
+    }));
+    for(int i=0;i<1500;i++)
+    {
+        TICK_TEST_CHECK(m.count(i) == ref.count(i));
+        auto it = m.upper_bound(i);
+        auto rit = ref.upper_bound(i);
+        TICK_TEST_CHECK((it == m.end()) == (rit == ref.end()));
+        if (it != m.end()) TICK_TEST_CHECK(it->first == rit->first);
+    }
+    auto r = m.equal_range(3);
+    TICK_TEST_CHECK(r.second - r.first == 1);
+    TICK_TEST_CHECK(r.first->second == 1);
+}
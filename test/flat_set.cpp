@@ -0,0 +1,76 @@
+#include "test.h"
+#include <tick/flat_set.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <set>
+#include <string>
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_container<tick::flat_set<int>>);
+    TICK_TRAIT_CHECK(tick::is_reversible_container<tick::flat_set<int>>);
+    TICK_TRAIT_CHECK(tick::is_associative_container<tick::flat_set<int>>);
+    TICK_TRAIT_CHECK(tick::is_associative_container<tick::flat_set<std::string>>);
+    TICK_TRAIT_CHECK(tick::is_random_access_iterator<tick::flat_set<int>::iterator>);
+    static_assert(!tick::is_mutable_random_access_iterator<tick::flat_set<int>::iterator>(), "Set iterator is mutable");
+};
+
+TICK_TEST_CASE()
+{
+    tick::flat_set<int> s = { 5, 3, 1, 3, 4 };
+    TICK_TEST_CHECK(s.size() == 4);
+    TICK_TEST_CHECK(std::is_sorted(s.begin(), s.end()));
+    TICK_TEST_CHECK(s.contains(3));
+    TICK_TEST_CHECK(!s.contains(2));
+    TICK_TEST_CHECK(*s.lower_bound(2) == 3);
+    TICK_TEST_CHECK(*s.upper_bound(3) == 4);
+    TICK_TEST_CHECK(s.lower_bound(6) == s.end());
+    TICK_TEST_CHECK(s.upper_bound(0) == s.begin());
+
+    TICK_TEST_CHECK(s.insert(2).second);
+    TICK_TEST_CHECK(!s.insert(2).second);
+    TICK_TEST_CHECK(*s.insert(s.end(), 6) == 6);
+    TICK_TEST_CHECK(*s.insert(s.begin(), 0) == 0);
+    // A wrong hint still inserts in order
+    s.insert(s.begin(), 10);
+    TICK_TEST_CHECK(*s.rbegin() == 10);
+    TICK_TEST_CHECK(s.erase(10) == 1);
+    TICK_TEST_CHECK(s.erase(10) == 0);
+    TICK_TEST_CHECK((s == tick::flat_set<int>{ 0, 1, 2, 3, 4, 5, 6 }));
+}
+
+TICK_TEST_CASE()
+{
+    // Large enough to use both the halving steps and the counted tail
+    std::vector<int> keys;
+    for(int i=0;i<1000;i++) keys.push_back(i * 2);
+    tick::flat_set<int> s(tick::sorted_unique, keys.begin(), keys.end());
+    std::set<int> ref(keys.begin(), keys.end());
+    for(int i=-1;i<2001;i++)
+    {
+        auto it = s.lower_bound(i);
+        auto rit = ref.lower_bound(i);
+        TICK_TEST_CHECK((it == s.end()) == (rit == ref.end()));
+        if (it != s.end()) TICK_TEST_CHECK(*it == *rit);
+        TICK_TEST_CHECK((s.upper_bound(i) == s.end()) == (ref.upper_bound(i) == ref.end()));
+        TICK_TEST_CHECK(s.count(i) == ref.count(i));
+    }
+
+    std::vector<int> more = { 3, 1, 1000, 2001 };
+    s.insert(more.begin(), more.end());
+    TICK_TEST_CHECK(s.size() == 1003);
+    TICK_TEST_CHECK(std::is_sorted(s.begin(), s.end()));
+    TICK_TEST_CHECK(s.contains(2001));
+}
+
+TICK_TEST_CASE()
+{
+    tick::flat_set<std::string, std::greater<std::string>> s = { "a", "c", "b" };
+    TICK_TEST_CHECK(*s.begin() == "c");
+    TICK_TEST_CHECK(s.find("b") != s.end());
+    TICK_TEST_CHECK(s.find("d") == s.end());
+    tick::flat_set<std::string, std::greater<std::string>> t;
+    swap(s, t);
+    TICK_TEST_CHECK(s.empty());
+    TICK_TEST_CHECK(t.size() == 3);
+}
@@ -0,0 +1,72 @@
+#include "test.h"
+#include <tick/hash.h>
+#include <tick/trait_check.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+TICK_TEST_CASE()
+{
+    std::vector<std::uint32_t> v = { 1, 2, 3 };
+    TICK_TEST_CHECK(tick::hash_range(v.data(), v.data() + 3) == tick::hash_bytes(v.data(), 12));
+    TICK_TEST_CHECK(tick::hash_range(v.data(), v.data() + 3, 1) == tick::hash_bytes(v.data(), 12, 1));
+    TICK_TEST_CHECK(tick::hash_range(v.data(), v.data() + 3) != tick::hash_range(v.data(), v.data() + 2));
+    TICK_TEST_CHECK(tick::hash_range(v.data(), v.data() + 3, 1) != tick::hash_range(v.data(), v.data() + 3, 2));
+
+    std::array<std::uint64_t, 2> keys[] = { {{1, 2}}, {{1, 2}} };
+    TICK_TEST_CHECK(tick::hash_bytes(keys, 16) == tick::hash_bytes(keys + 1, 16));
+
+    std::list<std::string> l = { "a", "b" };
+    std::list<std::string> m = { "a", "b" };
+    TICK_TEST_CHECK(tick::hash_range(l.begin(), l.end()) == tick::hash_range(m.begin(), m.end()));
+    m.back() = "c";
+    TICK_TEST_CHECK(tick::hash_range(l.begin(), l.end()) != tick::hash_range(m.begin(), m.end()));
+}
+
+TICK_TEST_CASE()
+{
+    // Every length reads a different set of bytes
+    unsigned char bytes[64];
+    for(int i=0;i<64;i++) bytes[i] = static_cast<unsigned char>(i * 7 + 1);
+    std::set<std::size_t> hashes;
+    for(std::size_t n=0;n<=64;n++) hashes.insert(tick::hash_bytes(bytes, n));
+    TICK_TEST_CHECK(hashes.size() == 65);
+
+    // Flipping any single bit changes the hash
+    std::size_t h = tick::hash_bytes(bytes, 40);
+    for(int i=0;i<40*8;i++)
+    {
+        bytes[i / 8] ^= static_cast<unsigned char>(1 << (i % 8));
+        TICK_TEST_CHECK(tick::hash_bytes(bytes, 40) != h);
+        bytes[i / 8] ^= static_cast<unsigned char>(1 << (i % 8));
+    }
+}
+
+TICK_TEST_CASE()
+{
+    // The hash is the same whatever the iterator type
+    std::vector<std::uint32_t> v;
+    for(std::uint32_t i=0;i<37;i++) v.push_back(i * 2654435761u);
+    std::list<std::uint32_t> l(v.begin(), v.end());
+    std::deque<std::uint32_t> d(v.begin(), v.end());
+    for(std::size_t n=0;n<=v.size();n++)
+    {
+        std::size_t h = tick::hash_range(v.data(), v.data() + n, 3);
+        TICK_TEST_CHECK(h == tick::hash_bytes(v.data(), n * sizeof(std::uint32_t), 3));
+        TICK_TEST_CHECK(h == tick::hash_range(v.begin(), v.begin() + n, 3));
+        TICK_TEST_CHECK(h == tick::hash_range(v.cbegin(), v.cbegin() + n, 3));
+        TICK_TEST_CHECK(h == tick::hash_range(d.begin(), d.begin() + n, 3));
+        TICK_TEST_CHECK(h == tick::hash_range(l.begin(), std::next(l.begin(), n), 3));
+    }
+
+    // Bitwise comparable elements need no std::hash
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs = { {1, 2}, {3, 4}, {5, 6} };
+    std::list<std::pair<std::uint32_t, std::uint32_t>> pair_list(pairs.begin(), pairs.end());
+    TICK_TEST_CHECK(tick::hash_range(pairs.data(), pairs.data() + 3) == tick::hash_range(pair_list.begin(), pair_list.end()));
+    TICK_TEST_CHECK(tick::hash_range(pairs.data(), pairs.data() + 3) != tick::hash_range(pairs.data(), pairs.data() + 2));
+}
@@ -0,0 +1,129 @@
+#include "test.h"
+#include <tick/mapped_array.h>
+#include <tick/sort.h>
+#include <tick/trait_check.h>
+#include <tick/traits.h>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+
+struct packet
+{
+    std::uint64_t time;
+    std::uint32_t length;
+    std::uint32_t flags;
+};
+
+// Removes the file when the test is done with it
+struct temp_file
+{
+    std::string path;
+
+    temp_file() : path("tick_mapped_array_" + std::to_string(::getpid()) + ".bin")
+    {}
+
+    ~temp_file()
+    {
+        std::remove(path.c_str());
+    }
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_random_access_iterator<tick::mapped_array<const packet>::iterator>);
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<tick::mapped_array<const packet>::iterator>);
+    TICK_TRAIT_CHECK(tick::is_mutable_random_access_iterator<tick::mapped_array<packet>::iterator>);
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<tick::mapped_array<packet>::iterator>);
+    TICK_TRAIT_CHECK(tick::is_range<tick::mapped_array<const packet>>);
+    TICK_TRAIT_CHECK(tick::is_sized_range<tick::mapped_array<const packet>>);
+    static_assert(!tick::is_copy_constructible<tick::mapped_array<packet>>(), "Mapping is copyable");
+    static_assert(std::is_nothrow_move_constructible<tick::mapped_array<packet>>(), "Mapping move can throw");
+    static_assert(!std::is_constructible<tick::mapped_array<const packet>, std::string, std::size_t>(), "Read only mapping creates files");
+};
+
+TICK_TEST_CASE()
+{
+    tick::mapped_array<const packet> a;
+    TICK_TEST_CHECK(a.empty());
+    TICK_TEST_CHECK(a.begin() == a.end());
+    a.advise(tick::mapped_advice::sequential);
+}
+
+TICK_TEST_CASE()
+{
+    temp_file f;
+    {
+        tick::mapped_array<packet> out(f.path, 1000);
+        TICK_TEST_CHECK(out.size() == 1000);
+        for(std::uint32_t i=0;i<out.size();i++)
+        {
+            out[i].time = i;
+            out[i].length = i % 100;
+            out[i].flags = 0;
+        }
+        out.flush();
+    }
+    tick::mapped_array<const packet> in(f.path);
+    TICK_TEST_CHECK(in.size() == 1000);
+    TICK_TEST_CHECK(in.front().time == 0);
+    TICK_TEST_CHECK(in.back().time == 999);
+    TICK_TEST_CHECK(in.at(500).length == 0);
+    in.advise(tick::mapped_advice::sequential);
+    std::uint64_t bytes = 0;
+    for(const packet& p:in) bytes += p.length;
+    TICK_TEST_CHECK(bytes == 10 * 4950);
+    in.advise(tick::mapped_advice::random, 990, 100);
+    TICK_TEST_CHECK(std::distance(in.rbegin(), in.rend()) == 1000);
+    TICK_TEST_CHECK(in.rbegin()->time == 999);
+
+    bool thrown = false;
+    try { in.at(1000); }
+    catch(const std::out_of_range&) { thrown = true; }
+    TICK_TEST_CHECK(thrown);
+}
+
+TICK_TEST_CASE()
+{
+    temp_file f;
+    {
+        tick::mapped_array<std::uint32_t> out(f.path, 100);
+        std::iota(out.begin(), out.end(), 0u);
+        tick::sort(out.begin(), out.end(), std::greater<std::uint32_t>());
+    }
+    // Changes are written back to the file
+    tick::mapped_array<std::uint32_t> a(f.path);
+    TICK_TEST_CHECK(a.size() == 100);
+    TICK_TEST_CHECK(a[0] == 99);
+    a[0] = 1000;
+    tick::mapped_array<std::uint32_t> b(std::move(a));
+    TICK_TEST_CHECK(a.empty());
+    TICK_TEST_CHECK(b.size() == 100);
+    a = std::move(b);
+    TICK_TEST_CHECK(a[0] == 1000);
+    TICK_TEST_CHECK(b.empty());
+    // Reopening at a smaller size truncates the file
+    a = tick::mapped_array<std::uint32_t>(f.path, 0);
+    TICK_TEST_CHECK(a.empty());
+    TICK_TEST_CHECK(tick::mapped_array<const std::uint32_t>(f.path).empty());
+}
+
+TICK_TEST_CASE()
+{
+    temp_file f;
+    {
+        tick::mapped_array<char> out(f.path, sizeof(packet) * 3 + 5);
+    }
+    // The bytes after the last whole element are left out
+    TICK_TEST_CHECK(tick::mapped_array<const packet>(f.path).size() == 3);
+
+    bool thrown = false;
+    try { tick::mapped_array<const packet> missing(f.path + ".missing"); }
+    catch(const std::system_error&) { thrown = true; }
+    TICK_TEST_CHECK(thrown);
+}
+#endif
@@ -0,0 +1,120 @@
+#include "test.h"
+#include <tick/mpmc_queue.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct throwing_copy
+{
+    throwing_copy()
+    {}
+    throwing_copy(const throwing_copy&)
+    {}
+};
+
+template<class Queue, class T>
+struct can_push
+{
+    template<class Q>
+    static auto check(Q* q) -> decltype(q->try_push(std::declval<T>()), tick::true_type());
+    static tick::false_type check(...);
+    typedef decltype(check(static_cast<Queue*>(nullptr))) type;
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(can_push<tick::mpmc_queue<std::string>, std::string>::type(), "Can not push a string");
+    static_assert(!can_push<tick::mpmc_queue<std::string>, const std::string&>::type(), "Copied a string that may throw");
+    static_assert(!can_push<tick::mpmc_queue<throwing_copy>, throwing_copy>::type(), "Pushed a type that may throw");
+    static_assert(can_push<tick::mpmc_queue<int>, const int&>::type(), "Can not copy an int");
+};
+
+TICK_TEST_CASE()
+{
+    tick::mpmc_queue<std::unique_ptr<int>> q(4);
+    TICK_TEST_CHECK(q.capacity() == 4);
+    for(int i=0;i<4;i++) TICK_TEST_CHECK(q.try_emplace(new int(i)));
+    TICK_TEST_CHECK(!q.try_push(std::unique_ptr<int>(new int(4))));
+    TICK_TEST_CHECK(q.size() == 4);
+    std::unique_ptr<int> x;
+    TICK_TEST_CHECK(q.try_pop(x));
+    TICK_TEST_CHECK(*x == 0);
+    std::vector<std::unique_ptr<int>> out(8);
+    TICK_TEST_CHECK(q.pop_n(out.begin(), 8) == 3);
+    TICK_TEST_CHECK(*out[2] == 3);
+    TICK_TEST_CHECK(!q.try_pop(x));
+    TICK_TEST_CHECK(q.empty());
+
+    // The remaining elements are destroyed with the queue
+    int in[6] = { 1, 2, 3, 4, 5, 6 };
+    tick::mpmc_queue<int> iq(4);
+    TICK_TEST_CHECK(iq.push_n(in, 6) == 4);
+    TICK_TEST_CHECK(iq.push_n(in, 6) == 0);
+    TICK_TEST_CHECK(q.try_push(std::unique_ptr<int>(new int(5))));
+}
+
+TICK_TEST_CASE()
+{
+    // A single slot can't tell a full slot from a free one, so it gets two
+    tick::mpmc_queue<std::unique_ptr<int>> q1(1);
+    TICK_TEST_CHECK(q1.capacity() == 2);
+    tick::mpmc_queue<std::unique_ptr<int>> q2(2);
+    TICK_TEST_CHECK(q2.capacity() == 2);
+    for(tick::mpmc_queue<std::unique_ptr<int>>* q:{ &q1, &q2 })
+    {
+        for(int round=0;round<3;round++)
+        {
+            TICK_TEST_CHECK(q->try_emplace(new int(1)));
+            TICK_TEST_CHECK(q->try_emplace(new int(2)));
+            TICK_TEST_CHECK(!q->try_push(std::unique_ptr<int>(new int(3))));
+            std::unique_ptr<int> x;
+            TICK_TEST_CHECK(q->try_pop(x) and *x == 1);
+            TICK_TEST_CHECK(q->try_pop(x) and *x == 2);
+            TICK_TEST_CHECK(!q->try_pop(x));
+        }
+        TICK_TEST_CHECK(q->try_emplace(new int(4)));
+    }
+}
+
+TICK_TEST_CASE()
+{
+    // Every element is popped exactly once
+    const int producers = 3;
+    const int consumers = 3;
+    const int count = 30000;
+    tick::mpmc_queue<int> q(64);
+    std::vector<std::atomic<int>> seen(producers * count);
+    for(std::atomic<int>& s:seen) s = 0;
+    std::atomic<int> popped(0);
+    std::vector<std::thread> threads;
+    for(int p=0;p<producers;p++) threads.emplace_back([&, p]
+    {
+        int values[5];
+        for(int i=0;i<count;)
+        {
+            int n = std::min(5, count - i);
+            for(int j=0;j<n;j++) values[j] = p * count + i + j;
+            std::size_t pushed = (i % 2 == 0) ? q.push_n(values, n) : q.try_push(values[0]);
+            if (pushed == 0) std::this_thread::yield();
+            i += int(pushed);
+        }
+    });
+    for(int c=0;c<consumers;c++) threads.emplace_back([&, c]
+    {
+        int values[4];
+        while(popped.load() < producers * count)
+        {
+            std::size_t n = (c % 2 == 0) ? q.pop_n(values, 4) : q.try_pop(values[0]);
+            if (n == 0) std::this_thread::yield();
+            for(std::size_t j=0;j<n;j++) seen[values[j]]++;
+            popped += int(n);
+        }
+    });
+    for(std::thread& t:threads) t.join();
+    bool once = true;
+    for(std::atomic<int>& s:seen) once = once and s == 1;
+    TICK_TEST_CHECK(once);
+    TICK_TEST_CHECK(q.empty());
+}
@@ -0,0 +1,137 @@
+#include "test.h"
+#include <tick/pool_allocator.h>
+#include <tick/traits/is_allocator.h>
+#include <tick/trait_check.h>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::pair<const int, std::string> entry;
+typedef std::map<int, std::string, std::less<int>, tick::pool_allocator<entry>> pooled_map;
+
+// Destroyed at exit, after the cache of the main thread is gone
+static pooled_map names;
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_allocator<tick::pool_allocator<int>>);
+    TICK_TRAIT_CHECK(tick::is_allocator<tick::pool_allocator<std::pair<const int, int>>>);
+};
+
+TICK_TEST_CASE()
+{
+    tick::pool p;
+    TICK_TEST_CHECK(p.bytes_reserved() == 0);
+    void* x = p.allocate(24);
+    void* y = p.allocate(24);
+    TICK_TEST_CHECK(x != y);
+    TICK_TEST_CHECK(reinterpret_cast<std::uintptr_t>(x) % 16 == 0);
+    TICK_TEST_CHECK(p.bytes_reserved() == tick::pool::default_slab_size);
+    p.deallocate(x, 24);
+    // Freed chunks are reused by the same size class
+    TICK_TEST_CHECK(p.allocate(32) == x);
+    p.deallocate(y, 24);
+
+    // Large and over-aligned allocations bypass the slabs
+    void* big = p.allocate(4096);
+    void* aligned = p.allocate(8, 128);
+    TICK_TEST_CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 128 == 0);
+    p.deallocate(big, 4096);
+    p.deallocate(aligned, 8, 128);
+}
+
+TICK_TEST_CASE()
+{
+    tick::pool p;
+    typedef std::pair<const int, int> pair;
+    std::map<int, int, std::less<int>, tick::pool_allocator<pair>> m{tick::pool_allocator<pair>(p)};
+    for(int i=0;i<10000;i++) m[i] = i;
+    for(int i=0;i<10000;i+=2) m.erase(i);
+    TICK_TEST_CHECK(m.size() == 5000);
+    std::size_t reserved = p.bytes_reserved();
+    // The erased nodes are reused
+    for(int i=0;i<10000;i+=2) m[i] = i;
+    TICK_TEST_CHECK(p.bytes_reserved() == reserved);
+    TICK_TEST_CHECK(m.at(42) == 42);
+
+    std::set<int, std::less<int>, tick::pool_allocator<int>> s;
+    TICK_TEST_CHECK(s.get_allocator() == tick::pool_allocator<int>());
+    for(int i=0;i<100;i++) s.insert(i);
+    TICK_TEST_CHECK(*s.rbegin() == 99);
+
+    std::vector<int, tick::pool_allocator<int>> v;
+    for(int i=0;i<1000;i++) v.push_back(i);
+    TICK_TEST_CHECK(v[999] == 999);
+}
+
+TICK_TEST_CASE()
+{
+    for(int i=0;i<1000;i++) names[i] = std::string(40, 'a' + i % 26);
+
+    // Built on one thread and used and destroyed on another, after the
+    // first has exited
+    pooled_map m;
+    std::thread t([&m]
+    {
+        for(int i=0;i<1000;i++) m[i] = std::string(40, 'a' + i % 26);
+    });
+    t.join();
+    int count = 0;
+    for(const entry& x:m) count += x.second[0] == 'a' + x.first % 26;
+    TICK_TEST_CHECK(count == 1000);
+
+    std::thread u([&m]
+    {
+        for(int i=0;i<1000;i+=2) m.erase(i);
+        pooled_map local;
+        local.swap(m);
+    });
+    u.join();
+    TICK_TEST_CHECK(m.empty());
+    TICK_TEST_CHECK(m.get_allocator().get_pool() == nullptr);
+}
+
+TICK_TEST_CASE()
+{
+    // Several threads allocating and freeing through the shared pool
+    std::vector<std::thread> threads;
+    for(int k=0;k<4;k++) threads.emplace_back([k]
+    {
+        std::set<int, std::less<int>, tick::pool_allocator<int>> s;
+        for(int i=0;i<10000;i++) s.insert(i * 4 + k);
+        for(int i=0;i<10000;i+=3) s.erase(i * 4 + k);
+        TICK_TEST_CHECK(s.size() == 6666);
+    });
+    for(std::thread& t:threads) t.join();
+}
+
+struct large_chunk
+{
+    char bytes[496];
+};
+
+TICK_TEST_CASE()
+{
+    // A thread that only frees gives the chunks back to the shared pool
+    // when it exits, so they are handed out again
+    tick::pool_allocator<large_chunk> a;
+    std::vector<large_chunk*> freed;
+    for(int i=0;i<40;i++) freed.push_back(a.allocate(1));
+    std::thread t([&]
+    {
+        for(large_chunk* p:freed) a.deallocate(p, 1);
+    });
+    t.join();
+    std::set<large_chunk*> old(freed.begin(), freed.end());
+    std::vector<large_chunk*> chunks;
+    int reused = 0;
+    for(int i=0;i<100;i++)
+    {
+        chunks.push_back(a.allocate(1));
+        reused += old.count(chunks.back());
+    }
+    TICK_TEST_CHECK(reused == 40);
+    for(large_chunk* p:chunks) a.deallocate(p, 1);
+}
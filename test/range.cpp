@@ -0,0 +1,112 @@
+#include "test.h"
+#include <tick/range.h>
+#include <tick/small_vector.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int allocations = 0;
+
+template<class T>
+struct counting_allocator : std::allocator<T>
+{
+    template<class U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator()
+    {}
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>&)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        allocations++;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+// A range that knows its size, but can only be read once
+struct numbers
+{
+    std::istringstream s;
+    std::size_t n;
+
+    numbers(const std::string& x, std::size_t n) : s(x), n(n)
+    {}
+
+    std::istream_iterator<int> begin()
+    {
+        return std::istream_iterator<int>(s);
+    }
+
+    std::istream_iterator<int> end()
+    {
+        return std::istream_iterator<int>();
+    }
+
+    std::size_t size() const
+    {
+        return n;
+    }
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_sized_range<std::vector<int>>);
+    TICK_TRAIT_CHECK(tick::is_sized_range<std::list<int>>);
+    TICK_TRAIT_CHECK(tick::is_sized_range<numbers&>);
+    TICK_TRAIT_CHECK(tick::is_reservable<std::vector<int, counting_allocator<int>>>);
+    TICK_TRAIT_CHECK(tick::is_reservable<tick::small_vector<int, 4>>);
+};
+
+TICK_TEST_CASE()
+{
+    std::vector<int, counting_allocator<int>> v;
+    numbers r("1 2 3 4 5 6 7 8 9 10", 10);
+    TICK_TEST_CHECK(tick::range_size(r) == 10);
+    allocations = 0;
+    tick::append(v, r);
+    TICK_TEST_CHECK(allocations == 1);
+    TICK_TEST_CHECK(v.size() == 10);
+    TICK_TEST_CHECK(v.back() == 10);
+
+    numbers more("11 12 13", 3);
+    tick::append(v, more);
+    TICK_TEST_CHECK(allocations == 2);
+    TICK_TEST_CHECK(v.capacity() >= 20);
+
+    numbers few("5 6", 2);
+    tick::assign(v, few);
+    TICK_TEST_CHECK(allocations == 2);
+    TICK_TEST_CHECK(v.size() == 2 and v.front() == 5);
+
+    std::forward_list<int> fl = { 1, 2, 3 };
+    auto it = tick::insert_range(v, v.begin() + 1, fl);
+    TICK_TEST_CHECK(*it == 1);
+    TICK_TEST_CHECK((v == std::vector<int, counting_allocator<int>>{5, 1, 2, 3, 6}));
+}
+
+TICK_TEST_CASE()
+{
+    int a[] = { 1, 2, 3 };
+    TICK_TEST_CHECK(tick::range_size(a) == 3);
+    std::deque<int> d;
+    tick::append(d, a);
+    tick::append(d, std::list<int>{ 4, 5 });
+    TICK_TEST_CHECK((d == std::deque<int>{ 1, 2, 3, 4, 5 }));
+
+    std::string s = "ad";
+    tick::insert_range(s, s.begin() + 1, std::string("bc"));
+    TICK_TEST_CHECK(s == "abcd");
+}
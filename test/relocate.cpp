@@ -0,0 +1,153 @@
+#include "test.h"
+#include <tick/relocate.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+template<class T>
+struct raw_buffer
+{
+    std::allocator<T> alloc;
+    T* data;
+    raw_buffer(std::size_t n) : data(alloc.allocate(n)), n(n)
+    {}
+    ~raw_buffer()
+    {
+        alloc.deallocate(data, n);
+    }
+private:
+    std::size_t n;
+};
+
+struct counted
+{
+    static int alive;
+    int value;
+    counted(int x) : value(x) { alive++; }
+    counted(counted&& rhs) : value(rhs.value) { alive++; }
+    ~counted() { alive--; }
+};
+int counted::alive = 0;
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(tick::is_trivially_relocatable<int>(), "int not trivially relocatable");
+    static_assert(tick::is_trivially_relocatable<std::unique_ptr<int>>(), "unique_ptr not trivially relocatable");
+    static_assert(!tick::is_trivially_relocatable<counted>(), "counted is trivially relocatable");
+
+    static_assert(tick::detail::is_memmove_relocatable<std::unique_ptr<int>*, std::unique_ptr<int>*>(), "Not memmove");
+    static_assert(!tick::detail::is_memmove_relocatable<counted*, counted*>(), "Memmove on non trivial type");
+};
+
+TICK_TEST_CASE()
+{
+    raw_buffer<std::unique_ptr<int>> src(4);
+    raw_buffer<std::unique_ptr<int>> dst(4);
+    for(int i=0;i<4;i++) new(src.data + i) std::unique_ptr<int>(new int(i));
+
+    auto last = tick::relocate(src.data, src.data + 4, dst.data);
+    TICK_TEST_CHECK(last == dst.data + 4);
+    for(int i=0;i<4;i++) TICK_TEST_CHECK(*dst.data[i] == i);
+
+    // Erase the first element by shifting the rest down
+    tick::destroy_at(dst.data);
+    tick::relocate(dst.data + 1, dst.data + 4, dst.data);
+    for(int i=0;i<3;i++) TICK_TEST_CHECK(*dst.data[i] == i + 1);
+
+    // Make room for an element at the front
+    auto first = tick::relocate_backward(dst.data, dst.data + 3, dst.data + 4);
+    TICK_TEST_CHECK(first == dst.data + 1);
+    new(dst.data) std::unique_ptr<int>(new int(0));
+    for(int i=0;i<4;i++) TICK_TEST_CHECK(*dst.data[i] == i);
+
+    tick::uninitialized_relocate_n(dst.data, 4, src.data);
+    for(int i=0;i<4;i++) TICK_TEST_CHECK(*src.data[i] == i);
+    tick::detail::destroy_range(src.data, src.data + 4);
+}
+
+TICK_TEST_CASE()
+{
+    {
+        raw_buffer<counted> src(4);
+        raw_buffer<counted> dst(5);
+        for(int i=0;i<4;i++) new(src.data + i) counted(i);
+        TICK_TEST_CHECK(counted::alive == 4);
+
+        tick::uninitialized_relocate_n(src.data, 4, dst.data);
+        TICK_TEST_CHECK(counted::alive == 4);
+        for(int i=0;i<4;i++) TICK_TEST_CHECK(dst.data[i].value == i);
+
+        auto first = tick::relocate_backward(dst.data, dst.data + 4, dst.data + 5);
+        TICK_TEST_CHECK(first == dst.data + 1);
+        TICK_TEST_CHECK(counted::alive == 4);
+        for(int i=0;i<4;i++) TICK_TEST_CHECK(dst.data[i + 1].value == i);
+
+        auto last = tick::relocate(dst.data + 1, dst.data + 5, dst.data);
+        TICK_TEST_CHECK(last == dst.data + 4);
+        TICK_TEST_CHECK(counted::alive == 4);
+        for(int i=0;i<4;i++) TICK_TEST_CHECK(dst.data[i].value == i);
+        tick::detail::destroy_range(dst.data, dst.data + 4);
+    }
+    TICK_TEST_CHECK(counted::alive == 0);
+}
+
+TICK_TEST_CASE()
+{
+    std::string values[] = { "a", "b", "c" };
+    raw_buffer<std::string> dst(3);
+    auto last = tick::relocate(std::begin(values), std::end(values), dst.data);
+    TICK_TEST_CHECK(last == dst.data + 3);
+    TICK_TEST_CHECK(dst.data[0] == "a");
+    TICK_TEST_CHECK(dst.data[2] == "c");
+    // Reconstruct the source so it can be destroyed at the end of the scope
+    tick::relocate(dst.data, dst.data + 3, std::begin(values));
+    TICK_TEST_CHECK(values[1] == "b");
+}
+
+// Copies can fail, and moves are not marked noexcept
+struct fragile
+{
+    static int copies_left;
+    int value;
+    bool moved_from;
+    fragile(int x) : value(x), moved_from(false) {}
+    fragile(const fragile& rhs) : value(rhs.value), moved_from(false)
+    {
+        if (copies_left-- == 0) throw std::runtime_error("copy");
+    }
+    fragile(fragile&& rhs) : value(rhs.value), moved_from(false) { rhs.moved_from = true; }
+};
+int fragile::copies_left = 0;
+
+TICK_TEST_CASE()
+{
+    raw_buffer<fragile> src(3);
+    raw_buffer<fragile> dst(3);
+    for(int i=0;i<3;i++) new(src.data + i) fragile(i);
+
+    fragile::copies_left = 1;
+    bool thrown = false;
+    try { tick::relocate_if_noexcept(src.data, src.data + 3, dst.data); }
+    catch(const std::runtime_error&) { thrown = true; }
+    TICK_TEST_CHECK(thrown);
+    // The source is untouched
+    for(int i=0;i<3;i++) TICK_TEST_CHECK(src.data[i].value == i and !src.data[i].moved_from);
+
+    fragile::copies_left = 3;
+    auto last = tick::relocate_if_noexcept(src.data, src.data + 3, dst.data);
+    TICK_TEST_CHECK(last == dst.data + 3);
+    TICK_TEST_CHECK(fragile::copies_left == 0);
+    for(int i=0;i<3;i++) TICK_TEST_CHECK(dst.data[i].value == i);
+    tick::detail::destroy_range(dst.data, dst.data + 3);
+}
+
+TICK_TEST_CASE()
+{
+    // Strings are moved since their move constructor does not throw
+    std::string values[] = { std::string(100, 'a'), std::string(100, 'b') };
+    const char* data = values[0].data();
+    raw_buffer<std::string> dst(2);
+    tick::relocate_if_noexcept(std::begin(values), std::end(values), dst.data);
+    TICK_TEST_CHECK(dst.data[0].data() == data);
+    tick::relocate(dst.data, dst.data + 2, std::begin(values));
+}
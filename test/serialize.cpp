@@ -0,0 +1,290 @@
+#include "test.h"
+#include <tick/serialize.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+struct sample
+{
+    std::uint64_t time;
+    double value;
+};
+
+namespace telemetry {
+
+struct record
+{
+    std::uint32_t id;
+    std::string name;
+    std::vector<sample> samples;
+};
+
+template<class F>
+void serialize_fields(record& r, F f)
+{
+    f(r.id);
+    f(r.name);
+    f(r.samples);
+}
+
+struct opaque
+{
+    std::string name;
+};
+
+// A trivially copyable view of characters stored elsewhere
+struct text
+{
+    const char* first;
+    const char* last;
+
+    const char* begin() const
+    {
+        return first;
+    }
+
+    const char* end() const
+    {
+        return last;
+    }
+};
+
+struct message
+{
+    std::uint32_t id;
+    text body;
+};
+
+template<class F>
+void serialize_fields(message& m, F f)
+{
+    f(m.id);
+    f(m.body);
+}
+
+}
+
+template<class T>
+struct can_deserialize
+{
+    template<class U>
+    static auto check(U* x) -> decltype(tick::deserialize(*x, std::declval<std::vector<tick::iovec>&>()), tick::true_type());
+    static tick::false_type check(...);
+    typedef decltype(check(static_cast<T*>(nullptr))) type;
+};
+
+static std::size_t total_size(const std::vector<tick::iovec>& iov)
+{
+    std::size_t n = 0;
+    for(const tick::iovec& v:iov) n += v.iov_len;
+    return n;
+}
+
+static std::string gather(const std::vector<tick::iovec>& iov)
+{
+    std::string result;
+    for(const tick::iovec& v:iov) result.append(static_cast<const char*>(v.iov_base), v.iov_len);
+    return result;
+}
+
+static void scatter(const std::string& bytes, const std::vector<tick::iovec>& iov)
+{
+    std::size_t offset = 0;
+    for(const tick::iovec& v:iov)
+    {
+        std::memcpy(v.iov_base, bytes.data() + offset, v.iov_len);
+        offset += v.iov_len;
+    }
+}
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(tick::detail::serialize_kind<sample>() == 0, "Trivial type not written as bytes");
+    static_assert(tick::detail::serialize_kind<const sample>() == 0, "Trivial type not written as bytes");
+    static_assert(tick::detail::serialize_kind<std::array<sample, 4>>() == 2, "Array not written as elements");
+    static_assert(tick::detail::serialize_kind<telemetry::text>() == 2, "View written as its own bytes");
+    static_assert(tick::detail::serialize_kind<const telemetry::text>() == 2, "View written as its own bytes");
+#if __cplusplus >= 201703L
+    static_assert(tick::detail::serialize_kind<std::string_view>() == 2, "View written as its own bytes");
+#endif
+    static_assert(tick::detail::serialize_kind<telemetry::record>() == 1, "Fields not used");
+    static_assert(tick::detail::serialize_kind<const telemetry::record>() == 1, "Fields not used");
+    static_assert(tick::detail::serialize_kind<std::vector<sample>>() == 2, "Range not written as elements");
+    static_assert(tick::detail::serialize_kind<std::string>() == 2, "Range not written as elements");
+    static_assert(tick::detail::serialize_kind<telemetry::opaque>() == 3, "Non trivial type allowed");
+    static_assert(tick::detail::serialize_kind<std::vector<bool>>() == 3, "Range of proxies allowed");
+
+    static_assert(can_deserialize<sample>::type(), "Can not read into a trivial type");
+    static_assert(can_deserialize<std::vector<sample>>::type(), "Can not read into a vector");
+    static_assert(can_deserialize<telemetry::record>::type(), "Can not read into fields");
+    static_assert(can_deserialize<std::deque<std::array<int, 2>>>::type(), "Can not read into nested ranges");
+    static_assert(!can_deserialize<const sample>::type(), "Read into a const object");
+    static_assert(!can_deserialize<std::set<int>>::type(), "Read into const keys");
+    static_assert(!can_deserialize<std::vector<std::set<int>>>::type(), "Read into nested const keys");
+    static_assert(!can_deserialize<telemetry::text>::type(), "Read into a view of const characters");
+    static_assert(!can_deserialize<telemetry::opaque>::type(), "Read into a non trivial type");
+#if __cplusplus >= 201703L
+    static_assert(!can_deserialize<std::string_view>::type(), "Read into a view of const characters");
+#endif
+};
+
+TICK_TEST_CASE()
+{
+    sample s = { 1, 2.5 };
+    std::vector<tick::iovec> iov;
+    tick::serialize(s, iov);
+    TICK_TEST_CHECK(iov.size() == 1);
+    TICK_TEST_CHECK(iov[0].iov_base == &s);
+    TICK_TEST_CHECK(iov[0].iov_len == sizeof(sample));
+}
+
+TICK_TEST_CASE()
+{
+    std::vector<int> v = { 1, 2, 3, 4, 5 };
+    std::vector<tick::iovec> iov;
+    tick::serialize(v, iov);
+    TICK_TEST_CHECK(iov.size() == 1);
+    TICK_TEST_CHECK(iov[0].iov_base == v.data());
+    TICK_TEST_CHECK(iov[0].iov_len == v.size() * sizeof(int));
+    // Empty ranges add nothing
+    tick::serialize(std::vector<int>(), iov);
+    TICK_TEST_CHECK(iov.size() == 1);
+}
+
+TICK_TEST_CASE()
+{
+    std::deque<std::uint64_t> d;
+    for(std::uint64_t i=0;i<1000;i++) d.push_back(i);
+    std::vector<tick::iovec> iov;
+    tick::serialize(d, iov);
+    TICK_TEST_CHECK(iov.size() > 1);
+    TICK_TEST_CHECK(iov.size() < 100);
+    TICK_TEST_CHECK(total_size(iov) == d.size() * sizeof(std::uint64_t));
+
+    std::deque<std::uint64_t> copy(d.size());
+    std::vector<tick::iovec> in;
+    tick::deserialize(copy, in);
+    scatter(gather(iov), in);
+    TICK_TEST_CHECK(copy == d);
+}
+
+TICK_TEST_CASE()
+{
+    std::array<sample, 4> a = {{ { 1, 0.5 }, { 2, 1.5 }, { 3, 2.5 }, { 4, 3.5 } }};
+    std::vector<tick::iovec> iov;
+    tick::serialize(a, iov);
+    TICK_TEST_CHECK(iov.size() == 1);
+    TICK_TEST_CHECK(iov[0].iov_base == a.data());
+    TICK_TEST_CHECK(iov[0].iov_len == sizeof(a));
+}
+
+TICK_TEST_CASE()
+{
+    // A view field is written as the characters it refers to
+    std::string body = "hello";
+    telemetry::message m = { 3, { body.data(), body.data() + body.size() } };
+    std::vector<tick::iovec> iov;
+    tick::serialize(m, iov);
+    TICK_TEST_CHECK(iov.size() == 2);
+    TICK_TEST_CHECK(iov[1].iov_base == body.data());
+    TICK_TEST_CHECK(gather(iov).substr(sizeof(std::uint32_t)) == "hello");
+#if __cplusplus >= 201703L
+    std::string_view v = body;
+    iov.clear();
+    tick::serialize(v, iov);
+    TICK_TEST_CHECK(iov.size() == 1);
+    TICK_TEST_CHECK(gather(iov) == "hello");
+#endif
+}
+
+TICK_TEST_CASE()
+{
+    std::list<int> l = { 1, 2, 3 };
+    std::vector<tick::iovec> iov;
+    tick::serialize(l, iov);
+    TICK_TEST_CHECK(total_size(iov) == 3 * sizeof(int));
+    TICK_TEST_CHECK(gather(iov).size() == 3 * sizeof(int));
+}
+
+TICK_TEST_CASE()
+{
+    telemetry::record r;
+    r.id = 7;
+    r.name = "cpu";
+    r.samples.push_back(sample{ 1, 0.5 });
+    r.samples.push_back(sample{ 2, 0.75 });
+    std::vector<tick::iovec> iov;
+    tick::serialize(r, iov);
+    TICK_TEST_CHECK(iov.size() == 3);
+    TICK_TEST_CHECK(iov[0].iov_base == &r.id);
+    TICK_TEST_CHECK(iov[2].iov_base == r.samples.data());
+    TICK_TEST_CHECK(total_size(iov) == sizeof(std::uint32_t) + 3 + 2 * sizeof(sample));
+
+    telemetry::record copy;
+    copy.name.resize(r.name.size());
+    copy.samples.resize(r.samples.size());
+    std::vector<tick::iovec> in;
+    tick::deserialize(copy, in);
+    scatter(gather(iov), in);
+    TICK_TEST_CHECK(copy.id == 7);
+    TICK_TEST_CHECK(copy.name == "cpu");
+    TICK_TEST_CHECK(copy.samples[1].time == 2);
+    TICK_TEST_CHECK(copy.samples[1].value == 0.75);
+}
+
+TICK_TEST_CASE()
+{
+    // A range of objects with fields
+    std::vector<telemetry::record> records(3);
+    for(std::uint32_t i=0;i<3;i++)
+    {
+        records[i].id = i;
+        records[i].name = "r";
+    }
+    std::vector<tick::iovec> iov;
+    tick::serialize(records, iov);
+    TICK_TEST_CHECK(total_size(iov) == 3 * (sizeof(std::uint32_t) + 1));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TICK_TEST_CASE()
+{
+    std::vector<sample> samples;
+    for(std::uint64_t i=0;i<100;i++) samples.push_back(sample{ i, i * 0.5 });
+    std::uint32_t count = samples.size();
+    std::vector<tick::iovec> iov;
+    tick::serialize(count, iov);
+    tick::serialize(samples, iov);
+
+    int fds[2];
+    TICK_TEST_CHECK(pipe(fds) == 0);
+    ssize_t written = writev(fds[1], iov.data(), iov.size());
+    TICK_TEST_CHECK(written == ssize_t(total_size(iov)));
+    close(fds[1]);
+
+    std::uint32_t read_count = 0;
+    std::vector<tick::iovec> in;
+    tick::deserialize(read_count, in);
+    TICK_TEST_CHECK(read(fds[0], in[0].iov_base, in[0].iov_len) == ssize_t(sizeof(std::uint32_t)));
+    TICK_TEST_CHECK(read_count == 100);
+
+    std::vector<sample> read_samples(read_count);
+    in.clear();
+    tick::deserialize(read_samples, in);
+    TICK_TEST_CHECK(readv(fds[0], in.data(), in.size()) == ssize_t(read_count * sizeof(sample)));
+    close(fds[0]);
+    TICK_TEST_CHECK(read_samples[99].time == 99);
+    TICK_TEST_CHECK(read_samples[99].value == 49.5);
+}
+#endif
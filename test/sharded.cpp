@@ -0,0 +1,100 @@
+#include "test.h"
+#include <tick/sharded.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct max_op
+{
+    int operator()(int x, int y) const
+    {
+        return std::max(x, y);
+    }
+};
+
+// Default constructed as the identity of merge_span
+struct span
+{
+    span() : low(INT_MAX), high(INT_MIN)
+    {}
+
+    span(int l, int h) : low(l), high(h)
+    {}
+
+    int low;
+    int high;
+};
+
+struct merge_span
+{
+    span operator()(const span& x, const span& y) const
+    {
+        return span(std::min(x.low, y.low), std::max(x.high, y.high));
+    }
+};
+
+TICK_TEST_CASE()
+{
+    tick::sharded<std::uint64_t> c;
+    TICK_TEST_CHECK(c.shards() >= 1);
+    TICK_TEST_CHECK(c.load() == 0);
+    c.update(3);
+    c.update(4);
+    TICK_TEST_CHECK(c.load() == 7);
+
+    tick::sharded<int> odd(3);
+    TICK_TEST_CHECK(odd.shards() == 4);
+}
+
+// Shared by more threads than there are shards
+TICK_TEST_CASE()
+{
+    tick::sharded<std::uint64_t> c(2);
+    std::vector<std::thread> threads;
+    for(int t=0;t<4;t++) threads.emplace_back([&c]
+    {
+        for(int i=0;i<10000;i++) c.update(1);
+    });
+    for(std::thread& t:threads) t.join();
+    TICK_TEST_CHECK(c.load() == 40000);
+}
+
+TICK_TEST_CASE()
+{
+    tick::sharded<int, max_op> m(4);
+    std::vector<std::thread> threads;
+    for(int t=0;t<4;t++) threads.emplace_back([&m, t]
+    {
+        for(int i=0;i<1000;i++) m.update(t * 1000 + i);
+    });
+    for(std::thread& t:threads) t.join();
+    TICK_TEST_CHECK(m.load() == 3999);
+}
+
+// Guarded by a mutex, since the value is not a lock free atomic
+TICK_TEST_CASE()
+{
+    tick::sharded<std::string> s(2);
+    std::vector<std::thread> threads;
+    for(int t=0;t<3;t++) threads.emplace_back([&s]
+    {
+        for(int i=0;i<100;i++) s.update("x");
+    });
+    for(std::thread& t:threads) t.join();
+    TICK_TEST_CHECK(s.load() == std::string(300, 'x'));
+}
+
+TICK_TEST_CASE()
+{
+    tick::sharded<span, merge_span> s(2);
+    TICK_TEST_CHECK(s.load().low == INT_MAX);
+    s.update(span(3, 5));
+    s.update(span(1, 4));
+    span r = s.load();
+    TICK_TEST_CHECK(r.low == 1);
+    TICK_TEST_CHECK(r.high == 5);
+}
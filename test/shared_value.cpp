@@ -0,0 +1,77 @@
+#include "test.h"
+#include <tick/shared_value.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct snapshot
+{
+    std::uint64_t fields[8];
+};
+
+struct odd_size
+{
+    char bytes[13];
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(tick::detail::shared_value_kind_of<int>::value == tick::detail::shared_value_kind::atomic, "Int is not atomic");
+    static_assert(tick::detail::shared_value_kind_of<snapshot>::value == tick::detail::shared_value_kind::seqlock, "Snapshot does not use a seqlock");
+    static_assert(tick::detail::shared_value_kind_of<std::string>::value == tick::detail::shared_value_kind::locked, "String is not locked");
+};
+
+TICK_TEST_CASE()
+{
+    tick::shared_value<int> i(1);
+    TICK_TEST_CHECK(i.load() == 1);
+    i.store(2);
+    TICK_TEST_CHECK(i.load() == 2);
+
+    tick::shared_value<std::string> s;
+    TICK_TEST_CHECK(s.load().empty());
+    s.store("hello");
+    TICK_TEST_CHECK(s.load() == "hello");
+
+    odd_size x;
+    for(int j=0;j<13;j++) x.bytes[j] = char(j + 1);
+    tick::shared_value<odd_size> o(x);
+    TICK_TEST_CHECK(o.load().bytes[12] == 13);
+    x.bytes[12] = 42;
+    o.store(x);
+    TICK_TEST_CHECK(o.load().bytes[0] == 1);
+    TICK_TEST_CHECK(o.load().bytes[12] == 42);
+}
+
+TICK_TEST_CASE()
+{
+    // Readers never see the fields of two different stores
+    tick::shared_value<snapshot> v;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+    std::vector<std::thread> readers;
+    for(int i=0;i<3;i++) readers.emplace_back([&]
+    {
+        while(!done.load())
+        {
+            snapshot s = v.load();
+            for(std::uint64_t f:s.fields) if (f != s.fields[0]) torn++;
+        }
+    });
+    std::vector<std::thread> writers;
+    for(int i=0;i<2;i++) writers.emplace_back([&, i]
+    {
+        for(std::uint64_t j=0;j<20000;j++)
+        {
+            snapshot s;
+            for(std::uint64_t& f:s.fields) f = j * 2 + i;
+            v.store(s);
+        }
+    });
+    for(std::thread& t:writers) t.join();
+    done = true;
+    for(std::thread& t:readers) t.join();
+    TICK_TEST_CHECK(torn == 0);
+    TICK_TEST_CHECK(v.load().fields[7] >= 39998);
+}
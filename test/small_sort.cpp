@@ -0,0 +1,73 @@
+#include "test.h"
+#include <tick/small_sort.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(tick::detail::sorting_network_size(0) == 0, "Wrong network size");
+    static_assert(tick::detail::sorting_network_size(1) == 0, "Wrong network size");
+    static_assert(tick::detail::sorting_network_size(2) == 1, "Wrong network size");
+    static_assert(tick::detail::sorting_network_size(4) == 5, "Wrong network size");
+    static_assert(tick::detail::sorting_network_size(8) == 19, "Wrong network size");
+    static_assert(tick::detail::sorting_network_size(16) == 63, "Wrong network size");
+    static_assert(tick::detail::sorting_network_size(32) == 191, "Wrong network size");
+    static_assert(tick::detail::sorting_network_wire(4, 4, false) == 1, "Wrong network step");
+    static_assert(tick::detail::sorting_network_wire(4, 4, true) == 2, "Wrong network step");
+};
+
+// By the 0-1 principle, a network that sorts every sequence of zeros and
+// ones sorts every sequence
+template<std::size_t N>
+void check_zero_one()
+{
+    for(unsigned long bits=0;bits < (1ul << N);bits++)
+    {
+        int a[N];
+        for(std::size_t i=0;i<N;i++) a[i] = (bits >> i) & 1;
+        tick::small_sort<N>(a);
+        TICK_TEST_CHECK(std::is_sorted(a, a + N));
+    }
+}
+
+template<std::size_t... Ns>
+void check_zero_one(tick::detail::network_seq<Ns...>)
+{
+    int expand[] = { 0, (check_zero_one<Ns>(), 0)... };
+    (void)expand;
+}
+
+TICK_TEST_CASE()
+{
+    check_zero_one(tick::detail::network_gens<19>::type());
+}
+
+TICK_TEST_CASE()
+{
+    std::mt19937 rng(7);
+    for(std::size_t n=0;n<=40;n++)
+    {
+        for(int k=0;k<100;k++)
+        {
+            std::vector<double> v(n);
+            for(double& x:v) x = std::uniform_real_distribution<double>(-1, 1)(rng);
+            std::vector<double> expected = v;
+            std::sort(expected.begin(), expected.end());
+            tick::small_sort(v.begin(), v.end());
+            TICK_TEST_CHECK(v == expected);
+
+            std::vector<std::string> s;
+            for(std::size_t i=0;i<n;i++) s.push_back(std::to_string(rng() % 100));
+            std::vector<std::string> sorted = s;
+            std::sort(sorted.begin(), sorted.end());
+            tick::small_sort(s.data(), s.data() + n);
+            TICK_TEST_CHECK(s == sorted);
+        }
+    }
+
+    unsigned char pivots[5] = { 4, 1, 5, 3, 2 };
+    tick::small_sort<5>(pivots);
+    TICK_TEST_CHECK(pivots[2] == 3);
+}
@@ -0,0 +1,296 @@
+#include "test.h"
+#include <tick/small_vector.h>
+#include <tick/traits.h>
+#include <tick/trait_check.h>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_container<tick::small_vector<int, 4>>);
+    TICK_TRAIT_CHECK(tick::is_reversible_container<tick::small_vector<int, 4>>);
+    TICK_TRAIT_CHECK(tick::is_sequence_container<tick::small_vector<int, 4>>);
+    TICK_TRAIT_CHECK(tick::is_sequence_container<tick::small_vector<std::string, 4>>);
+    TICK_TRAIT_CHECK(tick::is_sequence_container<tick::small_vector<int, 0>>);
+    TICK_TRAIT_CHECK(tick::is_random_access_iterator<tick::small_vector<int, 4>::iterator>);
+};
+
+TICK_TEST_CASE()
+{
+    tick::small_vector<int, 4> v;
+    TICK_TEST_CHECK(v.empty());
+    TICK_TEST_CHECK(v.is_inline());
+    TICK_TEST_CHECK(v.capacity() == 4);
+    for(int i=0;i<4;i++) v.push_back(i);
+    TICK_TEST_CHECK(v.is_inline());
+    v.push_back(4);
+    TICK_TEST_CHECK(!v.is_inline());
+    TICK_TEST_CHECK(v.size() == 5);
+    for(int i=0;i<5;i++) TICK_TEST_CHECK(v[i] == i);
+
+    v.erase(v.begin(), v.begin() + 2);
+    TICK_TEST_CHECK(v.size() == 3);
+    TICK_TEST_CHECK(v.front() == 2);
+    v.shrink_to_fit();
+    TICK_TEST_CHECK(v.is_inline());
+    TICK_TEST_CHECK((v == tick::small_vector<int, 4>{2, 3, 4}));
+
+    v.insert(v.begin() + 1, 3, 7);
+    TICK_TEST_CHECK((v == tick::small_vector<int, 4>{2, 7, 7, 7, 3, 4}));
+    v.insert(v.end(), v.front());
+    TICK_TEST_CHECK(v.back() == 2);
+    v.resize(2);
+    TICK_TEST_CHECK((v == tick::small_vector<int, 4>{2, 7}));
+
+    std::list<int> l = { 1, 2, 3 };
+    v.insert(v.begin(), l.begin(), l.end());
+    TICK_TEST_CHECK((v == tick::small_vector<int, 4>{1, 2, 3, 2, 7}));
+    TICK_TEST_CHECK(*v.rbegin() == 7);
+}
+
+TICK_TEST_CASE()
+{
+    tick::small_vector<std::string, 2> v = { "a", "b" };
+    tick::small_vector<std::string, 2> copy = v;
+    v.emplace_back("c");
+    TICK_TEST_CHECK(copy.size() == 2);
+    TICK_TEST_CHECK(v.size() == 3);
+    TICK_TEST_CHECK(v[2] == "c");
+
+    tick::small_vector<std::string, 2> moved = std::move(v);
+    TICK_TEST_CHECK(v.empty());
+    TICK_TEST_CHECK(moved.size() == 3);
+
+    tick::small_vector<std::string, 2> inline_moved = std::move(copy);
+    TICK_TEST_CHECK(copy.empty());
+    TICK_TEST_CHECK(inline_moved.is_inline());
+    TICK_TEST_CHECK(inline_moved[1] == "b");
+
+    swap(moved, inline_moved);
+    TICK_TEST_CHECK(moved.size() == 2);
+    TICK_TEST_CHECK(inline_moved.size() == 3);
+
+    moved = inline_moved;
+    TICK_TEST_CHECK(moved == inline_moved);
+    moved.emplace(moved.begin(), "z");
+    TICK_TEST_CHECK(moved.front() == "z");
+    TICK_TEST_CHECK(inline_moved < moved);
+}
+
+TICK_TEST_CASE()
+{
+    tick::small_vector<std::unique_ptr<int>, 1> v;
+    for(int i=0;i<10;i++) v.emplace_back(new int(i));
+    for(int i=0;i<10;i++) TICK_TEST_CHECK(*v[i] == i);
+    v.erase(v.begin());
+    TICK_TEST_CHECK(*v.front() == 1);
+}
+
+struct throwing_copy
+{
+    static bool fail;
+    int value;
+    throwing_copy(int x) : value(x) {}
+    throwing_copy(const throwing_copy& rhs) : value(rhs.value)
+    {
+        if (fail) throw std::runtime_error("copy");
+    }
+    throwing_copy(throwing_copy&& rhs) : value(rhs.value)
+    {
+        rhs.value = -1;
+    }
+};
+bool throwing_copy::fail = false;
+
+TICK_TEST_CASE()
+{
+    // Growing copies the elements, since moving them could throw, so a
+    // failed growth leaves the vector as it was
+    tick::small_vector<throwing_copy, 2> v;
+    v.emplace_back(1);
+    v.emplace_back(2);
+    throwing_copy::fail = true;
+    bool thrown = false;
+    try { v.emplace_back(3); }
+    catch(const std::runtime_error&) { thrown = true; }
+    throwing_copy::fail = false;
+    TICK_TEST_CHECK(thrown);
+    TICK_TEST_CHECK(v.size() == 2);
+    TICK_TEST_CHECK(v.is_inline());
+    TICK_TEST_CHECK(v[0].value == 1 and v[1].value == 2);
+    v.emplace_back(3);
+    TICK_TEST_CHECK(v.size() == 3);
+    TICK_TEST_CHECK(v[0].value == 1 and v[2].value == 3);
+}
+
+// An allocator that neither propagates nor is always equal
+template<class T>
+struct stateful_allocator : std::allocator<T>
+{
+    typedef std::false_type is_always_equal;
+    typedef std::false_type propagate_on_container_move_assignment;
+    template<class U>
+    struct rebind
+    {
+        typedef stateful_allocator<U> other;
+    };
+    int id;
+    stateful_allocator(int i=0) : id(i)
+    {}
+    template<class U>
+    stateful_allocator(const stateful_allocator<U>& a) : id(a.id)
+    {}
+    friend bool operator==(const stateful_allocator& x, const stateful_allocator& y)
+    {
+        return x.id == y.id;
+    }
+    friend bool operator!=(const stateful_allocator& x, const stateful_allocator& y)
+    {
+        return x.id != y.id;
+    }
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    typedef tick::small_vector<std::string, 4> strings;
+    static_assert(std::is_nothrow_move_constructible<strings>(), "Move can throw");
+    static_assert(std::is_nothrow_move_assignable<strings>(), "Move assignment can throw");
+    static_assert(noexcept(std::declval<strings&>().swap(std::declval<strings&>())), "Swap can throw");
+    static_assert(!std::is_nothrow_move_constructible<tick::small_vector<throwing_copy, 4>>(), "Move of throwing elements is noexcept");
+    typedef tick::small_vector<int, 4, stateful_allocator<int>> stateful;
+    static_assert(std::is_nothrow_move_constructible<stateful>(), "Move can throw");
+    static_assert(!std::is_nothrow_move_assignable<stateful>(), "Move assignment that can copy is noexcept");
+};
+
+struct counted_copy
+{
+    static int copies;
+    counted_copy()
+    {}
+    counted_copy(const counted_copy&)
+    {
+        copies++;
+    }
+    counted_copy(counted_copy&&) noexcept
+    {}
+    counted_copy& operator=(const counted_copy&) = default;
+    counted_copy& operator=(counted_copy&&) = default;
+};
+int counted_copy::copies = 0;
+
+TICK_TEST_CASE()
+{
+    // A vector of small vectors moves them when it grows
+    std::vector<tick::small_vector<counted_copy, 2>> v;
+    for(int i=0;i<100;i++) v.emplace_back(2);
+    TICK_TEST_CHECK(counted_copy::copies == 0);
+}
+
+// Counts the live objects, and throws from a move once it has been moved a
+// given number of times
+struct throwing_move
+{
+    static int live;
+    static int moves_left;
+    int value;
+    throwing_move(int x) : value(x)
+    {
+        live++;
+    }
+    throwing_move(const throwing_move& rhs) : value(rhs.value)
+    {
+        live++;
+    }
+    throwing_move(throwing_move&& rhs) : value(rhs.value)
+    {
+        if (moves_left == 0) throw std::runtime_error("move");
+        if (moves_left > 0) moves_left--;
+        live++;
+    }
+    throwing_move& operator=(const throwing_move&) = default;
+    throwing_move& operator=(throwing_move&&) = default;
+    ~throwing_move()
+    {
+        live--;
+    }
+};
+int throwing_move::live = 0;
+int throwing_move::moves_left = -1;
+
+TICK_TEST_CASE()
+{
+    // The inline elements are destroyed once when moving them throws
+    {
+        tick::small_vector<throwing_move, 4> v;
+        for(int i=0;i<3;i++) v.emplace_back(i);
+        throwing_move::moves_left = 1;
+        bool thrown = false;
+        try { tick::small_vector<throwing_move, 4> moved(std::move(v)); }
+        catch(const std::runtime_error&) { thrown = true; }
+        throwing_move::moves_left = -1;
+        TICK_TEST_CHECK(thrown);
+        TICK_TEST_CHECK(v.empty());
+        TICK_TEST_CHECK(throwing_move::live == 0);
+        v.emplace_back(5);
+        TICK_TEST_CHECK(throwing_move::live == 1);
+    }
+    TICK_TEST_CHECK(throwing_move::live == 0);
+}
+
+template<class T>
+struct move_only_propagating_allocator : stateful_allocator<T>
+{
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+    template<class U>
+    struct rebind
+    {
+        typedef move_only_propagating_allocator<U> other;
+    };
+    move_only_propagating_allocator(int i=0) : stateful_allocator<T>(i)
+    {}
+    template<class U>
+    move_only_propagating_allocator(const move_only_propagating_allocator<U>& a) : stateful_allocator<T>(a.id)
+    {}
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    typedef tick::small_vector<int, 4, move_only_propagating_allocator<int>> vector_type;
+    static_assert(std::is_nothrow_move_assignable<vector_type>(), "Move assignment that propagates can throw");
+    static_assert(!noexcept(std::declval<vector_type&>().swap(std::declval<vector_type&>())), "Swap that can copy is noexcept");
+};
+
+TICK_TEST_CASE()
+{
+    // Swapping doesn't propagate the allocators, even though moving does
+    typedef tick::small_vector<std::string, 2, move_only_propagating_allocator<std::string>> vector_type;
+    for(int sizes=0;sizes<9;sizes++)
+    {
+        std::size_t xn = (sizes / 3) * 3;
+        std::size_t yn = (sizes % 3) * 3 + 1;
+        vector_type x(move_only_propagating_allocator<std::string>(1));
+        vector_type y(move_only_propagating_allocator<std::string>(2));
+        for(std::size_t i=0;i<xn;i++) x.push_back("x" + std::to_string(i));
+        for(std::size_t i=0;i<yn;i++) y.push_back("y" + std::to_string(i));
+        swap(x, y);
+        TICK_TEST_CHECK(x.get_allocator().id == 1);
+        TICK_TEST_CHECK(y.get_allocator().id == 2);
+        TICK_TEST_CHECK(x.size() == yn);
+        TICK_TEST_CHECK(y.size() == xn);
+        for(std::size_t i=0;i<yn;i++) TICK_TEST_CHECK(x[i] == "y" + std::to_string(i));
+        for(std::size_t i=0;i<xn;i++) TICK_TEST_CHECK(y[i] == "x" + std::to_string(i));
+    }
+
+    // Equal allocators hand the storage over
+    vector_type x(move_only_propagating_allocator<std::string>(1));
+    vector_type y(move_only_propagating_allocator<std::string>(1));
+    for(int i=0;i<5;i++) x.push_back("x");
+    const std::string* data = x.data();
+    x.swap(y);
+    TICK_TEST_CHECK(x.empty());
+    TICK_TEST_CHECK(y.data() == data);
+}
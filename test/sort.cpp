@@ -0,0 +1,101 @@
+#include "test.h"
+#include <tick/sort.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+TICK_STATIC_TEST_CASE()
+{
+    static_assert(tick::detail::sort_order<int*, std::less<int>>() == 1, "Not radix sorted");
+    static_assert(tick::detail::sort_order<double*, std::greater<double>>() == -1, "Not radix sorted");
+#if __cplusplus >= 201402L
+    static_assert(tick::detail::sort_order<std::vector<std::uint64_t>::iterator, std::less<>>() == 1, "Not radix sorted");
+#endif
+    static_assert(tick::detail::sort_order<bool*, std::less<bool>>() == 0, "Radix sorted");
+    static_assert(tick::detail::sort_order<long double*, std::less<long double>>() == 0, "Radix sorted");
+    static_assert(tick::detail::sort_order<int*, std::less<long>>() == 0, "Radix sorted");
+    static_assert(tick::detail::sort_order<std::string*, std::less<std::string>>() == 0, "Radix sorted");
+};
+
+template<class T, class Compare>
+void check_sort(std::vector<T> v, Compare comp)
+{
+    std::vector<T> expected = v;
+    std::sort(expected.begin(), expected.end(), comp);
+    tick::sort(v.begin(), v.end(), comp);
+    TICK_TEST_CHECK(v == expected);
+
+    std::deque<T> d(expected.rbegin(), expected.rend());
+    tick::sort(d.begin(), d.end(), comp);
+    TICK_TEST_CHECK(std::equal(d.begin(), d.end(), expected.begin()));
+}
+
+// Random, sorted, reversed, few distinct and organ pipe inputs
+template<class T, class Generator>
+void check_patterns(Generator gen)
+{
+    std::mt19937 rng(42);
+    for(std::size_t n:{0, 1, 2, 5, 23, 24, 100, 255, 256, 1000, 5000})
+    {
+        std::vector<T> v;
+        for(std::size_t i=0;i<n;i++) v.push_back(gen(rng));
+        check_sort(v, std::less<T>());
+        check_sort(v, std::greater<T>());
+        std::sort(v.begin(), v.end());
+        check_sort(v, std::less<T>());
+        check_sort(v, std::greater<T>());
+        for(std::size_t i=0;i<n;i++) v[i] = v[i % 4];
+        check_sort(v, std::less<T>());
+        std::vector<T> pipe(v.begin(), v.begin() + n / 2);
+        pipe.insert(pipe.end(), v.rbegin() + n / 2, v.rend());
+        check_sort(pipe, std::less<T>());
+    }
+}
+
+TICK_TEST_CASE()
+{
+    check_patterns<int>([](std::mt19937& r) { return int(r()); });
+    check_patterns<std::uint64_t>([](std::mt19937& r) { return (std::uint64_t(r()) << 32) | r(); });
+    check_patterns<std::int64_t>([](std::mt19937& r) { return std::int64_t((std::uint64_t(r()) << 32) | r()); });
+    check_patterns<signed char>([](std::mt19937& r) { return static_cast<signed char>(r()); });
+    check_patterns<std::uint16_t>([](std::mt19937& r) { return std::uint16_t(r() % 100); });
+    check_patterns<float>([](std::mt19937& r) { return std::uniform_real_distribution<float>(-1e6f, 1e6f)(r); });
+    check_patterns<double>([](std::mt19937& r) { return std::uniform_real_distribution<double>(-1.0, 1.0)(r); });
+    check_patterns<std::string>([](std::mt19937& r) { return std::to_string(r() % 1000); });
+    check_patterns<std::pair<int, int>>([](std::mt19937& r) { return std::make_pair(int(r() % 10), int(r())); });
+}
+
+TICK_TEST_CASE()
+{
+    std::vector<double> v = { 3.5, -0.0, std::numeric_limits<double>::infinity(), -1e300, 0.0, -std::numeric_limits<double>::infinity() };
+    for(int i=0;i<300;i++) v.push_back(i * 0.5 - 70);
+    tick::sort(v.begin(), v.end());
+    TICK_TEST_CHECK(std::is_sorted(v.begin(), v.end()));
+    TICK_TEST_CHECK(v.front() == -std::numeric_limits<double>::infinity());
+    TICK_TEST_CHECK(v.back() == std::numeric_limits<double>::infinity());
+
+    std::vector<int> w(1000);
+    for(int i=0;i<1000;i++) w[i] = (i * 7919) % 1000 - 500;
+#if __cplusplus >= 201402L
+    tick::sort(w.begin(), w.end(), std::greater<>());
+#else
+    tick::sort(w.begin(), w.end(), std::greater<int>());
+#endif
+    TICK_TEST_CHECK(std::is_sorted(w.begin(), w.end(), std::greater<int>()));
+    tick::sort(w.data(), w.data() + w.size());
+    TICK_TEST_CHECK(std::is_sorted(w.begin(), w.end()));
+    tick::sort(w.begin(), w.end(), [](int x, int y) { return (x & 0xff) < (y & 0xff); });
+    TICK_TEST_CHECK(std::is_sorted(w.begin(), w.end(), [](int x, int y) { return (x & 0xff) < (y & 0xff); }));
+
+    // Enough bad pivots to fall back to heapsort
+    std::vector<int> killer(100000);
+    for(std::size_t i=0;i<killer.size();i++) killer[i] = int(i % 2 ? i : killer.size() - i);
+    tick::sort(killer.begin(), killer.end(), [](int x, int y) { return x < y; });
+    TICK_TEST_CHECK(std::is_sorted(killer.begin(), killer.end()));
+}
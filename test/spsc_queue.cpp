@@ -0,0 +1,93 @@
+#include "test.h"
+#include <tick/spsc_queue.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+template<class Queue, class T>
+struct can_push
+{
+    template<class Q>
+    static auto check(Q* q) -> decltype(q->try_push(std::declval<T>()), tick::true_type());
+    static tick::false_type check(...);
+    typedef decltype(check(static_cast<Queue*>(nullptr))) type;
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    typedef tick::spsc_queue<std::unique_ptr<int>> ptr_queue;
+    static_assert(can_push<ptr_queue, std::unique_ptr<int>>::type(), "Can not push a move only type");
+    static_assert(!can_push<ptr_queue, const std::unique_ptr<int>&>::type(), "Copied a move only type");
+    static_assert(tick::detail::is_memcpy_transfer<int, const int*>(), "No memcpy for ints");
+    static_assert(!tick::detail::is_memcpy_transfer<std::string, std::string*>(), "Memcpy for strings");
+};
+
+TICK_TEST_CASE()
+{
+    tick::spsc_queue<std::string> q(3);
+    TICK_TEST_CHECK(q.capacity() == 4);
+    TICK_TEST_CHECK(q.empty());
+    std::string s = "a";
+    TICK_TEST_CHECK(q.try_push(s));
+    TICK_TEST_CHECK(q.try_push(std::string("b")));
+    TICK_TEST_CHECK(q.try_emplace(1, 'c'));
+    TICK_TEST_CHECK(q.try_emplace("d"));
+    TICK_TEST_CHECK(!q.try_push(s));
+    TICK_TEST_CHECK(q.size() == 4);
+    std::string x;
+    TICK_TEST_CHECK(q.try_pop(x));
+    TICK_TEST_CHECK(x == "a");
+    TICK_TEST_CHECK(q.try_push("e"));
+    std::vector<std::string> out(5);
+    TICK_TEST_CHECK(q.pop_n(out.begin(), 5) == 4);
+    TICK_TEST_CHECK(out[0] == "b");
+    TICK_TEST_CHECK(out[3] == "e");
+    TICK_TEST_CHECK(!q.try_pop(x));
+    // The remaining elements are destroyed with the queue
+    std::vector<std::string> in = { "f", "g", "h", "i", "j" };
+    TICK_TEST_CHECK(q.push_n(in.begin(), in.size()) == 4);
+}
+
+TICK_TEST_CASE()
+{
+    // Batches that wrap around the end of the buffer
+    tick::spsc_queue<int> q(8);
+    int in[6] = { 1, 2, 3, 4, 5, 6 };
+    int out[6] = {};
+    for(int i=0;i<10;i++)
+    {
+        TICK_TEST_CHECK(q.push_n(static_cast<const int*>(in), 6) == 6);
+        TICK_TEST_CHECK(q.push_n(static_cast<const int*>(in), 6) == 2);
+        TICK_TEST_CHECK(q.pop_n(out, 6) == 6);
+        TICK_TEST_CHECK(out[0] == 1 and out[5] == 6);
+        TICK_TEST_CHECK(q.pop_n(out, 6) == 2);
+        TICK_TEST_CHECK(out[0] == 1 and out[1] == 2);
+        TICK_TEST_CHECK(q.pop_n(out, 6) == 0);
+    }
+}
+
+TICK_TEST_CASE()
+{
+    tick::spsc_queue<std::unique_ptr<int>> q(16);
+    const int count = 100000;
+    std::thread producer([&]
+    {
+        for(int i=0;i<count;i++)
+        {
+            std::unique_ptr<int> p(new int(i));
+            while(!q.try_push(std::move(p))) std::this_thread::yield();
+        }
+    });
+    bool in_order = true;
+    std::vector<std::unique_ptr<int>> batch(7);
+    for(int next=0;next<count;)
+    {
+        std::size_t n = q.pop_n(batch.begin(), batch.size());
+        if (n == 0) std::this_thread::yield();
+        for(std::size_t i=0;i<n;i++) in_order = in_order and *batch[i] == next++;
+    }
+    producer.join();
+    TICK_TEST_CHECK(in_order);
+    TICK_TEST_CHECK(q.empty());
+}
@@ -0,0 +1,257 @@
+#include "test.h"
+#include <tick/task.h>
+
+#if TICK_HAS_COROUTINES
+
+#include <tick/arena.h>
+#include <tick/traits/is_awaitable.h>
+#include <tick/traits/is_awaiter.h>
+#include <tick/trait_check.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_awaitable<tick::task<int>>);
+    TICK_TRAIT_CHECK(tick::is_awaitable<tick::task<>>);
+    static_assert(!tick::is_awaitable<tick::task<int>&>(), "Task lvalue is awaitable");
+};
+
+template<class T>
+struct counting_allocator
+{
+    typedef T value_type;
+    int* allocations;
+
+    counting_allocator(int* n) : allocations(n)
+    {}
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>& a) : allocations(a.allocations)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        (*allocations)++;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        (*allocations)--;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<class U>
+    bool operator==(const counting_allocator<U>& a) const
+    {
+        return allocations == a.allocations;
+    }
+
+    template<class U>
+    bool operator!=(const counting_allocator<U>& a) const
+    {
+        return allocations != a.allocations;
+    }
+};
+
+tick::task<int> add_one(int x)
+{
+    co_return x + 1;
+}
+
+tick::task<std::string> concat(std::string x, std::string y)
+{
+    std::string result = x;
+    result += y;
+    co_return result;
+}
+
+tick::task<int> sum(int n)
+{
+    int result = 0;
+    for(int i=0;i<n;i++) result += co_await add_one(i);
+    co_return result;
+}
+
+TICK_TEST_CASE()
+{
+    TICK_TEST_CHECK(tick::sync_wait(add_one(1)) == 2);
+    TICK_TEST_CHECK(tick::sync_wait(concat("ab", "cd")) == "abcd");
+    TICK_TEST_CHECK(tick::sync_wait(sum(4)) == 1 + 2 + 3 + 4);
+}
+
+// Created lazily, so nothing runs until it is awaited
+TICK_TEST_CASE()
+{
+    int runs = 0;
+    auto f = [&]() -> tick::task<>
+    {
+        runs++;
+        co_return;
+    };
+    tick::task<> t = f();
+    TICK_TEST_CHECK(runs == 0);
+    TICK_TEST_CHECK(!t.is_ready());
+    tick::sync_wait(std::move(t));
+    TICK_TEST_CHECK(runs == 1);
+    // Destroying a task that never ran
+    tick::task<> u = f();
+    u = tick::task<>();
+    TICK_TEST_CHECK(runs == 1);
+    TICK_TEST_CHECK(u.is_ready());
+}
+
+tick::task<int> fail()
+{
+    throw std::runtime_error("fail");
+    co_return 0;
+}
+
+tick::task<int> recover()
+{
+    try
+    {
+        co_await fail();
+    }
+    catch(const std::runtime_error&)
+    {
+        co_return -1;
+    }
+    co_return 0;
+}
+
+TICK_TEST_CASE()
+{
+    TICK_TEST_CHECK(tick::sync_wait(recover()) == -1);
+    bool thrown = false;
+    try
+    {
+        tick::sync_wait(fail());
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    TICK_TEST_CHECK(thrown);
+}
+
+tick::task<std::unique_ptr<int>> make_unique_int(int x)
+{
+    co_return std::unique_ptr<int>(new int(x));
+}
+
+TICK_TEST_CASE()
+{
+    std::unique_ptr<int> p = tick::sync_wait(make_unique_int(3));
+    TICK_TEST_CHECK(*p == 3);
+}
+
+// Each task finishes without suspending and resumes the loop through
+// symmetric transfer
+TICK_TEST_CASE()
+{
+    TICK_TEST_CHECK(tick::sync_wait(sum(10000)) == 50005000);
+}
+
+// GCC warns in coroutines with allocator arguments that the frame is
+// freed with a different function than the one that allocated it
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+tick::task<int> allocated(std::allocator_arg_t, counting_allocator<char>, int* allocations, int x)
+{
+    TICK_TEST_CHECK(*allocations == 1);
+    co_return x;
+}
+
+struct widget
+{
+    int x;
+
+    tick::task<int> get(std::allocator_arg_t, counting_allocator<char>, int* allocations)
+    {
+        TICK_TEST_CHECK(*allocations == 1);
+        co_return x;
+    }
+};
+
+TICK_TEST_CASE()
+{
+    int allocations = 0;
+    counting_allocator<char> a(&allocations);
+    tick::task<int> t = allocated(std::allocator_arg, a, &allocations, 5);
+    TICK_TEST_CHECK(allocations == 1);
+    TICK_TEST_CHECK(tick::sync_wait(std::move(t)) == 5);
+    TICK_TEST_CHECK(allocations == 0);
+
+    widget w = { 7 };
+    TICK_TEST_CHECK(tick::sync_wait(w.get(std::allocator_arg, a, &allocations)) == 7);
+    TICK_TEST_CHECK(allocations == 0);
+}
+
+tick::task<int> leaf(std::allocator_arg_t, tick::arena_allocator<char>, int x)
+{
+    co_return x * 2;
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+tick::task<int> tree(tick::arena& a, int n)
+{
+    int result = 0;
+    for(int i=0;i<n;i++) result += co_await leaf(std::allocator_arg, tick::arena_allocator<char>(a), i);
+    co_return result;
+}
+
+TICK_TEST_CASE()
+{
+    tick::arena a;
+    TICK_TEST_CHECK(tick::sync_wait(tree(a, 100)) == 9900);
+    a.reset();
+    TICK_TEST_CHECK(tick::sync_wait(tree(a, 100)) == 9900);
+}
+
+// Resumed on another thread
+struct resume_on_thread
+{
+    std::thread* thread;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) const
+    {
+        *thread = std::thread([h] { h.resume(); });
+    }
+
+    void await_resume() const noexcept
+    {}
+};
+
+tick::task<std::thread::id> switch_thread(std::thread* thread)
+{
+    co_await resume_on_thread{ thread };
+    co_return std::this_thread::get_id();
+}
+
+TICK_TEST_CASE()
+{
+    std::thread thread;
+    std::thread::id id = tick::sync_wait(switch_thread(&thread));
+    thread.join();
+    TICK_TEST_CHECK(id != std::this_thread::get_id());
+}
+
+#else
+
+TICK_TEST_CASE()
+{}
+
+#endif
@@ -2,7 +2,9 @@
 #include "test.h"
 #include <tick/traits.h>
 #include <tick/trait_check.h>
+#include <tick/tag.h>
 
+#include <array>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -11,6 +13,12 @@
 #include <unordered_set>
 #include <string>
 #include <deque>
+#include <forward_list>
+#include <functional>
+#include <mutex>
+#if __cplusplus >= 201402L
+#include <shared_mutex>
+#endif
 
 TICK_STATIC_TEST_CASE()
 {
@@ -63,6 +71,13 @@ TICK_STATIC_TEST_CASE()
     TICK_TRAIT_CHECK(tick::is_mutable_random_access_iterator<char*>);
     TICK_TRAIT_CHECK(tick::is_random_access_iterator<char*>);
 
+#ifdef __GLIBCXX__
+    TICK_TRAIT_CHECK(tick::is_segmented_iterator<std::deque<int>::iterator>);
+    TICK_TRAIT_CHECK(tick::is_segmented_iterator<std::deque<int>::const_iterator>);
+#endif
+    static_assert(!tick::is_segmented_iterator<std::vector<int>::iterator>(), "Vector iterator is segmented");
+    static_assert(!tick::is_segmented_iterator<int*>(), "Pointer is segmented");
+
     TICK_TRAIT_CHECK(tick::is_value_swappable<std::vector<int>::iterator>);
     TICK_TRAIT_CHECK(tick::is_value_swappable<std::list<int>::iterator>);
 };
@@ -70,6 +85,101 @@ TICK_STATIC_TEST_CASE()
 TICK_STATIC_TEST_CASE()
 {
     TICK_TRAIT_CHECK(tick::is_allocator<std::allocator<int>>);
+    TICK_TRAIT_CHECK(tick::is_always_equal_allocator<std::allocator<int>>);
+    static_assert(!tick::is_propagating_allocator<std::allocator<int>>(), "Allocator propagates on swap");
+    static_assert(!tick::is_size_feedback_allocator<std::allocator<int>>(), "Allocator has size feedback");
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_trivially_relocatable<int>);
+    TICK_TRAIT_CHECK(tick::is_trivially_relocatable<int*>);
+    TICK_TRAIT_CHECK(tick::is_trivially_relocatable<std::unique_ptr<int>>);
+    TICK_TRAIT_CHECK(tick::is_trivially_relocatable<std::unique_ptr<int[]>>);
+    static_assert(!tick::is_trivially_relocatable<std::list<int>>(), "List is trivially relocatable");
+
+    TICK_TRAIT_CHECK(tick::is_trivially_destructible<int>);
+    TICK_TRAIT_CHECK(tick::is_trivially_destructible<std::unique_ptr<int>*>);
+    static_assert(!tick::is_trivially_destructible<std::string>(), "String is trivially destructible");
+    static_assert(std::is_base_of<tick::tag<tick::is_destructible>, tick::tag<tick::is_trivially_destructible>>(), "Not refined");
+};
+
+struct padded
+{
+    char c;
+    int i;
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_bitwise_comparable<int>);
+    TICK_TRAIT_CHECK(tick::is_bitwise_comparable<int*>);
+    TICK_TRAIT_CHECK(tick::is_bitwise_comparable<int[4]>);
+    TICK_TRAIT_CHECK(tick::is_bitwise_comparable<std::array<long long, 2>>);
+    TICK_TRAIT_CHECK(tick::is_bitwise_comparable<std::pair<long long, long long>>);
+    static_assert(!tick::is_bitwise_comparable<double>(), "Double is bitwise comparable");
+    static_assert(!tick::is_bitwise_comparable<std::pair<char, int>>(), "Padded pair is bitwise comparable");
+    static_assert(!tick::is_bitwise_comparable<padded>(), "Class is bitwise comparable");
+    static_assert(!tick::is_bitwise_comparable<std::string>(), "String is bitwise comparable");
+};
+
+struct throwing_move
+{
+    throwing_move()
+    {}
+    throwing_move(const throwing_move&)
+    {}
+    throwing_move(throwing_move&&)
+    {}
+    throwing_move& operator=(const throwing_move&)
+    {
+        return *this;
+    }
+    throwing_move& operator=(throwing_move&&)
+    {
+        return *this;
+    }
+};
+
+struct throwing_destructor
+{
+    ~throwing_destructor() noexcept(false)
+    {}
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_nothrow_move_constructible<int>);
+    TICK_TRAIT_CHECK(tick::is_nothrow_move_constructible<std::string>);
+    TICK_TRAIT_CHECK(tick::is_nothrow_move_constructible<std::unique_ptr<int>>);
+    static_assert(!tick::is_nothrow_move_constructible<throwing_move>(), "Move constructor does not throw");
+    static_assert(std::is_base_of<tick::tag<tick::is_move_constructible>, tick::tag<tick::is_nothrow_move_constructible>>(), "Not refined");
+
+    TICK_TRAIT_CHECK(tick::is_nothrow_move_assignable<int>);
+    TICK_TRAIT_CHECK(tick::is_nothrow_move_assignable<std::vector<int>>);
+    static_assert(!tick::is_nothrow_move_assignable<throwing_move>(), "Move assignment does not throw");
+
+    TICK_TRAIT_CHECK(tick::is_nothrow_swappable<int>);
+    TICK_TRAIT_CHECK(tick::is_nothrow_swappable<std::vector<int>>);
+    static_assert(!tick::is_nothrow_swappable<throwing_move>(), "Swap does not throw");
+
+    TICK_TRAIT_CHECK(tick::is_nothrow_destructible<int>);
+    TICK_TRAIT_CHECK(tick::is_nothrow_destructible<std::string>);
+    static_assert(!tick::is_nothrow_destructible<throwing_destructor>(), "Destructor does not throw");
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    struct not_hashable {};
+    TICK_TRAIT_CHECK(tick::is_hashable<int>);
+    TICK_TRAIT_CHECK(tick::is_hashable<int*>);
+    TICK_TRAIT_CHECK(tick::is_hashable<std::string>);
+    static_assert(!tick::is_hashable<not_hashable>(), "Type is hashable");
+
+    TICK_TRAIT_CHECK(tick::is_hash<std::hash<int>, int>);
+    TICK_TRAIT_CHECK(tick::is_hash<std::hash<std::string>, std::string>);
+    static_assert(!tick::is_hash<std::hash<int>, std::string>(), "Hashes a string");
+    static_assert(!tick::is_hash<std::less<int>, int>(), "Compare is a hash");
 };
 
 TICK_STATIC_TEST_CASE()
@@ -79,6 +189,16 @@ TICK_STATIC_TEST_CASE()
     TICK_TRAIT_CHECK(tick::is_range<std::set<int>>);
     TICK_TRAIT_CHECK(tick::is_range<std::map<int, int>>);
 
+    TICK_TRAIT_CHECK(tick::is_sized_range<std::vector<int>>);
+    TICK_TRAIT_CHECK(tick::is_sized_range<std::list<int>>);
+    TICK_TRAIT_CHECK(tick::is_sized_range<int(&)[3]>);
+    static_assert(!tick::is_sized_range<std::forward_list<int>>(), "Forward list is sized");
+
+    TICK_TRAIT_CHECK(tick::is_reservable<std::vector<int>>);
+    TICK_TRAIT_CHECK(tick::is_reservable<std::string>);
+    static_assert(!tick::is_reservable<std::deque<int>>(), "Deque is reservable");
+    static_assert(!tick::is_reservable<std::list<int>>(), "List is reservable");
+
 
     TICK_TRAIT_CHECK(tick::is_container<std::vector<int>>);
     TICK_TRAIT_CHECK(tick::is_container<std::list<int>>);
@@ -107,5 +227,120 @@ TICK_STATIC_TEST_CASE()
 
     static_assert(!tick::is_associative_container<std::vector<int>>(), "Not a associative container");
     static_assert(!tick::is_associative_container<std::list<int>>(), "Not a associative container");
+
+    TICK_TRAIT_CHECK(tick::is_unordered_associative_container<std::unordered_map<int, int>>);
+    TICK_TRAIT_CHECK(tick::is_unordered_associative_container<std::unordered_set<int>>);
+    TICK_TRAIT_CHECK(tick::is_unordered_associative_container<std::unordered_multimap<int, int>>);
+    TICK_TRAIT_CHECK(tick::is_unordered_associative_container<std::unordered_multiset<std::string>>);
+
+    static_assert(!tick::is_unordered_associative_container<std::map<int, int>>(), "Not an unordered associative container");
+    static_assert(!tick::is_unordered_associative_container<std::vector<int>>(), "Not an unordered associative container");
+};
+
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_basic_lockable<std::mutex>);
+    TICK_TRAIT_CHECK(tick::is_lockable<std::mutex>);
+    TICK_TRAIT_CHECK(tick::is_lockable<std::recursive_mutex>);
+    TICK_TRAIT_CHECK(tick::is_lockable<std::unique_lock<std::mutex>>);
+    TICK_TRAIT_CHECK(tick::is_timed_lockable<std::timed_mutex>);
+    static_assert(!tick::is_timed_lockable<std::mutex>(), "Mutex is timed");
+    static_assert(!tick::is_basic_lockable<int>(), "Int is lockable");
+    static_assert(!tick::is_basic_lockable<const std::mutex>(), "Const mutex is lockable");
+    static_assert(!tick::is_shared_lockable<std::mutex>(), "Mutex is shared");
+#if __cplusplus >= 201402L
+    TICK_TRAIT_CHECK(tick::is_shared_lockable<std::shared_timed_mutex>);
+    TICK_TRAIT_CHECK(tick::is_timed_lockable<std::shared_timed_mutex>);
+#endif
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    struct large { long x[4]; };
+    struct user_copy { user_copy() {} int x; };
+    TICK_TRAIT_CHECK(tick::is_trivially_copyable<user_copy>);
+    static_assert(!tick::is_trivially_copyable<std::string>(), "String is trivially copyable");
+
+    TICK_TRAIT_CHECK(tick::is_lock_free_atomic<int>);
+    TICK_TRAIT_CHECK(tick::is_lock_free_atomic<int*>);
+    TICK_TRAIT_CHECK(tick::is_lock_free_atomic<user_copy>);
+    static_assert(!tick::is_lock_free_atomic<large>(), "Large struct is lock free");
+    static_assert(!tick::is_lock_free_atomic<int[2]>(), "Array is lock free");
+    static_assert(!tick::is_lock_free_atomic<std::string>(), "String is lock free");
+};
+
+struct fake_coroutine_handle
+{
+    void* address() const;
+    bool done() const;
+    void resume() const;
+    void destroy() const;
+    explicit operator bool() const;
+};
+
+struct fake_awaiter
+{
+    bool await_ready();
+    bool await_suspend(fake_coroutine_handle);
+    int await_resume();
 };
 
+struct fake_awaiter_bad_suspend
+{
+    bool await_ready();
+    int await_suspend(fake_coroutine_handle);
+    int await_resume();
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_coroutine_handle<fake_coroutine_handle>);
+    TICK_TRAIT_CHECK(tick::is_awaiter<fake_awaiter, fake_coroutine_handle>);
+    static_assert(!tick::is_coroutine_handle<int>(), "Int is a coroutine handle");
+    static_assert(!tick::is_awaiter<fake_awaiter_bad_suspend, fake_coroutine_handle>(), "Int from await_suspend");
+    static_assert(!tick::is_awaiter<fake_awaiter, int>(), "Int is a coroutine handle");
+    static_assert(!tick::is_awaitable<int>(), "Int is awaitable");
+#if TICK_HAS_COROUTINES
+    struct member_co_await { std::suspend_always operator co_await(); };
+    TICK_TRAIT_CHECK(tick::is_coroutine_handle<std::coroutine_handle<>>);
+    TICK_TRAIT_CHECK(tick::is_coroutine_handle<std::noop_coroutine_handle>);
+    TICK_TRAIT_CHECK(tick::is_awaiter<std::suspend_always>);
+    TICK_TRAIT_CHECK(tick::is_awaitable<std::suspend_never>);
+    TICK_TRAIT_CHECK(tick::is_awaitable<member_co_await>);
+    static_assert(!tick::is_awaiter<member_co_await>(), "Awaitable is an awaiter");
+    static_assert(!tick::is_awaiter<fake_awaiter>(), "Awaiter for another handle");
+#endif
+};
+
+struct int_only_operation
+{
+    int operator()(int x, int y) const;
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_binary_operation<std::plus<int>, int>);
+    TICK_TRAIT_CHECK(tick::is_binary_operation<std::plus<std::string>, std::string>);
+    TICK_TRAIT_CHECK(tick::is_binary_operation<int_only_operation, int>);
+    TICK_TRAIT_CHECK(tick::is_binary_operation<int_only_operation, long>);
+    static_assert(!tick::is_binary_operation<int_only_operation, std::string>(), "Operation on string");
+    static_assert(!tick::is_binary_operation<std::less<int>, std::string>(), "Less on string");
+    static_assert(!tick::is_binary_operation<int, int>(), "Int is an operation");
+};
+
+TICK_STATIC_TEST_CASE()
+{
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<int*>);
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<const int*>);
+#ifdef __GLIBCXX__
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<std::vector<int>::iterator>);
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<std::vector<int>::const_iterator>);
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<std::string::iterator>);
+    TICK_TRAIT_CHECK(tick::is_contiguous_iterator<std::array<int, 3>::iterator>);
+#endif
+    static_assert(!tick::is_contiguous_iterator<std::deque<int>::iterator>(), "Deque iterator is contiguous");
+    static_assert(!tick::is_contiguous_iterator<std::list<int>::iterator>(), "List iterator is contiguous");
+    static_assert(!tick::is_contiguous_iterator<std::reverse_iterator<int*>>(), "Reverse iterator is contiguous");
+    static_assert(!tick::is_contiguous_iterator<int>(), "Int is contiguous");
+};
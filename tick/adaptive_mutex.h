@@ -0,0 +1,197 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    adaptive_mutex.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_ADAPTIVE_MUTEX_H
+#define TICK_GUARD_ADAPTIVE_MUTEX_H
+
+/// adaptive_mutex
+/// ==============
+///
+/// Description
+/// -----------
+///
+/// A mutex for short critical sections. A thread that finds the mutex
+/// locked first spins for a while, backing off exponentially between
+/// attempts, since the owner is likely to unlock it soon. Only when that
+/// fails does it sleep in the kernel. Locking and unlocking without
+/// contention are a single atomic instruction each, and an unlock only makes
+/// a system call when some thread is asleep.
+///
+/// On Linux the sleeping threads wait on a futex. Elsewhere they yield
+/// their time slice in a loop instead, which is correct but burns more
+/// time under heavy contention. On a machine with a single processor the
+/// spinning is skipped, since the owner can not run while another thread
+/// spins.
+///
+/// The mutex satisfies [`is_lockable`](is_lockable) and
+/// [`is_timed_lockable`](is_timed_lockable), so it can be used with
+/// `std::lock_guard`, `std::unique_lock` and `std::lock`. It is not
+/// recursive and it is not fair: a spinning thread may take the mutex ahead
+/// of a sleeping one.
+///
+/// Synopsis
+/// --------
+///
+///     class adaptive_mutex
+///     {
+///     public:
+///         constexpr adaptive_mutex() noexcept;
+///
+///         void lock();
+///         bool try_lock() noexcept;
+///         void unlock() noexcept;
+///
+///         template<class Rep, class Period>
+///         bool try_lock_for(const std::chrono::duration<Rep, Period>& d);
+///         template<class Clock, class Duration>
+///         bool try_lock_until(const std::chrono::time_point<Clock, Duration>& t);
+///     };
+///
+/// Example
+/// -------
+///
+///     tick::adaptive_mutex m;
+///     std::size_t hits = 0;
+///     // On each thread
+///     {
+///         std::lock_guard<tick::adaptive_mutex> lock(m);
+///         hits++;
+///     }
+///
+
+#include <tick/detail/backoff.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tick {
+
+namespace detail {
+
+#if defined(__linux__)
+
+// Sleeps while `*p == value`, or until woken or the timeout passes. The
+// kernel checks the value atomically, so a wake after the value changed is
+// never missed.
+inline void futex_wait(std::atomic<int>* p, int value, const timespec* timeout = nullptr)
+{
+    static_assert(sizeof(std::atomic<int>) == sizeof(int), "The futex word must be an int");
+    syscall(SYS_futex, reinterpret_cast<int*>(p), FUTEX_WAIT_PRIVATE, value, timeout, nullptr, 0);
+}
+
+inline void futex_wake(std::atomic<int>* p, int n)
+{
+    syscall(SYS_futex, reinterpret_cast<int*>(p), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+}
+
+template<class Rep, class Period>
+void futex_wait_for(std::atomic<int>* p, int value, const std::chrono::duration<Rep, Period>& d)
+{
+    std::chrono::nanoseconds ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d);
+    timespec timeout;
+    timeout.tv_sec = static_cast<std::time_t>(ns.count() / 1000000000);
+    timeout.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+    detail::futex_wait(p, value, &timeout);
+}
+
+#else
+
+inline void futex_wait(std::atomic<int>*, int)
+{
+    std::this_thread::yield();
+}
+
+inline void futex_wake(std::atomic<int>*, int)
+{}
+
+template<class Rep, class Period>
+void futex_wait_for(std::atomic<int>*, int, const std::chrono::duration<Rep, Period>&)
+{
+    std::this_thread::yield();
+}
+
+#endif
+
+}
+
+class adaptive_mutex
+{
+public:
+    constexpr adaptive_mutex() noexcept : state(unlocked)
+    {}
+
+    adaptive_mutex(const adaptive_mutex&) = delete;
+    adaptive_mutex& operator=(const adaptive_mutex&) = delete;
+
+    void lock()
+    {
+        if (this->try_lock() or this->spin()) return;
+        while(state.exchange(contended, std::memory_order_acquire) != unlocked)
+            detail::futex_wait(&state, contended);
+    }
+
+    bool try_lock() noexcept
+    {
+        int expected = unlocked;
+        return state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        if (state.exchange(unlocked, std::memory_order_release) == contended)
+            detail::futex_wake(&state, 1);
+    }
+
+    template<class Rep, class Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& d)
+    {
+        return this->try_lock_until(std::chrono::steady_clock::now() + d);
+    }
+
+    template<class Clock, class Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration>& t)
+    {
+        if (this->try_lock() or this->spin()) return true;
+        while(state.exchange(contended, std::memory_order_acquire) != unlocked)
+        {
+            typename Clock::time_point now = Clock::now();
+            if (now >= t) return false;
+            detail::futex_wait_for(&state, contended, t - now);
+        }
+        return true;
+    }
+
+private:
+    // The state is `contended` when some thread may be asleep, so that an
+    // unlock without contention does not have to wake anyone
+    enum { unlocked, locked, contended };
+    std::atomic<int> state;
+
+    // Only reads the state while spinning, so the cache line stays shared
+    // until the mutex is unlocked
+    bool spin()
+    {
+        if (!detail::is_spinning_useful()) return false;
+        detail::backoff<> b;
+        while(b.spin())
+        {
+            if (state.load(std::memory_order_relaxed) == unlocked and this->try_lock()) return true;
+        }
+        return false;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,296 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    algorithm.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_ALGORITHM_H
+#define TICK_GUARD_ALGORITHM_H
+
+/// algorithm
+/// =========
+///
+/// Description
+/// -----------
+///
+/// Versions of `std::for_each`, `std::copy`, `std::fill`, `std::find` and
+/// `std::equal` that are aware of [segmented iterators](is_segmented_iterator). For
+/// iterators such as the ones of `std::deque`, the algorithm runs a separate
+/// loop over each contiguous segment. The inner loops work on the local
+/// iterators, usually pointers, so they have no check for the end of a
+/// segment and can be vectorized, and `copy` of trivially copyable elements
+/// becomes a `memmove` per segment.
+///
+/// When `copy` writes to a segmented iterator from a random access range,
+/// the output is split along its segments as well.
+///
+/// When both ranges of `equal` are pointers to the same type, and the type
+/// satisfies [`is_bitwise_comparable`](is_bitwise_comparable), the ranges
+/// are compared with a single `memcmp`.
+///
+/// For other iterators, the algorithms do the same as the standard ones.
+///
+/// Synopsis
+/// --------
+///
+///     template<class InputIterator, class UnaryFunction>
+///     UnaryFunction for_each(InputIterator first, InputIterator last, UnaryFunction f);
+///
+///     template<class InputIterator, class OutputIterator>
+///     OutputIterator copy(InputIterator first, InputIterator last, OutputIterator out);
+///
+///     template<class ForwardIterator, class T>
+///     void fill(ForwardIterator first, ForwardIterator last, const T& x);
+///
+///     template<class InputIterator, class T>
+///     InputIterator find(InputIterator first, InputIterator last, const T& x);
+///
+///     template<class InputIterator1, class InputIterator2>
+///     bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2);
+///
+///     template<class InputIterator1, class InputIterator2>
+///     bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2);
+///
+/// Example
+/// -------
+///
+///     std::deque<int> d(1000);
+///     tick::fill(d.begin(), d.end(), 1);
+///     assert(tick::find(d.begin(), d.end(), 2) == d.end());
+///
+
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/tag.h>
+#include <tick/traits/is_input_iterator.h>
+#include <tick/traits/is_forward_iterator.h>
+#include <tick/traits/is_random_access_iterator.h>
+#include <tick/traits/is_bitwise_comparable.h>
+#include <tick/traits/is_segmented_iterator.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace tick {
+
+namespace detail {
+
+template<class Iterator, class F>
+F for_each_impl(Iterator first, Iterator last, F f, tag<is_input_iterator>)
+{
+    return std::for_each(first, last, std::move(f));
+}
+
+// The function object is passed by reference between the segments, since
+// it may not be assignable
+template<class LocalIterator, class F>
+void for_each_segment(LocalIterator first, LocalIterator last, F& f)
+{
+    for(;first != last;++first) f(*first);
+}
+
+template<class Iterator, class F>
+F for_each_impl(Iterator first, Iterator last, F f, tag<is_segmented_iterator>)
+{
+    typedef segmented_iterator_traits<Iterator> traits;
+    typename traits::segment_iterator sfirst = traits::segment(first);
+    typename traits::segment_iterator slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        detail::for_each_segment(traits::local(first), traits::local(last), f);
+        return f;
+    }
+    detail::for_each_segment(traits::local(first), traits::end(sfirst), f);
+    for(++sfirst;sfirst != slast;++sfirst) detail::for_each_segment(traits::begin(sfirst), traits::end(sfirst), f);
+    detail::for_each_segment(traits::begin(slast), traits::local(last), f);
+    return f;
+}
+
+template<class Iterator, class T>
+void fill_impl(Iterator first, Iterator last, const T& x, tag<is_input_iterator>)
+{
+    std::fill(first, last, x);
+}
+
+template<class Iterator, class T>
+void fill_impl(Iterator first, Iterator last, const T& x, tag<is_segmented_iterator>)
+{
+    typedef segmented_iterator_traits<Iterator> traits;
+    typename traits::segment_iterator sfirst = traits::segment(first);
+    typename traits::segment_iterator slast = traits::segment(last);
+    if (sfirst == slast) return std::fill(traits::local(first), traits::local(last), x);
+    std::fill(traits::local(first), traits::end(sfirst), x);
+    for(++sfirst;sfirst != slast;++sfirst) std::fill(traits::begin(sfirst), traits::end(sfirst), x);
+    std::fill(traits::begin(slast), traits::local(last), x);
+}
+
+template<class Iterator, class T>
+Iterator find_impl(Iterator first, Iterator last, const T& x, tag<is_input_iterator>)
+{
+    return std::find(first, last, x);
+}
+
+template<class Iterator, class T>
+Iterator find_impl(Iterator first, Iterator last, const T& x, tag<is_segmented_iterator>)
+{
+    typedef segmented_iterator_traits<Iterator> traits;
+    typename traits::segment_iterator sfirst = traits::segment(first);
+    typename traits::segment_iterator slast = traits::segment(last);
+    typename traits::local_iterator lfirst = traits::local(first);
+    typename traits::local_iterator llast = traits::local(last);
+    if (sfirst != slast)
+    {
+        typename traits::local_iterator e = traits::end(sfirst);
+        typename traits::local_iterator i = std::find(lfirst, e, x);
+        if (i != e) return traits::compose(sfirst, i);
+        for(++sfirst;sfirst != slast;++sfirst)
+        {
+            e = traits::end(sfirst);
+            i = std::find(traits::begin(sfirst), e, x);
+            if (i != e) return traits::compose(sfirst, i);
+        }
+        lfirst = traits::begin(slast);
+    }
+    typename traits::local_iterator i = std::find(lfirst, llast, x);
+    return i == llast ? last : traits::compose(slast, i);
+}
+
+// Splits the output along its segments, which needs the size of each
+// chunk of the input
+template<class InputIterator, class OutputIterator>
+OutputIterator copy_to(InputIterator first, InputIterator last, OutputIterator out, true_type)
+{
+    typedef segmented_iterator_traits<OutputIterator> traits;
+    typename traits::segment_iterator s = traits::segment(out);
+    typename traits::local_iterator l = traits::local(out);
+    auto n = last - first;
+    while(true)
+    {
+        auto room = traits::end(s) - l;
+        if (n <= room) return traits::compose(s, std::copy(first, last, l));
+        std::copy(first, first + room, l);
+        first += room;
+        n -= room;
+        ++s;
+        l = traits::begin(s);
+    }
+}
+
+template<class InputIterator, class OutputIterator>
+OutputIterator copy_to(InputIterator first, InputIterator last, OutputIterator out, false_type)
+{
+    return std::copy(first, last, out);
+}
+
+template<class InputIterator, class OutputIterator>
+OutputIterator copy_impl(InputIterator first, InputIterator last, OutputIterator out, tag<is_input_iterator>)
+{
+    return detail::copy_to(first, last, out, integral_constant<bool, (
+        is_segmented_iterator<OutputIterator>() and is_random_access_iterator<InputIterator>()
+    )>());
+}
+
+template<class InputIterator, class OutputIterator>
+OutputIterator copy_impl(InputIterator first, InputIterator last, OutputIterator out, tag<is_segmented_iterator>)
+{
+    typedef segmented_iterator_traits<InputIterator> traits;
+    typedef typename traits::local_iterator local_iterator;
+    typedef most_refined<is_segmented_iterator<local_iterator>> local_tag;
+    typename traits::segment_iterator sfirst = traits::segment(first);
+    typename traits::segment_iterator slast = traits::segment(last);
+    if (sfirst == slast) return detail::copy_impl(traits::local(first), traits::local(last), out, local_tag());
+    out = detail::copy_impl(traits::local(first), traits::end(sfirst), out, local_tag());
+    for(++sfirst;sfirst != slast;++sfirst) out = detail::copy_impl(traits::begin(sfirst), traits::end(sfirst), out, local_tag());
+    return detail::copy_impl(traits::begin(slast), traits::local(last), out, local_tag());
+}
+
+template<class InputIterator1, class InputIterator2>
+struct is_memcmp_comparable
+: integral_constant<bool, (
+    std::is_pointer<InputIterator1>::value and
+    std::is_pointer<InputIterator2>::value and
+    std::is_same<
+        typename std::remove_cv<typename std::iterator_traits<InputIterator1>::value_type>::type,
+        typename std::remove_cv<typename std::iterator_traits<InputIterator2>::value_type>::type
+    >::value and
+    is_bitwise_comparable<typename std::remove_cv<typename std::iterator_traits<InputIterator1>::value_type>::type>::value
+)>
+{};
+
+template<class InputIterator1, class InputIterator2>
+bool equal_impl(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, false_type)
+{
+    return std::equal(first1, last1, first2);
+}
+
+template<class T, class U>
+bool equal_impl(T* first1, T* last1, U* first2, true_type)
+{
+    std::size_t n = last1 - first1;
+    return n == 0 or std::memcmp(first1, first2, n * sizeof(T)) == 0;
+}
+
+template<class InputIterator1, class InputIterator2>
+bool equal_impl(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2, true_type)
+{
+    if (last1 - first1 != last2 - first2) return false;
+    return detail::equal_impl(first1, last1, first2, is_memcmp_comparable<InputIterator1, InputIterator2>());
+}
+
+template<class InputIterator1, class InputIterator2>
+bool equal_impl(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2, false_type)
+{
+    for(;first1 != last1 and first2 != last2;++first1, ++first2)
+    {
+        if (!(*first1 == *first2)) return false;
+    }
+    return first1 == last1 and first2 == last2;
+}
+
+}
+
+template<class InputIterator, class UnaryFunction, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+UnaryFunction for_each(InputIterator first, InputIterator last, UnaryFunction f)
+{
+    return detail::for_each_impl(first, last, std::move(f), most_refined<is_segmented_iterator<InputIterator>>());
+}
+
+template<class InputIterator, class OutputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+OutputIterator copy(InputIterator first, InputIterator last, OutputIterator out)
+{
+    return detail::copy_impl(first, last, out, most_refined<is_segmented_iterator<InputIterator>>());
+}
+
+template<class ForwardIterator, class T, TICK_REQUIRES(is_forward_iterator<ForwardIterator>())>
+void fill(ForwardIterator first, ForwardIterator last, const T& x)
+{
+    detail::fill_impl(first, last, x, most_refined<is_segmented_iterator<ForwardIterator>>());
+}
+
+template<class InputIterator, class T, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+InputIterator find(InputIterator first, InputIterator last, const T& x)
+{
+    return detail::find_impl(first, last, x, most_refined<is_segmented_iterator<InputIterator>>());
+}
+
+template<class InputIterator1, class InputIterator2, TICK_REQUIRES(is_input_iterator<InputIterator1>() and is_input_iterator<InputIterator2>())>
+bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    return detail::equal_impl(first1, last1, first2, detail::is_memcmp_comparable<InputIterator1, InputIterator2>());
+}
+
+// The sizes are compared first when that is cheap
+template<class InputIterator1, class InputIterator2, TICK_REQUIRES(is_input_iterator<InputIterator1>() and is_input_iterator<InputIterator2>())>
+bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2)
+{
+    return detail::equal_impl(first1, last1, first2, last2, integral_constant<bool, (
+        is_random_access_iterator<InputIterator1>() and is_random_access_iterator<InputIterator2>()
+    )>());
+}
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    allocate_at_least.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_ALLOCATE_AT_LEAST_H
+#define TICK_GUARD_ALLOCATE_AT_LEAST_H
+
+/// allocate_at_least
+/// =================
+///
+/// Description
+/// -----------
+///
+/// Allocates storage for at least `n` objects. If the allocator satisfies
+/// [`is_size_feedback_allocator`](is_size_feedback_allocator), then its
+/// `allocate_at_least` member is used, so a container can use any extra
+/// room the allocator hands out. Otherwise, this calls `allocate(n)` and
+/// reports `n` objects.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Pointer>
+///     struct allocation_result
+///     {
+///         Pointer ptr;
+///         std::size_t count;
+///     };
+///
+///     template<class Allocator>
+///     allocation_result<typename std::allocator_traits<Allocator>::pointer>
+///     allocate_at_least(Allocator& a, std::size_t n);
+///
+
+#include <tick/traits/is_size_feedback_allocator.h>
+#include <memory>
+
+namespace tick {
+
+template<class Pointer>
+struct allocation_result
+{
+    Pointer ptr;
+    std::size_t count;
+};
+
+namespace detail {
+
+template<class Allocator>
+allocation_result<typename std::allocator_traits<Allocator>::pointer>
+allocate_at_least(Allocator& a, std::size_t n, true_type)
+{
+    auto r = a.allocate_at_least(n);
+    allocation_result<typename std::allocator_traits<Allocator>::pointer> result = { r.ptr, r.count };
+    return result;
+}
+
+template<class Allocator>
+allocation_result<typename std::allocator_traits<Allocator>::pointer>
+allocate_at_least(Allocator& a, std::size_t n, false_type)
+{
+    allocation_result<typename std::allocator_traits<Allocator>::pointer> result = { std::allocator_traits<Allocator>::allocate(a, n), n };
+    return result;
+}
+
+}
+
+template<class Allocator>
+allocation_result<typename std::allocator_traits<Allocator>::pointer>
+allocate_at_least(Allocator& a, std::size_t n)
+{
+    return detail::allocate_at_least(a, n, is_size_feedback_allocator<Allocator>());
+}
+
+}
+
+#endif
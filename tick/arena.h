@@ -0,0 +1,238 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    arena.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_ARENA_H
+#define TICK_GUARD_ARENA_H
+
+/// arena
+/// =====
+///
+/// Description
+/// -----------
+///
+/// An `arena` is a monotonic memory resource. It bump-allocates from large
+/// blocks, deallocation does nothing, and all the memory is given back at
+/// once with `release` or when the arena is destroyed. The `reset` function
+/// rewinds the arena while keeping its blocks, so an arena that is reset
+/// after each unit of work (such as a request) stops allocating from the
+/// system once it has warmed up.
+///
+/// The `arena_allocator<T>` satisfies [`is_allocator`](is_allocator) and
+/// allocates from an `arena`. Two arena allocators are equal when they use
+/// the same arena. The allocator is not propagated on copy assignment, move
+/// assignment or swap, so a container always keeps the memory of its own
+/// arena, and moving between containers that use different arenas moves the
+/// elements instead.
+///
+/// Synopsis
+/// --------
+///
+///     class arena
+///     {
+///     public:
+///         explicit arena(std::size_t block_size=default_block_size);
+///
+///         void* allocate(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t));
+///         void deallocate(void* p, std::size_t bytes) noexcept;
+///
+///         void reset() noexcept;
+///         void release() noexcept;
+///     };
+///
+///     template<class T>
+///     class arena_allocator;
+///
+/// Example
+/// -------
+///
+///     tick::arena a;
+///     {
+///         std::vector<int, tick::arena_allocator<int>> v{tick::arena_allocator<int>(a)};
+///         v.push_back(1);
+///     }
+///     a.reset();
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace tick {
+
+class arena
+{
+    struct block
+    {
+        block* next;
+        std::size_t size;
+
+        unsigned char* begin()
+        {
+            return reinterpret_cast<unsigned char*>(this + 1);
+        }
+
+        unsigned char* end()
+        {
+            return this->begin() + size;
+        }
+    };
+public:
+    static const std::size_t default_block_size = 64 * 1024;
+
+    explicit arena(std::size_t block_size=default_block_size)
+    : head(nullptr), current(nullptr), first(nullptr), last(nullptr), block_size(block_size)
+    {}
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena()
+    {
+        this->release();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t))
+    {
+        void* p = this->bump(bytes, alignment);
+        if (p == nullptr)
+        {
+            this->next_block(bytes + alignment);
+            p = this->bump(bytes, alignment);
+        }
+        return p;
+    }
+
+    void deallocate(void*, std::size_t) noexcept
+    {}
+
+    // Rewinds the arena to its first block, keeping all blocks for reuse
+    void reset() noexcept
+    {
+        current = head;
+        if (current == nullptr) first = last = nullptr;
+        else
+        {
+            first = current->begin();
+            last = current->end();
+        }
+    }
+
+    // Gives all the memory back to the system
+    void release() noexcept
+    {
+        while(head != nullptr)
+        {
+            block* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+        current = nullptr;
+        first = last = nullptr;
+    }
+
+private:
+    block* head;
+    block* current;
+    unsigned char* first;
+    unsigned char* last;
+    std::size_t block_size;
+
+    void* bump(std::size_t bytes, std::size_t alignment)
+    {
+        if (first == nullptr) return nullptr;
+        std::uintptr_t p = reinterpret_cast<std::uintptr_t>(first);
+        std::uintptr_t aligned = (p + alignment - 1) & ~std::uintptr_t(alignment - 1);
+        if (aligned - p > std::size_t(last - first) or bytes > std::size_t(last - first) - (aligned - p)) return nullptr;
+        first = reinterpret_cast<unsigned char*>(aligned) + bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void next_block(std::size_t n)
+    {
+        // Reuse the blocks kept by reset when they are large enough
+        while(current != nullptr and current->next != nullptr)
+        {
+            current = current->next;
+            if (current->size >= n)
+            {
+                first = current->begin();
+                last = current->end();
+                return;
+            }
+        }
+        std::size_t size = n > block_size ? n : block_size;
+        block* b = static_cast<block*>(::operator new(sizeof(block) + size));
+        b->next = nullptr;
+        b->size = size;
+        if (current == nullptr) head = b;
+        else current->next = b;
+        current = b;
+        first = b->begin();
+        last = b->end();
+    }
+};
+
+template<class T>
+class arena_allocator
+{
+    template<class U>
+    friend class arena_allocator;
+public:
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template<class U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    arena_allocator(arena& a) noexcept : resource(&a)
+    {}
+
+    template<class U>
+    arena_allocator(const arena_allocator<U>& rhs) noexcept : resource(rhs.resource)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept
+    {}
+
+    arena& get_arena() const noexcept
+    {
+        return *resource;
+    }
+
+    template<class U>
+    friend bool operator==(const arena_allocator& x, const arena_allocator<U>& y) noexcept
+    {
+        return &x.get_arena() == &y.get_arena();
+    }
+
+    template<class U>
+    friend bool operator!=(const arena_allocator& x, const arena_allocator<U>& y) noexcept
+    {
+        return &x.get_arena() != &y.get_arena();
+    }
+
+private:
+    arena* resource;
+};
+
+}
+
+#endif
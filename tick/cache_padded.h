@@ -0,0 +1,106 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    cache_padded.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_CACHE_PADDED_H
+#define TICK_GUARD_CACHE_PADDED_H
+
+/// cache_padded
+/// ============
+///
+/// Description
+/// -----------
+///
+/// Wraps a value so that it starts on a cache line and nothing else is
+/// stored on the lines it uses. Values that are written by different
+/// threads, such as per thread counters or the two ends of a queue, are
+/// padded so that a write by one thread does not take the cache line away
+/// from the others (false sharing).
+///
+/// The alignment is over the alignment of `std::max_align_t`, so before
+/// C++17 a `cache_padded` allocated with `new` or `std::allocator` is not
+/// guaranteed to be aligned. [`sharded`](sharded) aligns its own storage.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T>
+///     struct cache_padded
+///     {
+///         template<class... Ts>
+///         cache_padded(Ts&&... xs);
+///
+///         T& get();
+///         const T& get() const;
+///         T& operator*();
+///         const T& operator*() const;
+///         T* operator->();
+///         const T* operator->() const;
+///     };
+///
+/// Example
+/// -------
+///
+///     struct stats
+///     {
+///         // Written by the producer
+///         tick::cache_padded<std::atomic<std::size_t>> pushed;
+///         // Written by the consumer
+///         tick::cache_padded<std::atomic<std::size_t>> popped;
+///     };
+///
+
+#include <tick/detail/cache_line.h>
+#include <tick/requires.h>
+#include <type_traits>
+#include <utility>
+
+namespace tick {
+
+template<class T>
+struct alignas(detail::cache_line_size) cache_padded
+{
+    template<class... Ts, TICK_REQUIRES(std::is_constructible<T, Ts&&...>::value)>
+    cache_padded(Ts&&... xs) : value(std::forward<Ts>(xs)...)
+    {}
+
+    T& get()
+    {
+        return value;
+    }
+
+    const T& get() const
+    {
+        return value;
+    }
+
+    T& operator*()
+    {
+        return value;
+    }
+
+    const T& operator*() const
+    {
+        return value;
+    }
+
+    T* operator->()
+    {
+        return &value;
+    }
+
+    const T* operator->() const
+    {
+        return &value;
+    }
+
+private:
+    T value;
+};
+
+}
+
+#endif
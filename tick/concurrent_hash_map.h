@@ -0,0 +1,379 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    concurrent_hash_map.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_CONCURRENT_HASH_MAP_H
+#define TICK_GUARD_CONCURRENT_HASH_MAP_H
+
+/// concurrent_hash_map
+/// ===================
+///
+/// Description
+/// -----------
+///
+/// A hash map with unique keys that any number of threads can use at the
+/// same time. It is split into shards, each a
+/// [`flat_hash_map`](flat_hash_map) guarded by its own
+/// [`adaptive_mutex`](adaptive_mutex) on its own cache line, and a key
+/// always goes to the shard picked by the high bits of its hash. So
+/// threads only contend when they use the same shard, and with several
+/// shards per hardware thread (the default) that is rare. A shard is
+/// locked for a single lookup or update, which is too short for a reader
+/// writer lock to pay off: taking a shared lock writes to the lock's cache
+/// line just the same.
+///
+/// No references to the elements are handed out, since another thread may
+/// erase or move them at any time. Instead `find` copies the mapped value
+/// out, and `visit` calls a function on the element while its shard is
+/// locked. The function must not use the map, or it deadlocks.
+///
+/// `for_each` visits all the elements one shard at a time, and
+/// `parallel_for_each` splits the shards between several threads. Neither
+/// sees a single point in time across shards. `snapshot` copies the map
+/// into a `flat_hash_map`, which satisfies
+/// [`is_unordered_associative_container`](is_unordered_associative_container)
+/// and [`is_range`](is_range), so the usual algorithms can be used on it.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Key, class T, class Hash=std::hash<Key>, class KeyEqual=std::equal_to<Key>,
+///         class Allocator=std::allocator<std::pair<const Key, T>>>
+///     class concurrent_hash_map
+///     {
+///     public:
+///         typedef flat_hash_map<Key, T, Hash, KeyEqual, Allocator> snapshot_type;
+///
+///         concurrent_hash_map();
+///         explicit concurrent_hash_map(size_type shards, const Hash& h=Hash(), const KeyEqual& eq=KeyEqual(), const Allocator& a=Allocator());
+///
+///         bool find(const key_type& k, mapped_type& x) const;
+///         bool contains(const key_type& k) const;
+///         template<class F>
+///         bool visit(const key_type& k, F f);
+///         template<class F>
+///         bool visit(const key_type& k, F f) const;
+///
+///         template<class... Ts>
+///         bool try_emplace(const key_type& k, Ts&&... xs);
+///         template<class M>
+///         bool insert_or_assign(const key_type& k, M&& x);
+///         size_type erase(const key_type& k);
+///         void clear();
+///
+///         template<class F>
+///         void for_each(F f);
+///         template<class F>
+///         void parallel_for_each(F f, std::size_t threads=std::thread::hardware_concurrency());
+///         snapshot_type snapshot() const;
+///
+///         size_type size() const;
+///         bool empty() const;
+///         size_type shards() const;
+///     };
+///
+/// Example
+/// -------
+///
+///     tick::concurrent_hash_map<std::string, session> sessions;
+///     // On any thread
+///     sessions.insert_or_assign(id, session(user));
+///     sessions.visit(id, [&](std::pair<const std::string, session>& p) { p.second.touch(now); });
+///     // On a background thread
+///     sessions.parallel_for_each([&](std::pair<const std::string, session>& p)
+///     {
+///         if (p.second.expired(now)) expired.push(p.first);
+///     }, 4);
+///
+
+#include <tick/adaptive_mutex.h>
+#include <tick/cache_padded.h>
+#include <tick/detail/cache_line.h>
+#include <tick/detail/hash_group.h>
+#include <tick/detail/ring_buffer.h>
+#include <tick/flat_hash_map.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tick {
+
+template<class Key, class T, class Hash=std::hash<Key>, class KeyEqual=std::equal_to<Key>,
+    class Allocator=std::allocator<std::pair<const Key, T>>>
+class concurrent_hash_map
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef std::size_t size_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef Allocator allocator_type;
+    typedef flat_hash_map<Key, T, Hash, KeyEqual, Allocator> snapshot_type;
+private:
+    struct shard
+    {
+        shard(const Hash& h, const KeyEqual& eq, const Allocator& a) : map(0, h, eq, a)
+        {}
+        mutable adaptive_mutex m;
+        snapshot_type map;
+    };
+    typedef cache_padded<shard> shard_type;
+    typedef std::lock_guard<adaptive_mutex> lock_type;
+public:
+    concurrent_hash_map() : concurrent_hash_map(concurrent_hash_map::default_shards())
+    {}
+
+    explicit concurrent_hash_map(size_type shards, const Hash& h=Hash(), const KeyEqual& eq=KeyEqual(), const Allocator& a=Allocator())
+    : m(h, detail::ring_capacity(shards, "concurrent_hash_map"), h, eq, a)
+    {}
+
+    concurrent_hash_map(const concurrent_hash_map&) = delete;
+    concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+    // Copies the mapped value of `k` into `x`, and returns whether it was
+    // found
+    bool find(const key_type& k, mapped_type& x) const
+    {
+        const shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        typename snapshot_type::const_iterator it = s.map.find(k);
+        if (it == s.map.end()) return false;
+        x = it->second;
+        return true;
+    }
+
+    bool contains(const key_type& k) const
+    {
+        const shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        return s.map.contains(k);
+    }
+
+    // Calls `f` with the element of `k` while it is locked, and returns
+    // whether it was found
+    template<class F>
+    bool visit(const key_type& k, F f)
+    {
+        shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        typename snapshot_type::iterator it = s.map.find(k);
+        if (it == s.map.end()) return false;
+        f(*it);
+        return true;
+    }
+
+    template<class F>
+    bool visit(const key_type& k, F f) const
+    {
+        const shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        typename snapshot_type::const_iterator it = s.map.find(k);
+        if (it == s.map.end()) return false;
+        f(*it);
+        return true;
+    }
+
+    // Returns whether the element was inserted
+    template<class... Ts>
+    bool try_emplace(const key_type& k, Ts&&... xs)
+    {
+        shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        return s.map.try_emplace(k, std::forward<Ts>(xs)...).second;
+    }
+
+    template<class... Ts>
+    bool try_emplace(key_type&& k, Ts&&... xs)
+    {
+        shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        return s.map.try_emplace(std::move(k), std::forward<Ts>(xs)...).second;
+    }
+
+    // Returns whether the element was inserted rather than assigned
+    template<class M>
+    bool insert_or_assign(const key_type& k, M&& x)
+    {
+        shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        return s.map.insert_or_assign(k, std::forward<M>(x)).second;
+    }
+
+    template<class M>
+    bool insert_or_assign(key_type&& k, M&& x)
+    {
+        shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        return s.map.insert_or_assign(std::move(k), std::forward<M>(x)).second;
+    }
+
+    size_type erase(const key_type& k)
+    {
+        shard& s = this->shard_of(k);
+        lock_type lock(s.m);
+        return s.map.erase(k);
+    }
+
+    void clear()
+    {
+        for(size_type i=0;i<=m.mask;i++)
+        {
+            lock_type lock(m.shards[i]->m);
+            m.shards[i]->map.clear();
+        }
+    }
+
+    // Calls `f` on every element, locking one shard at a time
+    template<class F>
+    void for_each(F f)
+    {
+        for(size_type i=0;i<=m.mask;i++) this->for_each_in(i, f);
+    }
+
+    template<class F>
+    void for_each(F f) const
+    {
+        for(size_type i=0;i<=m.mask;i++) this->for_each_in(i, f);
+    }
+
+    // Like `for_each`, but the shards are split between `threads` threads,
+    // including the calling one, so `f` is called from several threads at
+    // once
+    template<class F>
+    void parallel_for_each(F f, std::size_t threads=std::thread::hardware_concurrency())
+    {
+        threads = std::max<std::size_t>(1, std::min<std::size_t>(threads, m.mask + 1));
+        std::atomic<size_type> next(0);
+        auto work = [this, &f, &next]
+        {
+            for(size_type i = next.fetch_add(1, std::memory_order_relaxed);i <= m.mask;i = next.fetch_add(1, std::memory_order_relaxed))
+                this->for_each_in(i, f);
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        try
+        {
+            for(std::size_t i=1;i<threads;i++) workers.emplace_back(work);
+            work();
+        }
+        catch(...)
+        {
+            for(std::thread& t:workers) t.join();
+            throw;
+        }
+        for(std::thread& t:workers) t.join();
+    }
+
+    // A copy of the elements, taken one shard at a time
+    snapshot_type snapshot() const
+    {
+        snapshot_type result(0, m.shards[0]->map.hash_function(), m.shards[0]->map.key_eq(), m.shards[0]->map.get_allocator());
+        result.reserve(this->size());
+        this->for_each([&result](const value_type& x)
+        {
+            result.insert(x);
+        });
+        return result;
+    }
+
+    // Only a snapshot, since other threads may insert or erase at any time
+    size_type size() const
+    {
+        size_type n = 0;
+        for(size_type i=0;i<=m.mask;i++)
+        {
+            lock_type lock(m.shards[i]->m);
+            n += m.shards[i]->map.size();
+        }
+        return n;
+    }
+
+    bool empty() const
+    {
+        return this->size() == 0;
+    }
+
+    size_type shards() const
+    {
+        return m.mask + 1;
+    }
+
+    hasher hash_function() const
+    {
+        return m;
+    }
+
+private:
+    struct impl : Hash
+    {
+        impl(const Hash& h, size_type n, const Hash& sh, const KeyEqual& eq, const Allocator& a)
+        : Hash(h), shards(n, sh, eq, a), mask(n - 1), shift(std::numeric_limits<std::size_t>::digits - concurrent_hash_map::log2(n))
+        {}
+        detail::cache_aligned_array<shard_type> shards;
+        size_type mask;
+        int shift;
+    };
+    impl m;
+
+    static int log2(size_type n)
+    {
+        int r = 0;
+        while((size_type(1) << r) < n) r++;
+        return r;
+    }
+
+    static size_type default_shards()
+    {
+        size_type n = std::thread::hardware_concurrency();
+        return 4 * (n == 0 ? 1 : n);
+    }
+
+    // The shard is picked by the high bits of the hash, since the shard's
+    // table picks a group by the low bits
+    size_type shard_index(const key_type& k) const
+    {
+        if (m.mask == 0) return 0;
+        const Hash& h = m;
+        return detail::hash_mix(h(k)) >> m.shift;
+    }
+
+    shard& shard_of(const key_type& k)
+    {
+        return *m.shards[this->shard_index(k)];
+    }
+
+    const shard& shard_of(const key_type& k) const
+    {
+        return *m.shards[this->shard_index(k)];
+    }
+
+    template<class F>
+    void for_each_in(size_type i, F& f)
+    {
+        lock_type lock(m.shards[i]->m);
+        for(value_type& x:m.shards[i]->map) f(x);
+    }
+
+    template<class F>
+    void for_each_in(size_type i, F& f) const
+    {
+        lock_type lock(m.shards[i]->m);
+        for(const value_type& x:m.shards[i]->map) f(x);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    default_init_allocator.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DEFAULT_INIT_ALLOCATOR_H
+#define TICK_GUARD_DEFAULT_INIT_ALLOCATOR_H
+
+/// default_init_allocator
+/// ======================
+///
+/// Description
+/// -----------
+///
+/// A `default_init_allocator` adapts an allocator so that constructing an
+/// element with no arguments default-initializes it when the element type
+/// satisfies [`is_trivial`](is_trivial). Containers value-initialize the
+/// elements added by `resize(n)` or the `vector(n)` constructor, which for
+/// trivial types means zeroing them. With this allocator the memory is left
+/// as it is, which saves a pass over a buffer that is about to be
+/// overwritten anyway, such as by a `read()`.
+///
+/// Every other construction goes through the adapted allocator. The adaptor
+/// satisfies [`is_allocator`](is_allocator), propagates like the adapted
+/// allocator, and two adaptors are equal when the adapted allocators are.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Allocator>
+///     class default_init_allocator;
+///
+/// Example
+/// -------
+///
+///     std::vector<char, tick::default_init_allocator<std::allocator<char>>> buffer;
+///     // The new elements are not zeroed
+///     buffer.resize(n);
+///     std::size_t r = read(fd, buffer.data(), n);
+///
+
+#include <tick/integral_constant.h>
+#include <tick/traits/is_trivial.h>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace tick {
+
+template<class Allocator>
+class default_init_allocator
+: public Allocator
+{
+    typedef std::allocator_traits<Allocator> alloc_traits;
+public:
+    typedef Allocator allocator_type;
+
+    template<class U>
+    struct rebind
+    {
+        typedef default_init_allocator<typename alloc_traits::template rebind_alloc<U>> other;
+    };
+
+    default_init_allocator()
+    {}
+
+    default_init_allocator(const Allocator& a) noexcept : Allocator(a)
+    {}
+
+    template<class A>
+    default_init_allocator(const default_init_allocator<A>& rhs) noexcept : Allocator(rhs.base())
+    {}
+
+    const Allocator& base() const noexcept
+    {
+        return *this;
+    }
+
+    Allocator& base() noexcept
+    {
+        return *this;
+    }
+
+    template<class U, class... Ts>
+    auto construct(U* p, Ts&&... xs) -> decltype(alloc_traits::construct(std::declval<Allocator&>(), p, std::forward<Ts>(xs)...))
+    {
+        this->construct_impl(p, integral_constant<bool, (sizeof...(Ts) == 0 and is_trivial<U>())>(), std::forward<Ts>(xs)...);
+    }
+
+    template<class U>
+    void destroy(U* p)
+    {
+        alloc_traits::destroy(this->base(), p);
+    }
+
+    default_init_allocator select_on_container_copy_construction() const
+    {
+        return alloc_traits::select_on_container_copy_construction(this->base());
+    }
+
+    template<class A>
+    friend bool operator==(const default_init_allocator& x, const default_init_allocator<A>& y) noexcept
+    {
+        return x.base() == y.base();
+    }
+
+    template<class A>
+    friend bool operator!=(const default_init_allocator& x, const default_init_allocator<A>& y) noexcept
+    {
+        return !(x.base() == y.base());
+    }
+
+private:
+    template<class U>
+    void construct_impl(U* p, true_type)
+    {
+        ::new(static_cast<void*>(p)) U;
+    }
+
+    template<class U, class... Ts>
+    void construct_impl(U* p, false_type, Ts&&... xs)
+    {
+        alloc_traits::construct(this->base(), p, std::forward<Ts>(xs)...);
+    }
+};
+
+}
+
+#endif
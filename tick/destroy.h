@@ -0,0 +1,169 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    destroy.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DESTROY_H
+#define TICK_GUARD_DESTROY_H
+
+/// destroy
+/// =======
+///
+/// Description
+/// -----------
+///
+/// Destroys the objects in a range, leaving the storage uninitialized. When
+/// the value type satisfies
+/// [`is_trivially_destructible`](is_trivially_destructible), there is
+/// nothing to do, so the range is not traversed at all. This does not rely
+/// on the optimizer removing an empty loop, so it also holds in debug
+/// builds.
+///
+/// The overload that takes an allocator destroys each object with
+/// `std::allocator_traits<Allocator>::destroy`, which is what a container
+/// does on `clear`. It skips the loop as well when the value type is
+/// trivially destructible and the allocator does not customize `destroy`
+/// (`std::allocator` is known not to).
+///
+/// `destroy_n` returns an iterator past the last destroyed object, which
+/// still requires advancing the iterator when it is not random access.
+///
+/// Only [`is_iterator`](is_iterator) is checked, since the value type of a
+/// forward iterator has to be copyable and move-only elements need to be
+/// destroyed as well.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T>
+///     void destroy_at(T* p);
+///
+///     template<class ForwardIterator>
+///     void destroy(ForwardIterator first, ForwardIterator last);
+///
+///     template<class ForwardIterator, class Size>
+///     ForwardIterator destroy_n(ForwardIterator first, Size n);
+///
+///     template<class Allocator, class ForwardIterator>
+///     void destroy(Allocator& a, ForwardIterator first, ForwardIterator last);
+///
+/// Example
+/// -------
+///
+///     std::string* first = ...;
+///     tick::destroy(first, first + n);
+///     // Nothing is run for trivial types
+///     int* data = ...;
+///     tick::destroy(data, data + n);
+///
+
+#include <tick/builder.h>
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_iterator.h>
+#include <tick/traits/is_trivially_destructible.h>
+#include <iterator>
+#include <memory>
+
+namespace tick {
+
+template<class T>
+void destroy_at(T* p)
+{
+    p->~T();
+}
+
+namespace detail {
+
+template<class Iterator>
+struct is_trivially_destructible_range
+: is_trivially_destructible<typename std::iterator_traits<Iterator>::value_type>
+{};
+
+TICK_TRAIT(has_allocator_destroy)
+{
+    template<class Allocator, class Pointer>
+    auto require(Allocator&& a, Pointer&& p) -> valid<
+        decltype(as_mutable(a).destroy(p))
+    >;
+};
+
+template<class Allocator>
+struct is_std_allocator
+: false_type
+{};
+
+template<class T>
+struct is_std_allocator<std::allocator<T>>
+: true_type
+{};
+
+// Whether `allocator_traits<Allocator>::destroy` does nothing for a `T`
+template<class Allocator, class T>
+struct is_trivially_destroying_allocator
+: integral_constant<bool, (
+    is_trivially_destructible<T>() and
+    (is_std_allocator<Allocator>() or not has_allocator_destroy<Allocator, T*>())
+)>
+{};
+
+template<class Iterator>
+void destroy(Iterator first, Iterator last, false_type)
+{
+    for(;first != last; ++first) tick::destroy_at(std::addressof(*first));
+}
+
+template<class Iterator>
+void destroy(Iterator, Iterator, true_type)
+{}
+
+template<class Iterator, class Size>
+Iterator destroy_n(Iterator first, Size n, false_type)
+{
+    for(;n > 0; ++first, --n) tick::destroy_at(std::addressof(*first));
+    return first;
+}
+
+template<class Iterator, class Size>
+Iterator destroy_n(Iterator first, Size n, true_type)
+{
+    std::advance(first, n);
+    return first;
+}
+
+template<class Allocator, class Iterator>
+void destroy(Allocator& a, Iterator first, Iterator last, false_type)
+{
+    for(;first != last; ++first) std::allocator_traits<Allocator>::destroy(a, std::addressof(*first));
+}
+
+template<class Allocator, class Iterator>
+void destroy(Allocator&, Iterator, Iterator, true_type)
+{}
+
+}
+
+template<class ForwardIterator, TICK_REQUIRES(is_iterator<ForwardIterator>())>
+void destroy(ForwardIterator first, ForwardIterator last)
+{
+    detail::destroy(first, last, detail::is_trivially_destructible_range<ForwardIterator>());
+}
+
+template<class ForwardIterator, class Size, TICK_REQUIRES(is_iterator<ForwardIterator>())>
+ForwardIterator destroy_n(ForwardIterator first, Size n)
+{
+    return detail::destroy_n(first, n, detail::is_trivially_destructible_range<ForwardIterator>());
+}
+
+template<class Allocator, class ForwardIterator, TICK_REQUIRES(is_iterator<ForwardIterator>())>
+void destroy(Allocator& a, ForwardIterator first, ForwardIterator last)
+{
+    typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+    detail::destroy(a, first, last, detail::is_trivially_destroying_allocator<Allocator, value_type>());
+}
+
+}
+
+#endif
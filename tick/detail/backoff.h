@@ -0,0 +1,67 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    backoff.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DETAIL_BACKOFF_H
+#define TICK_GUARD_DETAIL_BACKOFF_H
+
+#include <thread>
+
+namespace tick {
+
+namespace detail {
+
+// Tells the processor that this is a spin loop, which saves power and lets
+// the other hyperthread of the core run
+inline void cpu_relax()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Spinning only helps when the thread holding the lock can run at the same
+// time
+inline bool is_spinning_useful()
+{
+    static const bool result = std::thread::hardware_concurrency() != 1;
+    return result;
+}
+
+// Exponential backoff for spin loops: each call spins twice as long as the
+// one before, so contending threads fall out of step instead of retrying
+// at the same time. `spin` returns false once the limit is reached, when
+// the caller should block instead.
+template<unsigned Limit = 128>
+struct backoff
+{
+    unsigned n;
+
+    backoff() : n(1)
+    {}
+
+    bool spin()
+    {
+        if (n > Limit) return false;
+        for(unsigned i=0;i<n;i++) detail::cpu_relax();
+        n *= 2;
+        return true;
+    }
+
+    // Spins up to the limit, then gives up the time slice
+    void pause()
+    {
+        if (!this->spin()) std::this_thread::yield();
+    }
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    cache_line.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DETAIL_CACHE_LINE_H
+#define TICK_GUARD_DETAIL_CACHE_LINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace tick {
+
+namespace detail {
+
+// Data written by different threads is kept this far apart, so that the
+// threads do not take the cache line from each other (false sharing). This
+// is the line size of current x86 and ARM processors, which is also what
+// `std::hardware_destructive_interference_size` is on most of them. It is a
+// constant here since that one changes with compiler flags.
+static const std::size_t cache_line_size = 64;
+
+// A fixed size array of elements that start on a cache line. It is
+// allocated by hand, since `new` only aligns to a cache line from C++17 on.
+// Each element is constructed from the same arguments.
+template<class T>
+class cache_aligned_array
+{
+    unsigned char* memory;
+    T* first;
+    std::size_t n;
+
+    void destroy()
+    {
+        while(n > 0) first[--n].~T();
+        delete[] memory;
+    }
+public:
+    template<class... Ts>
+    explicit cache_aligned_array(std::size_t count, const Ts&... xs)
+    : memory(new unsigned char[count * sizeof(T) + alignof(T) - 1]), first(nullptr), n(0)
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory);
+        first = reinterpret_cast<T*>((address + alignof(T) - 1) & ~std::uintptr_t(alignof(T) - 1));
+        try
+        {
+            for(;n < count;n++) ::new(static_cast<void*>(first + n)) T(xs...);
+        }
+        catch(...)
+        {
+            this->destroy();
+            throw;
+        }
+    }
+
+    cache_aligned_array(const cache_aligned_array&) = delete;
+    cache_aligned_array& operator=(const cache_aligned_array&) = delete;
+
+    ~cache_aligned_array()
+    {
+        this->destroy();
+    }
+
+    T& operator[](std::size_t i)
+    {
+        return first[i];
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        return first[i];
+    }
+
+    std::size_t size() const
+    {
+        return n;
+    }
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    coroutine.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DETAIL_COROUTINE_H
+#define TICK_GUARD_DETAIL_COROUTINE_H
+
+#ifndef TICK_HAS_COROUTINES
+#   if defined(__cpp_impl_coroutine) && defined(__has_include)
+#       if __has_include(<coroutine>)
+#           define TICK_HAS_COROUTINES 1
+#       else
+#           define TICK_HAS_COROUTINES 0
+#       endif
+#   else
+#       define TICK_HAS_COROUTINES 0
+#   endif
+#endif
+
+#if TICK_HAS_COROUTINES
+#include <coroutine>
+#endif
+
+#endif
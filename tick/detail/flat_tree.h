@@ -0,0 +1,473 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    flat_tree.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DETAIL_FLAT_TREE_H
+#define TICK_GUARD_DETAIL_FLAT_TREE_H
+
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_input_iterator.h>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace tick {
+
+struct sorted_unique_t {};
+const sorted_unique_t sorted_unique = sorted_unique_t();
+
+namespace detail {
+
+// Below this many elements, the search counts the elements instead of
+// halving the range. For arithmetic keys the count has no branches and no
+// dependency between iterations, so it is vectorized.
+static const std::size_t flat_linear_search_size = 16;
+
+// Finds the first element of `[first, first + n)` for which `pred` is false,
+// where `pred` is true for a prefix of the range. Each step picks the next
+// half with a conditional move rather than a branch.
+template<class Iterator, class Predicate>
+Iterator flat_partition_point(Iterator first, std::size_t n, Predicate pred, false_type)
+{
+    while(n > 1)
+    {
+        std::size_t half = n / 2;
+        first += pred(first[half]) ? half : 0;
+        n -= half;
+    }
+    return first + ((n == 1 and pred(*first)) ? 1 : 0);
+}
+
+template<class Iterator, class Predicate>
+Iterator flat_partition_point(Iterator first, std::size_t n, Predicate pred, true_type)
+{
+    while(n > flat_linear_search_size)
+    {
+        std::size_t half = n / 2;
+        first += pred(first[half]) ? half : 0;
+        n -= half;
+    }
+    std::size_t count = 0;
+    for(std::size_t i=0;i<n;i++) count += pred(first[i]) ? 1 : 0;
+    return first + count;
+}
+
+struct flat_identity
+{
+    template<class T>
+    const T& operator()(const T& x) const
+    {
+        return x;
+    }
+};
+
+struct flat_select_first
+{
+    template<class Pair>
+    const typename Pair::first_type& operator()(const Pair& p) const
+    {
+        return p.first;
+    }
+};
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool MutableIterator>
+class flat_tree
+{
+    typedef std::vector<Value, Allocator> container_type;
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef Compare key_compare;
+    typedef Allocator allocator_type;
+    typedef typename container_type::size_type size_type;
+    typedef typename container_type::difference_type difference_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef typename container_type::pointer pointer;
+    typedef typename container_type::const_pointer const_pointer;
+    typedef typename container_type::const_iterator const_iterator;
+    typedef typename std::conditional<MutableIterator,
+        typename container_type::iterator,
+        const_iterator
+    >::type iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    class value_compare
+    {
+        friend class flat_tree;
+    protected:
+        Compare comp;
+        value_compare(const Compare& c) : comp(c)
+        {}
+    public:
+        bool operator()(const value_type& x, const value_type& y) const
+        {
+            return comp(KeyOfValue()(x), KeyOfValue()(y));
+        }
+    };
+
+    flat_tree()
+    {}
+
+    explicit flat_tree(const Compare& c, const Allocator& a=Allocator()) : m(c, a)
+    {}
+
+    explicit flat_tree(const Allocator& a) : m(Compare(), a)
+    {}
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    flat_tree(InputIterator first, InputIterator last, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : m(c, a)
+    {
+        this->insert(first, last);
+    }
+
+    // Constructs from a range that is already sorted and unique in linear time
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    flat_tree(sorted_unique_t, InputIterator first, InputIterator last, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : m(c, a)
+    {
+        m.data.assign(first, last);
+    }
+
+    flat_tree(std::initializer_list<value_type> il, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : flat_tree(il.begin(), il.end(), c, a)
+    {}
+
+    flat_tree(sorted_unique_t s, std::initializer_list<value_type> il, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : flat_tree(s, il.begin(), il.end(), c, a)
+    {}
+
+    flat_tree& operator=(std::initializer_list<value_type> il)
+    {
+        this->clear();
+        this->insert(il.begin(), il.end());
+        return *this;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return m.data.get_allocator();
+    }
+
+    iterator begin() { return m.data.begin(); }
+    const_iterator begin() const { return m.data.begin(); }
+    const_iterator cbegin() const { return m.data.begin(); }
+
+    iterator end() { return m.data.end(); }
+    const_iterator end() const { return m.data.end(); }
+    const_iterator cend() const { return m.data.end(); }
+
+    reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(this->end()); }
+
+    reverse_iterator rend() { return reverse_iterator(this->begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(this->begin()); }
+
+    bool empty() const
+    {
+        return m.data.empty();
+    }
+
+    size_type size() const
+    {
+        return m.data.size();
+    }
+
+    size_type max_size() const
+    {
+        return m.data.max_size();
+    }
+
+    size_type capacity() const
+    {
+        return m.data.capacity();
+    }
+
+    void reserve(size_type n)
+    {
+        m.data.reserve(n);
+    }
+
+    void shrink_to_fit()
+    {
+        m.data.shrink_to_fit();
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x)
+    {
+        return this->insert_unique(x);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& x)
+    {
+        return this->insert_unique(std::move(x));
+    }
+
+    iterator insert(const_iterator hint, const value_type& x)
+    {
+        return this->insert_hint(hint, x);
+    }
+
+    iterator insert(const_iterator hint, value_type&& x)
+    {
+        return this->insert_hint(hint, std::move(x));
+    }
+
+    // Appends the range, sorts it, and then merges it in. Elements with a
+    // key that is already present are dropped.
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    void insert(InputIterator first, InputIterator last)
+    {
+        size_type n = this->size();
+        m.data.insert(m.data.end(), first, last);
+        auto middle = m.data.begin() + n;
+        std::stable_sort(middle, m.data.end(), this->value_comp());
+        std::inplace_merge(m.data.begin(), middle, m.data.end(), this->value_comp());
+        this->remove_duplicates();
+    }
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last)
+    {
+        size_type n = this->size();
+        m.data.insert(m.data.end(), first, last);
+        std::inplace_merge(m.data.begin(), m.data.begin() + n, m.data.end(), this->value_comp());
+        this->remove_duplicates();
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        this->insert(il.begin(), il.end());
+    }
+
+    template<class... Ts>
+    std::pair<iterator, bool> emplace(Ts&&... xs)
+    {
+        return this->insert_unique(value_type(std::forward<Ts>(xs)...));
+    }
+
+    template<class... Ts>
+    iterator emplace_hint(const_iterator hint, Ts&&... xs)
+    {
+        return this->insert_hint(hint, value_type(std::forward<Ts>(xs)...));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return m.data.erase(pos);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return m.data.erase(first, last);
+    }
+
+    size_type erase(const key_type& k)
+    {
+        auto r = this->equal_range(k);
+        size_type n = std::distance(r.first, r.second);
+        this->erase(r.first, r.second);
+        return n;
+    }
+
+    void swap(flat_tree& rhs)
+    {
+        using std::swap;
+        swap(m.comp(), rhs.m.comp());
+        m.data.swap(rhs.m.data);
+    }
+
+    void clear()
+    {
+        m.data.clear();
+    }
+
+    iterator find(const key_type& k)
+    {
+        iterator it = this->lower_bound(k);
+        return (it == this->end() or m.comp()(k, KeyOfValue()(*it))) ? this->end() : it;
+    }
+
+    const_iterator find(const key_type& k) const
+    {
+        const_iterator it = this->lower_bound(k);
+        return (it == this->end() or m.comp()(k, KeyOfValue()(*it))) ? this->end() : it;
+    }
+
+    size_type count(const key_type& k) const
+    {
+        return this->find(k) == this->end() ? 0 : 1;
+    }
+
+    bool contains(const key_type& k) const
+    {
+        return this->find(k) != this->end();
+    }
+
+    iterator lower_bound(const key_type& k)
+    {
+        return this->begin() + (this->lower_bound_impl(k) - m.data.data());
+    }
+
+    const_iterator lower_bound(const key_type& k) const
+    {
+        return this->begin() + (this->lower_bound_impl(k) - m.data.data());
+    }
+
+    iterator upper_bound(const key_type& k)
+    {
+        return this->begin() + (this->upper_bound_impl(k) - m.data.data());
+    }
+
+    const_iterator upper_bound(const key_type& k) const
+    {
+        return this->begin() + (this->upper_bound_impl(k) - m.data.data());
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& k)
+    {
+        iterator it = this->lower_bound(k);
+        if (it == this->end() or m.comp()(k, KeyOfValue()(*it))) return std::make_pair(it, it);
+        return std::make_pair(it, std::next(it));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+    {
+        const_iterator it = this->lower_bound(k);
+        if (it == this->end() or m.comp()(k, KeyOfValue()(*it))) return std::make_pair(it, it);
+        return std::make_pair(it, std::next(it));
+    }
+
+    key_compare key_comp() const
+    {
+        return m.comp();
+    }
+
+    value_compare value_comp() const
+    {
+        return value_compare(m.comp());
+    }
+
+    friend bool operator==(const flat_tree& x, const flat_tree& y)
+    {
+        return x.m.data == y.m.data;
+    }
+
+    friend bool operator!=(const flat_tree& x, const flat_tree& y)
+    {
+        return x.m.data != y.m.data;
+    }
+
+    friend bool operator<(const flat_tree& x, const flat_tree& y)
+    {
+        return x.m.data < y.m.data;
+    }
+
+    friend bool operator>(const flat_tree& x, const flat_tree& y)
+    {
+        return x.m.data > y.m.data;
+    }
+
+    friend bool operator<=(const flat_tree& x, const flat_tree& y)
+    {
+        return x.m.data <= y.m.data;
+    }
+
+    friend bool operator>=(const flat_tree& x, const flat_tree& y)
+    {
+        return x.m.data >= y.m.data;
+    }
+
+protected:
+    template<class T>
+    std::pair<iterator, bool> insert_unique(T&& x)
+    {
+        iterator it = this->lower_bound(KeyOfValue()(x));
+        if (it != this->end() and !m.comp()(KeyOfValue()(x), KeyOfValue()(*it))) return std::make_pair(it, false);
+        return std::make_pair(iterator(m.data.insert(it, std::forward<T>(x))), true);
+    }
+
+    template<class T>
+    iterator insert_hint(const_iterator hint, T&& x)
+    {
+        const value_compare vc = this->value_comp();
+        if ((hint == this->cend() or vc(x, *hint)) and (hint == this->cbegin() or vc(*std::prev(hint), x)))
+            return m.data.insert(hint, std::forward<T>(x));
+        return this->insert_unique(std::forward<T>(x)).first;
+    }
+
+private:
+    struct impl : Compare
+    {
+        impl()
+        {}
+        impl(const Compare& c, const Allocator& a) : Compare(c), data(a)
+        {}
+        Compare& comp() { return *this; }
+        const Compare& comp() const { return *this; }
+        container_type data;
+    };
+    impl m;
+
+    typedef integral_constant<bool, std::is_arithmetic<key_type>::value> linear_search_tail;
+
+    struct less_than_key
+    {
+        const Compare& comp;
+        const key_type& key;
+        bool operator()(const value_type& x) const
+        {
+            return comp(KeyOfValue()(x), key);
+        }
+    };
+
+    struct not_greater_than_key
+    {
+        const Compare& comp;
+        const key_type& key;
+        bool operator()(const value_type& x) const
+        {
+            return !comp(key, KeyOfValue()(x));
+        }
+    };
+
+    const value_type* lower_bound_impl(const key_type& k) const
+    {
+        less_than_key pred = { m.comp(), k };
+        return detail::flat_partition_point(m.data.data(), m.data.size(), pred, linear_search_tail());
+    }
+
+    const value_type* upper_bound_impl(const key_type& k) const
+    {
+        not_greater_than_key pred = { m.comp(), k };
+        return detail::flat_partition_point(m.data.data(), m.data.size(), pred, linear_search_tail());
+    }
+
+    // Keeps the first of each run of equivalent elements, in a sorted range
+    void remove_duplicates()
+    {
+        const value_compare vc = this->value_comp();
+        m.data.erase(std::unique(m.data.begin(), m.data.end(), [&](const value_type& x, const value_type& y)
+        {
+            return !vc(x, y);
+        }), m.data.end());
+    }
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,275 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    hash_group.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DETAIL_HASH_GROUP_H
+#define TICK_GUARD_DETAIL_HASH_GROUP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TICK_HASH_GROUP_SSE2 1
+#include <emmintrin.h>
+#else
+#define TICK_HASH_GROUP_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace tick { namespace detail {
+
+// Each slot of an open addressing table has a control byte. A full slot
+// stores the low 7 bits of the hash of its key, so the sign bit is only set
+// for the special values below.
+typedef signed char hash_ctrl;
+
+static const hash_ctrl hash_ctrl_empty = -128;
+static const hash_ctrl hash_ctrl_deleted = -2;
+static const hash_ctrl hash_ctrl_sentinel = -1;
+
+inline bool hash_ctrl_is_full(hash_ctrl c)
+{
+    return c >= 0;
+}
+
+inline bool hash_ctrl_is_empty_or_deleted(hash_ctrl c)
+{
+    return c < hash_ctrl_sentinel;
+}
+
+inline int hash_count_trailing_zeros(std::uint64_t x)
+{
+#ifdef _MSC_VER
+    unsigned long r;
+    _BitScanForward64(&r, x);
+    return int(r);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+inline int hash_count_leading_zeros(std::uint64_t x)
+{
+#ifdef _MSC_VER
+    unsigned long r;
+    _BitScanReverse64(&r, x);
+    return 63 - int(r);
+#else
+    return __builtin_clzll(x);
+#endif
+}
+
+// Mixes the bits of a hash, since many hash functions (such as `std::hash`
+// for integers) are the identity. The table uses the low 7 bits for the
+// control byte and the bits above them, masked by the capacity, to pick a
+// group, which leaves the top bits free for picking a shard.
+inline std::size_t hash_mix(std::size_t h) noexcept
+{
+    std::uint64_t x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return std::size_t(x);
+}
+
+// The position of the slot group to probe first
+inline std::size_t hash_h1(std::size_t h) noexcept
+{
+    return h >> 7;
+}
+
+// The control byte stored for a full slot
+inline hash_ctrl hash_h2(std::size_t h) noexcept
+{
+    return hash_ctrl(h & 0x7f);
+}
+
+// A set of slot positions within a group, with `Shift` bits per position
+template<int Shift>
+class hash_bitmask
+{
+public:
+    explicit hash_bitmask(std::uint64_t mask) : mask(mask)
+    {}
+
+    explicit operator bool() const
+    {
+        return mask != 0;
+    }
+
+    // The number of positions before the first set position
+    int trailing_zeros() const
+    {
+        return detail::hash_count_trailing_zeros(mask) >> Shift;
+    }
+
+    // The number of positions after the last set position, for a group of
+    // `Width` positions
+    template<int Width>
+    int leading_zeros() const
+    {
+        return (detail::hash_count_leading_zeros(mask) - (64 - (Width << Shift))) >> Shift;
+    }
+
+    hash_bitmask& operator++()
+    {
+        mask &= mask - 1;
+        return *this;
+    }
+
+    int operator*() const
+    {
+        return this->trailing_zeros();
+    }
+
+    // Makes the mask usable with range for
+    hash_bitmask begin() const
+    {
+        return *this;
+    }
+
+    hash_bitmask end() const
+    {
+        return hash_bitmask(0);
+    }
+
+    friend bool operator!=(const hash_bitmask& x, const hash_bitmask& y)
+    {
+        return x.mask != y.mask;
+    }
+
+private:
+    std::uint64_t mask;
+};
+
+#if TICK_HASH_GROUP_SSE2
+
+// Compares 16 control bytes at once with SSE2
+class hash_group
+{
+public:
+    static const int width = 16;
+    typedef hash_bitmask<0> bitmask;
+
+    explicit hash_group(const hash_ctrl* p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))
+    {}
+
+    bitmask match(hash_ctrl h2) const
+    {
+        return bitmask(unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+    }
+
+    bitmask match_empty() const
+    {
+        return this->match(hash_ctrl_empty);
+    }
+
+    bitmask match_empty_or_deleted() const
+    {
+        return bitmask(unsigned(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(hash_ctrl_sentinel), ctrl))));
+    }
+
+private:
+    __m128i ctrl;
+};
+
+#else
+
+// Compares 8 control bytes at once inside a 64 bit word. The match for a
+// full slot can have false positives after a true match, which is fine
+// since the keys are compared anyway.
+class hash_group
+{
+    static const std::uint64_t lsbs = 0x0101010101010101ULL;
+    static const std::uint64_t msbs = 0x8080808080808080ULL;
+public:
+    static const int width = 8;
+    typedef hash_bitmask<3> bitmask;
+
+    explicit hash_group(const hash_ctrl* p)
+    {
+        std::memcpy(&ctrl, p, sizeof(ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        ctrl = __builtin_bswap64(ctrl);
+#endif
+    }
+
+    bitmask match(hash_ctrl h2) const
+    {
+        std::uint64_t x = ctrl ^ (lsbs * std::uint64_t(static_cast<unsigned char>(h2)));
+        return bitmask((x - lsbs) & ~x & msbs);
+    }
+
+    bitmask match_empty() const
+    {
+        return bitmask(ctrl & (~ctrl << 6) & msbs);
+    }
+
+    bitmask match_empty_or_deleted() const
+    {
+        return bitmask(ctrl & (~ctrl << 7) & msbs);
+    }
+
+private:
+    std::uint64_t ctrl;
+};
+
+#endif
+
+// The control bytes of a table with no slots. Probing it finds an empty
+// slot straight away, and iterating it stops at the sentinel.
+inline hash_ctrl* hash_empty_group()
+{
+    alignas(16) static const hash_ctrl group[hash_group::width] = {
+        hash_ctrl_sentinel, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty,
+        hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty
+#if TICK_HASH_GROUP_SSE2
+        , hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty,
+        hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty
+#endif
+    };
+    return const_cast<hash_ctrl*>(group);
+}
+
+// Visits the groups of a table whose capacity is a power of two minus one.
+// The groups are probed with triangular steps, which visits every group
+// once before repeating.
+class hash_probe_seq
+{
+public:
+    hash_probe_seq(std::size_t h1, std::size_t capacity) : mask(capacity), first(h1 & capacity), index(0)
+    {}
+
+    std::size_t offset() const
+    {
+        return first;
+    }
+
+    std::size_t offset(std::size_t i) const
+    {
+        return (first + i) & mask;
+    }
+
+    void next()
+    {
+        index += hash_group::width;
+        first += index;
+        first &= mask;
+    }
+
+private:
+    std::size_t mask;
+    std::size_t first;
+    std::size_t index;
+};
+
+}}
+
+#endif
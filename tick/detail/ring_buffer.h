@@ -0,0 +1,37 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    ring_buffer.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_DETAIL_RING_BUFFER_H
+#define TICK_GUARD_DETAIL_RING_BUFFER_H
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace tick {
+
+namespace detail {
+
+// The capacity of a ring buffer is a power of two, so a position is mapped
+// to a slot with a mask. Positions only ever increase, and are compared by
+// their difference, so they can wrap around.
+inline std::size_t ring_capacity(std::size_t n, const char* what)
+{
+    if (n == 0) throw std::invalid_argument(what);
+    std::size_t c = 1;
+    while(c < n)
+    {
+        if (c > (std::size_t(-1) >> 1)) throw std::length_error(what);
+        c *= 2;
+    }
+    return c;
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,395 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    epoch_domain.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_EPOCH_DOMAIN_H
+#define TICK_GUARD_EPOCH_DOMAIN_H
+
+/// epoch_domain
+/// ============
+///
+/// Description
+/// -----------
+///
+/// Epoch based reclamation, which frees the nodes of a lock free data
+/// structure once no thread can still be reading them. A thread reads the
+/// structure while it is pinned, and when it unlinks a node, it retires the
+/// node instead of freeing it. The node is freed after every thread that
+/// was pinned at the time has unpinned.
+///
+/// Each thread that uses the domain registers a `participant`, which owns
+/// the state of the thread in the domain. Pinning stores the current epoch
+/// in that state, so readers do not write to any memory shared with other
+/// threads. The domain moves to the next epoch when every pinned thread has
+/// seen the current one, and a node retired in epoch `e` is freed once the
+/// domain reaches epoch `e + 2`.
+///
+/// Retired nodes are kept in a list for each participant and freed in
+/// batches. Every 64 retires, the participant tries to move the domain to
+/// the next epoch and frees what it can. A thread that stays pinned holds
+/// back the whole domain, so pins should be short.
+///
+/// A node can be retired with a deleter, which is called with the pointer
+/// on the thread that frees it, or with an allocator satisfying
+/// [`is_allocator`](is_allocator), which destroys and deallocates the node
+/// with a copy of the allocator. A deleter that is an empty class is not
+/// stored at all.
+///
+/// When a participant is destroyed, the nodes it could not free yet are
+/// handed over to the domain, and freed by the other participants or when
+/// the domain is destroyed. The domain must outlive its participants.
+///
+/// Synopsis
+/// --------
+///
+///     class epoch_domain
+///     {
+///     public:
+///         class participant
+///         {
+///         public:
+///             explicit participant(epoch_domain& d);
+///
+///             guard pin();
+///             bool is_pinned() const;
+///
+///             template<class T>
+///             void retire(T* p);
+///             template<class T, class Deleter>
+///             void retire(T* p, Deleter d);
+///             template<class Allocator, class T>
+///             void retire(const Allocator& a, T* p);
+///
+///             void reclaim();
+///             std::size_t pending() const;
+///         };
+///
+///         // Unpins the participant when destroyed
+///         class guard;
+///     };
+///
+/// Example
+/// -------
+///
+///     // A map that is read by many threads and rarely replaced
+///     typedef std::map<std::string, int> config;
+///     tick::epoch_domain domain;
+///     std::atomic<config*> current(new config());
+///
+///     // On each reader
+///     tick::epoch_domain::participant self(domain);
+///     {
+///         auto g = self.pin();
+///         const config& c = *current.load(std::memory_order_acquire);
+///         use(c.at("timeout"));
+///     }
+///
+///     // On the writer
+///     config* next = new config(*current.load());
+///     (*next)["timeout"] = 30;
+///     self.retire(current.exchange(next));
+///
+
+#include <tick/detail/cache_line.h>
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_allocator.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tick {
+
+namespace detail {
+
+struct epoch_retired
+{
+    std::uint64_t epoch;
+    void* object;
+    void* deleter;
+    void (*reclaim)(void* object, void* deleter);
+
+    void operator()() const
+    {
+        reclaim(object, deleter);
+    }
+};
+
+template<class T, class Deleter>
+void epoch_reclaim_empty(void* object, void*)
+{
+    Deleter()(static_cast<T*>(object));
+}
+
+template<class T, class Deleter>
+void epoch_reclaim_stored(void* object, void* deleter)
+{
+    std::unique_ptr<Deleter> d(static_cast<Deleter*>(deleter));
+    (*d)(static_cast<T*>(object));
+}
+
+template<class T, class Deleter>
+epoch_retired make_epoch_retired(T* p, Deleter&&, true_type)
+{
+    epoch_retired r = { 0, p, nullptr, &epoch_reclaim_empty<T, Deleter> };
+    return r;
+}
+
+template<class T, class Deleter>
+epoch_retired make_epoch_retired(T* p, Deleter&& d, false_type)
+{
+    epoch_retired r = { 0, p, new Deleter(std::move(d)), &epoch_reclaim_stored<T, Deleter> };
+    return r;
+}
+
+template<class Allocator>
+struct epoch_allocator_deleter : Allocator
+{
+    typedef std::allocator_traits<Allocator> alloc_traits;
+
+    epoch_allocator_deleter(const Allocator& a) : Allocator(a)
+    {}
+
+    epoch_allocator_deleter() : Allocator()
+    {}
+
+    void operator()(typename alloc_traits::value_type* p)
+    {
+        Allocator& a = *this;
+        alloc_traits::destroy(a, p);
+        alloc_traits::deallocate(a, p, 1);
+    }
+};
+
+// The state of a participant. It is padded to a cache line, so that the
+// threads pinning and unpinning do not write to the same line.
+struct epoch_record
+{
+    epoch_record() : state(0), in_use(true), next(nullptr)
+    {}
+    // The epoch shifted left by one, with the low bit set while pinned
+    std::atomic<std::uint64_t> state;
+    std::atomic<bool> in_use;
+    epoch_record* next;
+    char padding[cache_line_size];
+};
+
+}
+
+class epoch_domain
+{
+public:
+    class participant;
+
+    class guard
+    {
+        friend class participant;
+        participant* self;
+
+        explicit guard(participant* p) : self(p)
+        {}
+    public:
+        guard(guard&& rhs) noexcept : self(rhs.self)
+        {
+            rhs.self = nullptr;
+        }
+
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+
+        ~guard()
+        {
+            if (self != nullptr) self->unpin();
+        }
+    };
+
+    class participant
+    {
+        friend class guard;
+    public:
+        explicit participant(epoch_domain& d) : domain(&d), record(d.acquire_record()), nesting(0), next_reclaim(reclaim_batch)
+        {}
+
+        participant(const participant&) = delete;
+        participant& operator=(const participant&) = delete;
+
+        ~participant()
+        {
+            this->reclaim();
+            domain->adopt(retired);
+            record->in_use.store(false, std::memory_order_release);
+        }
+
+        // Pins are counted, so a pinned thread can pin again
+        guard pin()
+        {
+            if (nesting++ == 0)
+            {
+                std::uint64_t e = domain->epoch.load(std::memory_order_relaxed);
+                record->state.store((e << 1) | 1, std::memory_order_relaxed);
+                // Orders the store before the reads of the data structure,
+                // and pairs with the fence in `try_advance`
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+            return guard(this);
+        }
+
+        bool is_pinned() const
+        {
+            return nesting > 0;
+        }
+
+        template<class T>
+        void retire(T* p)
+        {
+            this->retire(p, std::default_delete<T>());
+        }
+
+        template<class T, class Deleter>
+        void retire(T* p, Deleter d)
+        {
+            typedef integral_constant<bool, (
+                std::is_empty<Deleter>::value and std::is_default_constructible<Deleter>::value
+            )> is_stateless;
+            // Makes room first, so a stored deleter can't leak when the
+            // list fails to grow
+            if (retired.size() == retired.capacity()) retired.reserve(retired.empty() ? 16 : 2 * retired.size());
+            retired.push_back(detail::make_epoch_retired(p, std::move(d), is_stateless()));
+            retired.back().epoch = domain->epoch.load(std::memory_order_seq_cst);
+            if (retired.size() >= next_reclaim) this->reclaim();
+        }
+
+        template<class Allocator, class T, TICK_REQUIRES(is_allocator<Allocator>())>
+        void retire(const Allocator& a, T* p)
+        {
+            typedef typename std::allocator_traits<Allocator>::template rebind_alloc<T> allocator_type;
+            this->retire(p, detail::epoch_allocator_deleter<allocator_type>(allocator_type(a)));
+        }
+
+        // Tries to move the domain to the next epoch, and frees the nodes
+        // that no thread can read anymore
+        void reclaim()
+        {
+            domain->try_advance();
+            std::uint64_t e = domain->epoch.load(std::memory_order_acquire);
+            std::size_t n = 0;
+            // The nodes are in the order they were retired
+            while(n < retired.size() and retired[n].epoch + 2 <= e) retired[n++]();
+            retired.erase(retired.begin(), retired.begin() + n);
+            // When a pinned thread holds the epoch back, wait for another
+            // batch before trying again, so retiring stays amortized constant
+            next_reclaim = retired.size() + reclaim_batch;
+            domain->reclaim_adopted(e);
+        }
+
+        // The number of retired nodes that are not freed yet
+        std::size_t pending() const
+        {
+            return retired.size();
+        }
+
+    private:
+        static const std::size_t reclaim_batch = 64;
+
+        epoch_domain* domain;
+        detail::epoch_record* record;
+        std::size_t nesting;
+        std::size_t next_reclaim;
+        std::vector<detail::epoch_retired> retired;
+
+        void unpin()
+        {
+            if (--nesting == 0) record->state.store(0, std::memory_order_release);
+        }
+    };
+
+    epoch_domain() : epoch(0), records(nullptr)
+    {}
+
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    // Frees all the nodes that are left, so no participant may remain
+    ~epoch_domain()
+    {
+        for(const detail::epoch_retired& r:adopted) r();
+        detail::epoch_record* p = records.load(std::memory_order_acquire);
+        while(p != nullptr)
+        {
+            detail::epoch_record* next = p->next;
+            delete p;
+            p = next;
+        }
+    }
+
+private:
+    std::atomic<std::uint64_t> epoch;
+    // Records are reused by later participants, but never removed from the
+    // list, so it can be traversed without locking
+    std::atomic<detail::epoch_record*> records;
+    std::mutex adopted_mutex;
+    std::vector<detail::epoch_retired> adopted;
+
+    detail::epoch_record* acquire_record()
+    {
+        for(detail::epoch_record* p = records.load(std::memory_order_acquire);p != nullptr;p = p->next)
+        {
+            bool in_use = false;
+            if (!p->in_use.load(std::memory_order_relaxed) and p->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                return p;
+        }
+        detail::epoch_record* p = new detail::epoch_record();
+        p->next = records.load(std::memory_order_relaxed);
+        while(!records.compare_exchange_weak(p->next, p, std::memory_order_release, std::memory_order_relaxed))
+        {}
+        return p;
+    }
+
+    // The epoch can move on when every pinned thread has seen it
+    bool try_advance()
+    {
+        std::uint64_t e = epoch.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for(detail::epoch_record* p = records.load(std::memory_order_acquire);p != nullptr;p = p->next)
+        {
+            std::uint64_t state = p->state.load(std::memory_order_acquire);
+            if ((state & 1) != 0 and (state >> 1) != e) return false;
+        }
+        return epoch.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+    }
+
+    void adopt(std::vector<detail::epoch_retired>& r)
+    {
+        if (r.empty()) return;
+        std::lock_guard<std::mutex> lock(adopted_mutex);
+        adopted.insert(adopted.end(), r.begin(), r.end());
+        r.clear();
+    }
+
+    // Skipped when another thread holds the lock, since it is only ever
+    // needed after a participant went away
+    void reclaim_adopted(std::uint64_t e)
+    {
+        std::unique_lock<std::mutex> lock(adopted_mutex, std::try_to_lock);
+        if (!lock.owns_lock() or adopted.empty()) return;
+        std::vector<detail::epoch_retired>::iterator last = adopted.begin();
+        for(std::vector<detail::epoch_retired>::iterator it = adopted.begin();it != adopted.end();++it)
+        {
+            if (it->epoch + 2 <= e) (*it)();
+            else *last++ = *it;
+        }
+        adopted.erase(last, adopted.end());
+    }
+};
+
+}
+
+#endif
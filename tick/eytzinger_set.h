@@ -0,0 +1,354 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    eytzinger_set.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_EYTZINGER_SET_H
+#define TICK_GUARD_EYTZINGER_SET_H
+
+/// eytzinger_set
+/// =============
+///
+/// Description
+/// -----------
+///
+/// An `eytzinger_set` is an immutable set of unique keys stored in the
+/// breadth first order of a complete binary search tree (the Eytzinger
+/// layout, as used for binary heaps). The children of the key at position
+/// `k` are at `2k` and `2k + 1`, so a search reads the top of the tree from
+/// the same few cache lines on every lookup, and the 16 descendants four
+/// levels below a key are next to each other. Each step of the search
+/// prefetches them, so the memory latency of a large set is overlapped with
+/// the comparisons of the next four levels. The descent picks the child
+/// with arithmetic on the result of the comparison instead of a branch.
+///
+/// For sets that do not fit in the cache this is several times faster than
+/// a binary search over a sorted array such as
+/// [`flat_set`](flat_set). For small sets the difference is small.
+///
+/// The keys are not stored in sorted order, so iterating goes through them
+/// in the layout order, and the iterators returned by `lower_bound` and
+/// `upper_bound` can not be incremented to the next key. Use `flat_set`
+/// when the keys have to be visited in order.
+///
+/// The comparison has to satisfy [`is_compare`](is_compare), and with the
+/// default `std::less` the keys have to satisfy
+/// [`is_weakly_ordered`](is_weakly_ordered). The set is built in linear
+/// time from a range that is already sorted and unique, such as a
+/// `flat_set`, or else the keys are sorted first.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Key, class Compare=std::less<Key>, class Allocator=std::allocator<Key>>
+///     class eytzinger_set;
+///
+/// Example
+/// -------
+///
+///     tick::flat_set<int> keys = { 1, 3, 5, 7 };
+///     tick::eytzinger_set<int> s(tick::sorted_unique, keys);
+///     assert(s.contains(3));
+///     assert(*s.lower_bound(4) == 5);
+///
+
+#include <tick/detail/flat_tree.h>
+#include <tick/requires.h>
+#include <tick/traits/is_compare.h>
+#include <tick/traits/is_input_iterator.h>
+#include <tick/traits/is_range.h>
+#include <tick/traits/is_weakly_ordered.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace tick {
+
+namespace detail {
+
+// The key after the last level the descent went right at, where `k` is the
+// one based position the descent ended at. Going right appends a one bit
+// and going left a zero bit, so this removes the trailing ones and the zero
+// before them. It is zero when the descent only went right.
+inline std::size_t eytzinger_unwind(std::size_t k)
+{
+    std::size_t ones = 0;
+#if defined(__GNUC__)
+    ones = __builtin_ctzll(~static_cast<unsigned long long>(k));
+#else
+    for(std::size_t x = k;x & 1;x >>= 1) ones++;
+#endif
+    return k >> (ones + 1);
+}
+
+// Prefetches the cache line at `n` elements past `p`. The address is
+// computed as an integer, since it may be past the end of the set, where a
+// prefetch does nothing.
+template<class T>
+void eytzinger_prefetch(const T* p, std::size_t n)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(p) + n * sizeof(T)));
+#else
+    (void)p;
+    (void)n;
+#endif
+}
+
+template<class Key, class Compare>
+struct is_eytzinger_compare
+: integral_constant<bool, (
+    is_compare<Compare, const Key&>() and
+    (not std::is_same<Compare, std::less<Key>>() or is_weakly_ordered<Key>())
+)>
+{};
+
+}
+
+template<class Key, class Compare=std::less<Key>, class Allocator=std::allocator<Key>>
+class eytzinger_set
+{
+    static_assert(detail::is_eytzinger_compare<Key, Compare>(), "The keys of an eytzinger_set must be ordered by the comparison");
+    typedef std::vector<Key, Allocator> container_type;
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+    typedef typename container_type::size_type size_type;
+    typedef typename container_type::difference_type difference_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef typename container_type::pointer pointer;
+    typedef typename container_type::const_pointer const_pointer;
+    typedef typename container_type::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    eytzinger_set()
+    {}
+
+    explicit eytzinger_set(const Compare& c, const Allocator& a=Allocator()) : m(c, a)
+    {}
+
+    explicit eytzinger_set(const Allocator& a) : m(Compare(), a)
+    {}
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    eytzinger_set(InputIterator first, InputIterator last, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : m(c, a)
+    {
+        container_type sorted(first, last, a);
+        std::sort(sorted.begin(), sorted.end(), m.comp());
+        sorted.erase(std::unique(sorted.begin(), sorted.end(), [&](const Key& x, const Key& y)
+        {
+            return !m.comp()(x, y);
+        }), sorted.end());
+        this->assign_sorted(sorted.begin(), sorted.size());
+    }
+
+    // Constructs from a range that is already sorted and unique in linear time
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    eytzinger_set(sorted_unique_t, InputIterator first, InputIterator last, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : m(c, a)
+    {
+        container_type sorted(first, last, a);
+        this->assign_sorted(sorted.begin(), sorted.size());
+    }
+
+    template<class Range, TICK_REQUIRES(is_range<const Range&>())>
+    eytzinger_set(sorted_unique_t s, const Range& r, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : eytzinger_set(s, std::begin(r), std::end(r), c, a)
+    {}
+
+    eytzinger_set(std::initializer_list<value_type> il, const Compare& c=Compare(), const Allocator& a=Allocator())
+    : eytzinger_set(il.begin(), il.end(), c, a)
+    {}
+
+    allocator_type get_allocator() const
+    {
+        return m.data.get_allocator();
+    }
+
+    const_iterator begin() const { return m.data.begin(); }
+    const_iterator cbegin() const { return m.data.begin(); }
+
+    const_iterator end() const { return m.data.end(); }
+    const_iterator cend() const { return m.data.end(); }
+
+    bool empty() const
+    {
+        return m.data.empty();
+    }
+
+    size_type size() const
+    {
+        return m.data.size();
+    }
+
+    size_type max_size() const
+    {
+        return m.data.max_size();
+    }
+
+    void clear()
+    {
+        m.data.clear();
+    }
+
+    void swap(eytzinger_set& other)
+    {
+        using std::swap;
+        swap(m.comp(), other.m.comp());
+        m.data.swap(other.m.data);
+    }
+
+    const_iterator find(const key_type& k) const
+    {
+        const_iterator it = this->lower_bound(k);
+        return (it == this->end() or m.comp()(k, *it)) ? this->end() : it;
+    }
+
+    size_type count(const key_type& k) const
+    {
+        return this->find(k) == this->end() ? 0 : 1;
+    }
+
+    bool contains(const key_type& k) const
+    {
+        return this->find(k) != this->end();
+    }
+
+    // The first key that is not less than `k`
+    const_iterator lower_bound(const key_type& k) const
+    {
+        less_than_key pred = { m.comp(), k };
+        return this->search(pred);
+    }
+
+    // The first key that is greater than `k`
+    const_iterator upper_bound(const key_type& k) const
+    {
+        not_greater_than_key pred = { m.comp(), k };
+        return this->search(pred);
+    }
+
+    key_compare key_comp() const
+    {
+        return m.comp();
+    }
+
+    value_compare value_comp() const
+    {
+        return m.comp();
+    }
+
+    friend bool operator==(const eytzinger_set& x, const eytzinger_set& y)
+    {
+        return x.m.data == y.m.data;
+    }
+
+    friend bool operator!=(const eytzinger_set& x, const eytzinger_set& y)
+    {
+        return !(x == y);
+    }
+
+    friend void swap(eytzinger_set& x, eytzinger_set& y)
+    {
+        x.swap(y);
+    }
+
+private:
+    struct impl : Compare
+    {
+        impl()
+        {}
+        impl(const Compare& c, const Allocator& a) : Compare(c), data(a)
+        {}
+        Compare& comp() { return *this; }
+        const Compare& comp() const { return *this; }
+        container_type data;
+    };
+    impl m;
+
+    // The 16 descendants four levels down fill a 64 byte cache line for
+    // four byte keys
+    static const std::size_t prefetch_distance = 16;
+
+    struct less_than_key
+    {
+        const Compare& comp;
+        const key_type& key;
+        bool operator()(const value_type& x) const
+        {
+            return comp(x, key);
+        }
+    };
+
+    struct not_greater_than_key
+    {
+        const Compare& comp;
+        const key_type& key;
+        bool operator()(const value_type& x) const
+        {
+            return !comp(key, x);
+        }
+    };
+
+    // Descends to a leaf, going right when `pred` is true, and returns the
+    // last key it went left at, which is the first key for which `pred` is
+    // false. The positions are one based, so the key at `k` is `data[k - 1]`.
+    template<class Predicate>
+    const_iterator search(Predicate pred) const
+    {
+        const std::size_t n = m.data.size();
+        const value_type* data = m.data.data();
+        std::size_t k = 1;
+        while(k <= n)
+        {
+            detail::eytzinger_prefetch(data, prefetch_distance * k - 1);
+            k = 2 * k + (pred(data[k - 1]) ? 1 : 0);
+        }
+        k = detail::eytzinger_unwind(k);
+        return k == 0 ? this->end() : this->begin() + (k - 1);
+    }
+
+    // Fills the tree with an in order traversal, which visits the positions
+    // in the order of the sorted keys
+    template<class Iterator>
+    void assign_sorted(Iterator first, std::size_t n)
+    {
+        m.data.clear();
+        m.data.reserve(n);
+        // Every position is assigned below, so the initial values are
+        // only placeholders
+        for(std::size_t i=0;i<n;i++) m.data.push_back(first[0]);
+        std::size_t k = this->leftmost(1);
+        for(std::size_t i=0;i<n;i++)
+        {
+            m.data[k - 1] = std::move(first[i]);
+            // Go to the next position in order: the leftmost position of the
+            // right subtree, or else up past the levels that went right
+            if (2 * k + 1 <= n) k = this->leftmost(2 * k + 1);
+            else k = detail::eytzinger_unwind(k);
+        }
+    }
+
+    std::size_t leftmost(std::size_t k) const
+    {
+        while(2 * k <= m.data.size()) k = 2 * k;
+        return k;
+    }
+};
+
+}
+
+#endif
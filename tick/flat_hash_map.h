@@ -0,0 +1,1027 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    flat_hash_map.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_FLAT_HASH_MAP_H
+#define TICK_GUARD_FLAT_HASH_MAP_H
+
+/// flat_hash_map
+/// =============
+///
+/// Description
+/// -----------
+///
+/// A `flat_hash_map` is a hash map with unique keys that stores its elements
+/// directly in one array of slots, using open addressing, instead of
+/// allocating a node for each element. It satisfies
+/// [`is_unordered_associative_container`](is_unordered_associative_container).
+///
+/// Each slot has a control byte, which holds 7 bits of the hash of the key
+/// when the slot is full. A lookup compares a whole group of control bytes
+/// at once (16 with SSE2, otherwise 8 inside a 64 bit word), and only
+/// compares the keys of the slots whose control byte matches. So a lookup
+/// usually touches one cache line of control bytes and one slot, and a miss
+/// usually compares no keys at all.
+///
+/// The table grows when it is 7/8 full. Erasing leaves a tombstone only when
+/// a probe could have gone past the slot, and the tombstones are cleared when
+/// the table is rehashed. Unlike `std::unordered_map`, inserting may move the
+/// elements, which invalidates all iterators, pointers and references, and
+/// erasing invalidates only the iterators to the erased element.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Key, class T, class Hash=std::hash<Key>, class KeyEqual=std::equal_to<Key>,
+///         class Allocator=std::allocator<std::pair<const Key, T>>>
+///     class flat_hash_map;
+///
+/// Example
+/// -------
+///
+///     tick::flat_hash_map<std::string, int> m = { { "one", 1 }, { "two", 2 } };
+///     m["three"] = 3;
+///     assert(m.at("two") == 2);
+///     assert(m.count("four") == 0);
+///
+
+#include <tick/destroy.h>
+#include <tick/detail/hash_group.h>
+#include <tick/integral_constant.h>
+#include <tick/relocate.h>
+#include <tick/requires.h>
+#include <tick/traits/is_always_equal_allocator.h>
+#include <tick/traits/is_input_iterator.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace tick {
+
+template<class Key, class T, class Hash=std::hash<Key>, class KeyEqual=std::equal_to<Key>,
+    class Allocator=std::allocator<std::pair<const Key, T>>>
+class flat_hash_map
+{
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<detail::hash_ctrl> ctrl_allocator;
+    typedef std::allocator_traits<ctrl_allocator> ctrl_traits;
+    typedef detail::hash_group group;
+    typedef detail::hash_ctrl ctrl_type;
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef Allocator allocator_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef typename alloc_traits::pointer pointer;
+    typedef typename alloc_traits::const_pointer const_pointer;
+
+    template<class Value>
+    class basic_iterator
+    {
+        friend class flat_hash_map;
+        template<class>
+        friend class basic_iterator;
+
+        basic_iterator(ctrl_type* ctrl, value_type* slot) : ctrl(ctrl), slot(slot)
+        {}
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<const Key, T> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        basic_iterator() : ctrl(nullptr), slot(nullptr)
+        {}
+
+        template<class U, TICK_REQUIRES(std::is_convertible<U*, Value*>::value)>
+        basic_iterator(const basic_iterator<U>& rhs) : ctrl(rhs.ctrl), slot(rhs.slot)
+        {}
+
+        reference operator*() const
+        {
+            return *slot;
+        }
+
+        pointer operator->() const
+        {
+            return slot;
+        }
+
+        basic_iterator& operator++()
+        {
+            ++ctrl;
+            ++slot;
+            this->skip_empty_or_deleted();
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            basic_iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const basic_iterator& x, const basic_iterator& y)
+        {
+            return x.ctrl == y.ctrl;
+        }
+
+        friend bool operator!=(const basic_iterator& x, const basic_iterator& y)
+        {
+            return x.ctrl != y.ctrl;
+        }
+
+    private:
+        ctrl_type* ctrl;
+        value_type* slot;
+
+        // The sentinel after the last slot stops the scan
+        void skip_empty_or_deleted()
+        {
+            while(detail::hash_ctrl_is_empty_or_deleted(*ctrl))
+            {
+                ++ctrl;
+                ++slot;
+            }
+        }
+    };
+
+    typedef basic_iterator<value_type> iterator;
+    typedef basic_iterator<const value_type> const_iterator;
+
+    flat_hash_map() : flat_hash_map(0)
+    {}
+
+    explicit flat_hash_map(size_type bucket_count, const Hash& h=Hash(), const KeyEqual& eq=KeyEqual(), const Allocator& a=Allocator())
+    : m(h, eq, a)
+    {
+        if (bucket_count > 0) this->resize(flat_hash_map::normalize_capacity(bucket_count));
+    }
+
+    explicit flat_hash_map(const Allocator& a) : m(Hash(), KeyEqual(), a)
+    {}
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    flat_hash_map(InputIterator first, InputIterator last, size_type bucket_count=0,
+        const Hash& h=Hash(), const KeyEqual& eq=KeyEqual(), const Allocator& a=Allocator())
+    : flat_hash_map(bucket_count, h, eq, a)
+    {
+        this->insert(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> il, size_type bucket_count=0,
+        const Hash& h=Hash(), const KeyEqual& eq=KeyEqual(), const Allocator& a=Allocator())
+    : flat_hash_map(il.begin(), il.end(), bucket_count, h, eq, a)
+    {}
+
+    // The constructors that fill the table delegate first, so the
+    // destructor frees what was built when an element throws
+    flat_hash_map(const flat_hash_map& rhs)
+    : flat_hash_map(0, rhs.m.hash, rhs.m.eq, alloc_traits::select_on_container_copy_construction(rhs.get_allocator()))
+    {
+        this->copy_elements(rhs);
+    }
+
+    flat_hash_map(const flat_hash_map& rhs, const Allocator& a) : flat_hash_map(0, rhs.m.hash, rhs.m.eq, a)
+    {
+        this->copy_elements(rhs);
+    }
+
+    flat_hash_map(flat_hash_map&& rhs) noexcept : m(std::move(rhs.m.hash), std::move(rhs.m.eq), rhs.alloc())
+    {
+        this->steal(rhs);
+    }
+
+    flat_hash_map(flat_hash_map&& rhs, const Allocator& a) : flat_hash_map(0, rhs.m.hash, rhs.m.eq, a)
+    {
+        if (this->alloc() == rhs.alloc()) this->steal(rhs);
+        else this->move_elements(rhs);
+    }
+
+    ~flat_hash_map()
+    {
+        this->destroy_elements();
+        this->deallocate();
+    }
+
+    flat_hash_map& operator=(const flat_hash_map& rhs)
+    {
+        if (this == &rhs) return *this;
+        this->destroy_elements();
+        this->deallocate();
+        this->reset();
+        this->copy_allocator(rhs, typename alloc_traits::propagate_on_container_copy_assignment());
+        m.hash = rhs.m.hash;
+        m.eq = rhs.m.eq;
+        this->copy_elements(rhs);
+        return *this;
+    }
+
+    flat_hash_map& operator=(flat_hash_map&& rhs)
+    {
+        if (this != &rhs) this->move_assign(rhs, integral_constant<bool, (
+            alloc_traits::propagate_on_container_move_assignment::value or
+            is_always_equal_allocator<Allocator>::value
+        )>());
+        return *this;
+    }
+
+    flat_hash_map& operator=(std::initializer_list<value_type> il)
+    {
+        this->clear();
+        this->insert(il);
+        return *this;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return m;
+    }
+
+    iterator begin()
+    {
+        iterator it(m.ctrl, m.slots);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+
+    const_iterator begin() const
+    {
+        return const_cast<flat_hash_map&>(*this).begin();
+    }
+
+    const_iterator cbegin() const
+    {
+        return this->begin();
+    }
+
+    iterator end()
+    {
+        return iterator(m.ctrl + m.capacity, m.slots + m.capacity);
+    }
+
+    const_iterator end() const
+    {
+        return const_cast<flat_hash_map&>(*this).end();
+    }
+
+    const_iterator cend() const
+    {
+        return this->end();
+    }
+
+    bool empty() const
+    {
+        return m.size == 0;
+    }
+
+    size_type size() const
+    {
+        return m.size;
+    }
+
+    size_type max_size() const
+    {
+        return alloc_traits::max_size(m);
+    }
+
+    void clear()
+    {
+        this->destroy_elements();
+        if (m.capacity > 0) this->reset_ctrl();
+        m.size = 0;
+        m.growth_left = flat_hash_map::capacity_to_growth(m.capacity);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x)
+    {
+        return this->insert_unique(x.first, x);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& x)
+    {
+        return this->insert_unique(x.first, std::move(x));
+    }
+
+    template<class P, TICK_REQUIRES(std::is_constructible<value_type, P&&>::value)>
+    std::pair<iterator, bool> insert(P&& x)
+    {
+        return this->emplace(std::forward<P>(x));
+    }
+
+    iterator insert(const_iterator, const value_type& x)
+    {
+        return this->insert(x).first;
+    }
+
+    iterator insert(const_iterator, value_type&& x)
+    {
+        return this->insert(std::move(x)).first;
+    }
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    void insert(InputIterator first, InputIterator last)
+    {
+        for(;first != last;++first) this->emplace(*first);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        this->insert(il.begin(), il.end());
+    }
+
+    template<class... Ts>
+    std::pair<iterator, bool> emplace(Ts&&... xs)
+    {
+        // The key is only known once the element is constructed
+        value_type x(std::forward<Ts>(xs)...);
+        return this->insert_unique(x.first, std::move(x));
+    }
+
+    template<class... Ts>
+    iterator emplace_hint(const_iterator, Ts&&... xs)
+    {
+        return this->emplace(std::forward<Ts>(xs)...).first;
+    }
+
+    template<class... Ts>
+    std::pair<iterator, bool> try_emplace(const key_type& k, Ts&&... xs)
+    {
+        return this->insert_unique(k, std::piecewise_construct, std::forward_as_tuple(k), std::forward_as_tuple(std::forward<Ts>(xs)...));
+    }
+
+    template<class... Ts>
+    std::pair<iterator, bool> try_emplace(key_type&& k, Ts&&... xs)
+    {
+        return this->insert_unique(k, std::piecewise_construct, std::forward_as_tuple(std::move(k)), std::forward_as_tuple(std::forward<Ts>(xs)...));
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& k, M&& x)
+    {
+        std::pair<iterator, bool> r = this->try_emplace(k, std::forward<M>(x));
+        if (!r.second) r.first->second = std::forward<M>(x);
+        return r;
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& k, M&& x)
+    {
+        std::pair<iterator, bool> r = this->try_emplace(std::move(k), std::forward<M>(x));
+        if (!r.second) r.first->second = std::forward<M>(x);
+        return r;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        size_type i = pos.slot - m.slots;
+        this->erase_at(i);
+        iterator it(m.ctrl + i, m.slots + i);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+
+    iterator erase(iterator pos)
+    {
+        return this->erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while(first != last) first = this->erase(first);
+        return iterator(last.ctrl, last.slot);
+    }
+
+    size_type erase(const key_type& k)
+    {
+        size_type i = this->find_index(k, this->hash(k));
+        if (i == m.capacity) return 0;
+        this->erase_at(i);
+        return 1;
+    }
+
+    void swap(flat_hash_map& rhs)
+    {
+        if (this->can_share_storage(rhs, integral_constant<bool, (
+            alloc_traits::propagate_on_container_swap::value or
+            is_always_equal_allocator<Allocator>::value
+        )>()))
+        {
+            using std::swap;
+            swap(m.hash, rhs.m.hash);
+            swap(m.eq, rhs.m.eq);
+            swap(m.ctrl, rhs.m.ctrl);
+            swap(m.slots, rhs.m.slots);
+            swap(m.size, rhs.m.size);
+            swap(m.capacity, rhs.m.capacity);
+            swap(m.growth_left, rhs.m.growth_left);
+            this->swap_allocator(rhs, typename alloc_traits::propagate_on_container_swap());
+            return;
+        }
+        flat_hash_map tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend void swap(flat_hash_map& x, flat_hash_map& y)
+    {
+        x.swap(y);
+    }
+
+    T& at(const key_type& k)
+    {
+        iterator it = this->find(k);
+        if (it == this->end()) throw std::out_of_range("flat_hash_map::at");
+        return it->second;
+    }
+
+    const T& at(const key_type& k) const
+    {
+        const_iterator it = this->find(k);
+        if (it == this->end()) throw std::out_of_range("flat_hash_map::at");
+        return it->second;
+    }
+
+    T& operator[](const key_type& k)
+    {
+        return this->try_emplace(k).first->second;
+    }
+
+    T& operator[](key_type&& k)
+    {
+        return this->try_emplace(std::move(k)).first->second;
+    }
+
+    size_type count(const key_type& k) const
+    {
+        return this->find_index(k, this->hash(k)) == m.capacity ? 0 : 1;
+    }
+
+    iterator find(const key_type& k)
+    {
+        size_type i = this->find_index(k, this->hash(k));
+        return iterator(m.ctrl + i, m.slots + i);
+    }
+
+    const_iterator find(const key_type& k) const
+    {
+        return const_cast<flat_hash_map&>(*this).find(k);
+    }
+
+    bool contains(const key_type& k) const
+    {
+        return this->count(k) == 1;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& k)
+    {
+        iterator it = this->find(k);
+        if (it == this->end()) return std::make_pair(it, it);
+        return std::make_pair(it, std::next(it));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+    {
+        return const_cast<flat_hash_map&>(*this).equal_range(k);
+    }
+
+    // The number of slots
+    size_type bucket_count() const
+    {
+        return m.capacity;
+    }
+
+    float load_factor() const
+    {
+        return m.capacity == 0 ? 0.0f : float(m.size) / float(m.capacity);
+    }
+
+    float max_load_factor() const
+    {
+        return 0.875f;
+    }
+
+    // The maximum load factor is fixed, so this does nothing
+    void max_load_factor(float)
+    {}
+
+    void rehash(size_type n)
+    {
+        if (n == 0 and m.size == 0)
+        {
+            this->deallocate();
+            this->reset();
+            return;
+        }
+        size_type c = std::max(flat_hash_map::normalize_capacity(n), flat_hash_map::growth_to_capacity(m.size));
+        if (n == 0 or c > m.capacity) this->resize(c);
+    }
+
+    void reserve(size_type n)
+    {
+        if (n > m.size + m.growth_left) this->resize(flat_hash_map::growth_to_capacity(n));
+    }
+
+    hasher hash_function() const
+    {
+        return m.hash;
+    }
+
+    key_equal key_eq() const
+    {
+        return m.eq;
+    }
+
+    friend bool operator==(const flat_hash_map& x, const flat_hash_map& y)
+    {
+        if (x.size() != y.size()) return false;
+        for(const value_type& e:x)
+        {
+            const_iterator it = y.find(e.first);
+            if (it == y.end() or !(it->second == e.second)) return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(const flat_hash_map& x, const flat_hash_map& y)
+    {
+        return !(x == y);
+    }
+
+private:
+    struct impl : Allocator
+    {
+        impl(const Hash& h, const KeyEqual& eq, const Allocator& a)
+        : Allocator(a), hash(h), eq(eq), ctrl(detail::hash_empty_group()), slots(nullptr), size(0), capacity(0), growth_left(0)
+        {}
+        Hash hash;
+        KeyEqual eq;
+        ctrl_type* ctrl;
+        value_type* slots;
+        size_type size;
+        size_type capacity;
+        size_type growth_left;
+    };
+    impl m;
+
+    Allocator& alloc()
+    {
+        return m;
+    }
+
+    std::size_t hash(const key_type& k) const
+    {
+        return detail::hash_mix(m.hash(k));
+    }
+
+    // Capacities are one less than a power of two, so the capacity is also
+    // the mask for a slot index, and are at least one group minus the
+    // sentinel, so a group loaded at any slot stays inside the table.
+    static size_type normalize_capacity(size_type n)
+    {
+        size_type c = group::width - 1;
+        while(c < n) c = c * 2 + 1;
+        return c;
+    }
+
+    // Keeps at least one slot empty, so a probe always stops
+    static size_type capacity_to_growth(size_type c)
+    {
+        if (c == 0) return 0;
+        return c - std::max<size_type>(c / 8, 1);
+    }
+
+    static size_type growth_to_capacity(size_type n)
+    {
+        size_type c = flat_hash_map::normalize_capacity(0);
+        while(flat_hash_map::capacity_to_growth(c) < n) c = c * 2 + 1;
+        return c;
+    }
+
+    void reset()
+    {
+        m.ctrl = detail::hash_empty_group();
+        m.slots = nullptr;
+        m.size = 0;
+        m.capacity = 0;
+        m.growth_left = 0;
+    }
+
+    void reset_ctrl()
+    {
+        flat_hash_map::reset_ctrl(m.ctrl, m.capacity);
+    }
+
+    static void reset_ctrl(ctrl_type* ctrl, size_type capacity)
+    {
+        std::memset(ctrl, detail::hash_ctrl_empty, capacity + group::width);
+        ctrl[capacity] = detail::hash_ctrl_sentinel;
+    }
+
+    void set_ctrl(size_type i, ctrl_type c)
+    {
+        flat_hash_map::set_ctrl(m.ctrl, m.capacity, i, c);
+    }
+
+    // Sets the control byte of a slot, and its copy after the sentinel for
+    // the slots that a group loaded near the end wraps around to
+    static void set_ctrl(ctrl_type* ctrl, size_type capacity, size_type i, ctrl_type c)
+    {
+        ctrl[i] = c;
+        if (i < group::width - 1) ctrl[capacity + 1 + i] = c;
+    }
+
+    size_type find_index(const key_type& k, std::size_t h) const
+    {
+        detail::hash_probe_seq seq(detail::hash_h1(h), m.capacity);
+        while(true)
+        {
+            group g(m.ctrl + seq.offset());
+            for(int i:g.match(detail::hash_h2(h)))
+            {
+                size_type index = seq.offset(i);
+                if (m.eq(m.slots[index].first, k)) return index;
+            }
+            if (g.match_empty()) return m.capacity;
+            seq.next();
+        }
+    }
+
+    size_type find_first_non_full(std::size_t h) const
+    {
+        return flat_hash_map::find_first_non_full(m.ctrl, m.capacity, h);
+    }
+
+    static size_type find_first_non_full(const ctrl_type* ctrl, size_type capacity, std::size_t h)
+    {
+        detail::hash_probe_seq seq(detail::hash_h1(h), capacity);
+        while(true)
+        {
+            group::bitmask mask = group(ctrl + seq.offset()).match_empty_or_deleted();
+            if (mask) return seq.offset(mask.trailing_zeros());
+            seq.next();
+        }
+    }
+
+    // The table has to grow when no empty slot is left. A tombstone can
+    // always be reused.
+    bool needs_growth(size_type i) const
+    {
+        return m.growth_left == 0 and m.ctrl[i] != detail::hash_ctrl_deleted;
+    }
+
+    void set_full(size_type i, std::size_t h)
+    {
+        if (m.ctrl[i] == detail::hash_ctrl_empty) m.growth_left--;
+        this->set_ctrl(i, detail::hash_h2(h));
+        m.size++;
+    }
+
+    template<class... Ts>
+    std::pair<iterator, bool> insert_unique(const key_type& k, Ts&&... xs)
+    {
+        std::size_t h = this->hash(k);
+        size_type i = this->find_index(k, h);
+        if (i == m.capacity)
+        {
+            i = this->find_first_non_full(h);
+            if (this->needs_growth(i)) i = this->grow_and_construct(h, std::forward<Ts>(xs)...);
+            else alloc_traits::construct(this->alloc(), m.slots + i, std::forward<Ts>(xs)...);
+            this->set_full(i, h);
+            return std::make_pair(iterator(m.ctrl + i, m.slots + i), true);
+        }
+        return std::make_pair(iterator(m.ctrl + i, m.slots + i), false);
+    }
+
+    // The arguments may refer to elements of the map, which growing moves,
+    // so the element is built before the table grows, and then moved in
+    template<class... Ts>
+    size_type grow_and_construct(std::size_t h, Ts&&... xs)
+    {
+        value_type x(std::forward<Ts>(xs)...);
+        this->rehash_and_grow();
+        size_type i = this->find_first_non_full(h);
+        alloc_traits::construct(this->alloc(), m.slots + i, std::move(x));
+        return i;
+    }
+
+    // A slot can be marked empty again, rather than deleted, when every
+    // group that contains it also contains an empty slot, since no probe
+    // could then have gone past it.
+    void erase_at(size_type i)
+    {
+        alloc_traits::destroy(this->alloc(), m.slots + i);
+        size_type before = (i - group::width) & m.capacity;
+        group::bitmask empty_after = group(m.ctrl + i).match_empty();
+        group::bitmask empty_before = group(m.ctrl + before).match_empty();
+        bool was_never_full = empty_before and empty_after and
+            empty_after.trailing_zeros() + empty_before.template leading_zeros<group::width>() < group::width;
+        this->set_ctrl(i, was_never_full ? detail::hash_ctrl_empty : detail::hash_ctrl_deleted);
+        if (was_never_full) m.growth_left++;
+        m.size--;
+    }
+
+    // Rehashing without growing is enough when tombstones take up most of
+    // the room
+    void rehash_and_grow()
+    {
+        if (m.capacity == 0) this->resize(flat_hash_map::normalize_capacity(0));
+        else if (m.size <= flat_hash_map::capacity_to_growth(m.capacity) / 2) this->resize(m.capacity);
+        else this->resize(m.capacity * 2 + 1);
+    }
+
+    // How the elements are moved to a new table. They are relocated when
+    // that can't throw. Otherwise the key is copied, since it is const, and
+    // the mapped value is moved when that can be undone without throwing,
+    // or else copied, so a throw can leave the old table as it was.
+    enum class transfer_kind
+    {
+        relocate,
+        move_mapped,
+        copy
+    };
+
+    typedef std::integral_constant<transfer_kind, (
+        is_trivially_relocatable<value_type>::value or std::is_nothrow_move_constructible<value_type>::value ? transfer_kind::relocate :
+        std::is_nothrow_move_constructible<T>::value and std::is_nothrow_move_assignable<T>::value ? transfer_kind::move_mapped :
+        transfer_kind::copy
+    )> transfer_tag;
+
+    // Nothing is recorded to undo a transfer that can't throw
+    typedef integral_constant<bool, (
+        transfer_tag::value == transfer_kind::relocate and
+        noexcept(detail::hash_mix(std::declval<const Hash&>()(std::declval<const key_type&>())))
+    )> is_nothrow_transfer;
+
+    // The new table is only used once all the elements are in it
+    void resize(size_type c)
+    {
+        ctrl_type* ctrl;
+        value_type* slots;
+        this->allocate(c, ctrl, slots);
+        try
+        {
+            this->transfer(ctrl, slots, c, is_nothrow_transfer());
+        }
+        catch(...)
+        {
+            this->deallocate(ctrl, slots, c);
+            throw;
+        }
+        this->destroy_transferred(transfer_tag());
+        this->deallocate();
+        m.ctrl = ctrl;
+        m.slots = slots;
+        m.capacity = c;
+        m.growth_left = flat_hash_map::capacity_to_growth(c) - m.size;
+    }
+
+    void transfer(ctrl_type* ctrl, value_type* slots, size_type c, true_type)
+    {
+        for(size_type i=0;i<m.capacity;i++)
+        {
+            if (!detail::hash_ctrl_is_full(m.ctrl[i])) continue;
+            std::size_t h = this->hash(m.slots[i].first);
+            size_type j = flat_hash_map::find_first_non_full(ctrl, c, h);
+            this->transfer_one(m.slots + i, slots + j, transfer_tag());
+            flat_hash_map::set_ctrl(ctrl, c, j, detail::hash_h2(h));
+        }
+    }
+
+    // Records where each element went, so the transfers can be undone in
+    // the same order when a hash or a copy throws
+    void transfer(ctrl_type* ctrl, value_type* slots, size_type c, false_type)
+    {
+        std::vector<size_type> moved;
+        moved.reserve(m.size);
+        try
+        {
+            for(size_type i=0;i<m.capacity;i++)
+            {
+                if (!detail::hash_ctrl_is_full(m.ctrl[i])) continue;
+                std::size_t h = this->hash(m.slots[i].first);
+                size_type j = flat_hash_map::find_first_non_full(ctrl, c, h);
+                this->transfer_one(m.slots + i, slots + j, transfer_tag());
+                flat_hash_map::set_ctrl(ctrl, c, j, detail::hash_h2(h));
+                moved.push_back(j);
+            }
+        }
+        catch(...)
+        {
+            std::size_t k = 0;
+            for(size_type i=0;k < moved.size();i++)
+            {
+                if (detail::hash_ctrl_is_full(m.ctrl[i])) this->undo_transfer_one(m.slots + i, slots + moved[k++], transfer_tag());
+            }
+            throw;
+        }
+    }
+
+    void transfer_one(value_type* from, value_type* to, std::integral_constant<transfer_kind, transfer_kind::relocate>)
+    {
+        tick::relocate(from, from + 1, to);
+    }
+
+    void transfer_one(value_type* from, value_type* to, std::integral_constant<transfer_kind, transfer_kind::move_mapped>)
+    {
+        alloc_traits::construct(this->alloc(), to, std::piecewise_construct,
+            std::forward_as_tuple(static_cast<const key_type&>(from->first)),
+            std::forward_as_tuple(std::move(from->second)));
+    }
+
+    void transfer_one(value_type* from, value_type* to, std::integral_constant<transfer_kind, transfer_kind::copy>)
+    {
+        alloc_traits::construct(this->alloc(), to, static_cast<const value_type&>(*from));
+    }
+
+    void undo_transfer_one(value_type* from, value_type* to, std::integral_constant<transfer_kind, transfer_kind::relocate>)
+    {
+        tick::relocate(to, to + 1, from);
+    }
+
+    void undo_transfer_one(value_type* from, value_type* to, std::integral_constant<transfer_kind, transfer_kind::move_mapped>)
+    {
+        from->second = std::move(to->second);
+        alloc_traits::destroy(this->alloc(), to);
+    }
+
+    void undo_transfer_one(value_type*, value_type* to, std::integral_constant<transfer_kind, transfer_kind::copy>)
+    {
+        alloc_traits::destroy(this->alloc(), to);
+    }
+
+    // Relocating already destroyed the old elements
+    void destroy_transferred(std::integral_constant<transfer_kind, transfer_kind::relocate>)
+    {}
+
+    template<transfer_kind Kind>
+    void destroy_transferred(std::integral_constant<transfer_kind, Kind>)
+    {
+        this->destroy_elements();
+    }
+
+    void allocate(size_type c, ctrl_type*& ctrl, value_type*& slots)
+    {
+        ctrl_allocator ca(this->alloc());
+        ctrl = ctrl_traits::allocate(ca, c + group::width);
+        try
+        {
+            slots = alloc_traits::allocate(this->alloc(), c);
+        }
+        catch(...)
+        {
+            ctrl_traits::deallocate(ca, ctrl, c + group::width);
+            throw;
+        }
+        flat_hash_map::reset_ctrl(ctrl, c);
+    }
+
+    void deallocate(ctrl_type* ctrl, value_type* slots, size_type c)
+    {
+        if (c == 0) return;
+        ctrl_allocator ca(this->alloc());
+        ctrl_traits::deallocate(ca, ctrl, c + group::width);
+        alloc_traits::deallocate(this->alloc(), slots, c);
+    }
+
+    void deallocate()
+    {
+        this->deallocate(m.ctrl, m.slots, m.capacity);
+    }
+
+    // The control bytes are not scanned when there is nothing to destroy
+    void destroy_elements()
+    {
+        this->destroy_elements(detail::is_trivially_destroying_allocator<allocator_type, value_type>());
+    }
+
+    void destroy_elements(true_type)
+    {}
+
+    void destroy_elements(false_type)
+    {
+        for(size_type i=0;i<m.capacity;i++)
+        {
+            if (detail::hash_ctrl_is_full(m.ctrl[i])) alloc_traits::destroy(this->alloc(), m.slots + i);
+        }
+    }
+
+    // The elements of rhs are unique, so they are put in the first free
+    // slot without looking for an equal key
+    void copy_elements(const flat_hash_map& rhs)
+    {
+        this->reserve(rhs.size());
+        for(size_type i=0;i<rhs.m.capacity;i++)
+        {
+            if (!detail::hash_ctrl_is_full(rhs.m.ctrl[i])) continue;
+            std::size_t h = this->hash(rhs.m.slots[i].first);
+            size_type j = this->find_first_non_full(h);
+            alloc_traits::construct(this->alloc(), m.slots + j, rhs.m.slots[i]);
+            this->set_full(j, h);
+        }
+    }
+
+    void move_elements(flat_hash_map& rhs)
+    {
+        this->reserve(rhs.size());
+        for(size_type i=0;i<rhs.m.capacity;i++)
+        {
+            if (!detail::hash_ctrl_is_full(rhs.m.ctrl[i])) continue;
+            std::size_t h = this->hash(rhs.m.slots[i].first);
+            size_type j = this->find_first_non_full(h);
+            alloc_traits::construct(this->alloc(), m.slots + j, std::move(rhs.m.slots[i]));
+            this->set_full(j, h);
+        }
+        rhs.clear();
+    }
+
+    void steal(flat_hash_map& rhs)
+    {
+        m.ctrl = rhs.m.ctrl;
+        m.slots = rhs.m.slots;
+        m.size = rhs.m.size;
+        m.capacity = rhs.m.capacity;
+        m.growth_left = rhs.m.growth_left;
+        rhs.reset();
+    }
+
+    void copy_allocator(const flat_hash_map& rhs, std::true_type)
+    {
+        this->alloc() = rhs.m;
+    }
+
+    void copy_allocator(const flat_hash_map&, std::false_type)
+    {}
+
+    void move_allocator(flat_hash_map& rhs, std::true_type)
+    {
+        this->alloc() = std::move(rhs.alloc());
+    }
+
+    void move_allocator(flat_hash_map&, std::false_type)
+    {}
+
+    void swap_allocator(flat_hash_map& rhs, std::true_type)
+    {
+        using std::swap;
+        swap(this->alloc(), rhs.alloc());
+    }
+
+    void swap_allocator(flat_hash_map&, std::false_type)
+    {}
+
+    bool can_share_storage(const flat_hash_map&, true_type) const
+    {
+        return true;
+    }
+
+    bool can_share_storage(const flat_hash_map& rhs, false_type) const
+    {
+        return static_cast<const Allocator&>(m) == static_cast<const Allocator&>(rhs.m);
+    }
+
+    void move_assign(flat_hash_map& rhs, true_type)
+    {
+        this->destroy_elements();
+        this->deallocate();
+        this->reset();
+        this->move_allocator(rhs, typename alloc_traits::propagate_on_container_move_assignment());
+        m.hash = std::move(rhs.m.hash);
+        m.eq = std::move(rhs.m.eq);
+        this->steal(rhs);
+    }
+
+    void move_assign(flat_hash_map& rhs, false_type)
+    {
+        if (this->can_share_storage(rhs, false_type())) this->move_assign(rhs, true_type());
+        else
+        {
+            this->clear();
+            m.hash = rhs.m.hash;
+            m.eq = rhs.m.eq;
+            this->move_elements(rhs);
+        }
+    }
+};
+
+}
+
+#endif
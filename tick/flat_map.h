@@ -0,0 +1,122 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    flat_map.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_FLAT_MAP_H
+#define TICK_GUARD_FLAT_MAP_H
+
+/// flat_map
+/// ========
+///
+/// Description
+/// -----------
+///
+/// A `flat_map` is a map with unique keys stored as a sorted contiguous
+/// vector of `std::pair<Key, T>`. It satisfies
+/// [`is_associative_container`](is_associative_container) and
+/// [`is_reversible_container`](is_reversible_container), and is searched
+/// the same way as a [`flat_set`](flat_set).
+///
+/// Inserting or erasing a single element is linear, so a `flat_map` is best
+/// built in bulk. The constructor taking `sorted_unique` copies an already
+/// sorted range with unique keys in linear time. Unlike `std::map`, the key
+/// of an element can be changed through an iterator, which must not change
+/// the order of the elements.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Key, class T, class Compare=std::less<Key>, class Allocator=std::allocator<std::pair<Key, T>>>
+///     class flat_map;
+///
+/// Example
+/// -------
+///
+///     tick::flat_map<std::string, int> m = { { "one", 1 }, { "two", 2 } };
+///     assert(m.at("two") == 2);
+///
+
+#include <tick/detail/flat_tree.h>
+#include <stdexcept>
+#include <tuple>
+
+namespace tick {
+
+template<class Key, class T, class Compare=std::less<Key>, class Allocator=std::allocator<std::pair<Key, T>>>
+class flat_map
+: public detail::flat_tree<Key, std::pair<Key, T>, detail::flat_select_first, Compare, Allocator, true>
+{
+    typedef detail::flat_tree<Key, std::pair<Key, T>, detail::flat_select_first, Compare, Allocator, true> base;
+public:
+    typedef T mapped_type;
+    typedef typename base::key_type key_type;
+    typedef typename base::value_type value_type;
+    typedef typename base::iterator iterator;
+
+    using base::base;
+
+    flat_map()
+    {}
+
+    flat_map& operator=(std::initializer_list<value_type> il)
+    {
+        base::operator=(il);
+        return *this;
+    }
+
+    T& at(const key_type& k)
+    {
+        iterator it = this->find(k);
+        if (it == this->end()) throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+
+    const T& at(const key_type& k) const
+    {
+        auto it = this->find(k);
+        if (it == this->end()) throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+
+    T& operator[](const key_type& k)
+    {
+        return this->try_emplace(k).first->second;
+    }
+
+    T& operator[](key_type&& k)
+    {
+        return this->try_emplace(std::move(k)).first->second;
+    }
+
+    template<class K, class... Ts>
+    std::pair<iterator, bool> try_emplace(K&& k, Ts&&... xs)
+    {
+        iterator it = this->lower_bound(k);
+        if (it != this->end() and !this->key_comp()(k, it->first)) return std::make_pair(it, false);
+        return std::make_pair(this->emplace_hint(it,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(k)),
+            std::forward_as_tuple(std::forward<Ts>(xs)...)
+        ), true);
+    }
+
+    template<class K, class M>
+    std::pair<iterator, bool> insert_or_assign(K&& k, M&& x)
+    {
+        auto r = this->try_emplace(std::forward<K>(k), std::forward<M>(x));
+        if (!r.second) r.first->second = std::forward<M>(x);
+        return r;
+    }
+
+    friend void swap(flat_map& x, flat_map& y)
+    {
+        x.swap(y);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    flat_set.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_FLAT_SET_H
+#define TICK_GUARD_FLAT_SET_H
+
+/// flat_set
+/// ========
+///
+/// Description
+/// -----------
+///
+/// A `flat_set` is a set of unique keys stored as a sorted contiguous
+/// vector. It satisfies
+/// [`is_associative_container`](is_associative_container) and
+/// [`is_reversible_container`](is_reversible_container). Iterating touches
+/// memory in order, and lookup is a binary search that picks each half with
+/// a conditional move instead of a branch. For arithmetic keys the last
+/// few elements of the search are counted with a loop that is vectorized.
+///
+/// Inserting or erasing a single element is linear, so a `flat_set` is best
+/// built in bulk. The constructor taking `sorted_unique` copies an already
+/// sorted range of unique keys in linear time.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Key, class Compare=std::less<Key>, class Allocator=std::allocator<Key>>
+///     class flat_set;
+///
+/// Example
+/// -------
+///
+///     std::vector<int> keys = { 1, 2, 3 };
+///     tick::flat_set<int> s(tick::sorted_unique, keys.begin(), keys.end());
+///     assert(s.contains(2));
+///
+
+#include <tick/detail/flat_tree.h>
+
+namespace tick {
+
+template<class Key, class Compare=std::less<Key>, class Allocator=std::allocator<Key>>
+class flat_set
+: public detail::flat_tree<Key, Key, detail::flat_identity, Compare, Allocator, false>
+{
+    typedef detail::flat_tree<Key, Key, detail::flat_identity, Compare, Allocator, false> base;
+public:
+    using base::base;
+
+    flat_set()
+    {}
+
+    flat_set& operator=(std::initializer_list<Key> il)
+    {
+        base::operator=(il);
+        return *this;
+    }
+
+    friend void swap(flat_set& x, flat_set& y)
+    {
+        x.swap(y);
+    }
+};
+
+}
+
+#endif
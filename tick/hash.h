@@ -0,0 +1,230 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    hash.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_HASH_H
+#define TICK_GUARD_HASH_H
+
+/// hash
+/// ====
+///
+/// Description
+/// -----------
+///
+/// Hashing of raw bytes and of whole ranges.
+///
+/// * `hash_bytes` hashes `n` bytes, reading 16 bytes per step. It is fast
+///   and mixes well enough for hash tables, but it is not meant to resist
+///   collision attacks.
+/// * `hash_range` hashes the elements of a range. When the elements satisfy
+///   [`is_bitwise_comparable`](is_bitwise_comparable), the range is hashed
+///   as the bytes of its elements, with a single call to `hash_bytes` when
+///   the iterators satisfy [`is_contiguous_iterator`](is_contiguous_iterator),
+///   and a few elements at a time otherwise. Any other elements are hashed
+///   with `std::hash`, so they have to satisfy [`is_hashable`](is_hashable).
+///
+/// The hash only depends on the elements, so ranges with equal elements
+/// give the same hash whatever their iterator type.
+///
+/// Synopsis
+/// --------
+///
+///     std::size_t hash_bytes(const void* p, std::size_t n, std::size_t seed = 0);
+///
+///     template<class InputIterator>
+///     std::size_t hash_range(InputIterator first, InputIterator last, std::size_t seed = 0);
+///
+/// Example
+/// -------
+///
+///     std::vector<std::uint32_t> v = { 1, 2, 3 };
+///     assert(tick::hash_range(v.data(), v.data() + 3) == tick::hash_bytes(v.data(), 12));
+///
+
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_bitwise_comparable.h>
+#include <tick/traits/is_contiguous_iterator.h>
+#include <tick/traits/is_input_iterator.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace tick {
+
+namespace detail {
+
+inline std::uint64_t hash_load64(const unsigned char* p)
+{
+    std::uint64_t x;
+    std::memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+// Loads the last 1 to 8 bytes, so short inputs need no loop
+inline std::uint64_t hash_load_tail(const unsigned char* p, std::size_t n)
+{
+    if (n >= 4)
+    {
+        std::uint32_t a, b;
+        std::memcpy(&a, p, 4);
+        std::memcpy(&b, p + n - 4, 4);
+        return (std::uint64_t(a) << 32) | b;
+    }
+    return (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[n >> 1]) << 8) | p[n - 1];
+}
+
+// Multiplies to 128 bits and folds the halves together. Without 128 bit
+// integers the carries into the high half are dropped, which still mixes
+// well.
+inline std::uint64_t hash_fold(std::uint64_t a, std::uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    return std::uint64_t(r) ^ std::uint64_t(r >> 64);
+#else
+    std::uint64_t lo = a * b;
+    std::uint64_t hi = (a >> 32) * (b >> 32) + (((a >> 32) * (b & 0xffffffff)) >> 32) + (((a & 0xffffffff) * (b >> 32)) >> 32);
+    return lo ^ hi;
+#endif
+}
+
+static const std::uint64_t hash_k0 = 0xa0761d6478bd642fULL;
+static const std::uint64_t hash_k1 = 0xe7037ed1a0b428dbULL;
+static const std::uint64_t hash_k2 = 0x8ebc6af09c88c6e3ULL;
+
+inline std::uint64_t hash_start(std::size_t seed)
+{
+    return hash_fold(std::uint64_t(seed) ^ hash_k0, hash_k1);
+}
+
+inline std::uint64_t hash_block(std::uint64_t h, const unsigned char* p)
+{
+    return hash_fold(hash_load64(p) ^ hash_k1, hash_load64(p + 8) ^ h);
+}
+
+// Hashes the last 0 to 16 bytes. The length is only mixed in here, so the
+// bytes can be hashed as they arrive without knowing it up front.
+inline std::size_t hash_finish(std::uint64_t h, const unsigned char* p, std::size_t n, std::size_t total)
+{
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (n > 8)
+    {
+        a = hash_load64(p);
+        b = hash_load64(p + n - 8);
+    }
+    else if (n > 0)
+    {
+        a = hash_load_tail(p, n);
+    }
+    h = hash_fold(a ^ hash_k1 ^ h, b ^ hash_k2);
+    return std::size_t(hash_fold(h ^ hash_k0 ^ std::uint64_t(total), hash_k2));
+}
+
+// Gives the same hash as `hash_bytes` on bytes that are appended a few at a
+// time. The last block is held back, since it could be the tail.
+class hash_bytes_stream
+{
+    std::uint64_t h;
+    std::size_t total;
+    std::size_t buffered;
+    unsigned char buffer[32];
+public:
+    explicit hash_bytes_stream(std::size_t seed) : h(hash_start(seed)), total(0), buffered(0)
+    {}
+
+    void append(const unsigned char* p, std::size_t n)
+    {
+        total += n;
+        while(n > 0)
+        {
+            std::size_t k = n < sizeof(buffer) - buffered ? n : sizeof(buffer) - buffered;
+            std::memcpy(buffer + buffered, p, k);
+            buffered += k;
+            p += k;
+            n -= k;
+            if (buffered > 16)
+            {
+                h = hash_block(h, buffer);
+                buffered -= 16;
+                std::memmove(buffer, buffer + 16, buffered);
+            }
+        }
+    }
+
+    std::size_t finish() const
+    {
+        return hash_finish(h, buffer, buffered, total);
+    }
+};
+
+template<class Iterator>
+struct hash_range_kind
+: std::integral_constant<int, (
+    not is_bitwise_comparable<typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type>::value ? 2 :
+    is_contiguous_iterator<Iterator>::value ? 0 : 1
+)>
+{};
+
+}
+
+inline std::size_t hash_bytes(const void* data, std::size_t n, std::size_t seed = 0)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::size_t total = n;
+    std::uint64_t h = detail::hash_start(seed);
+    for(;n > 16;n -= 16, p += 16) h = detail::hash_block(h, p);
+    return detail::hash_finish(h, p, n, total);
+}
+
+namespace detail {
+
+template<class Iterator>
+std::size_t hash_range(Iterator first, Iterator last, std::size_t seed, std::integral_constant<int, 0>)
+{
+    if (first == last) return tick::hash_bytes(nullptr, 0, seed);
+    return tick::hash_bytes(contiguous_iterator_traits<Iterator>::to_address(first), (last - first) * sizeof(*first), seed);
+}
+
+template<class Iterator>
+std::size_t hash_range(Iterator first, Iterator last, std::size_t seed, std::integral_constant<int, 1>)
+{
+    typedef typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type value_type;
+    hash_bytes_stream s(seed);
+    for(;first != last;++first)
+    {
+        value_type x = *first;
+        s.append(reinterpret_cast<const unsigned char*>(std::addressof(x)), sizeof(x));
+    }
+    return s.finish();
+}
+
+template<class Iterator>
+std::size_t hash_range(Iterator first, Iterator last, std::size_t seed, std::integral_constant<int, 2>)
+{
+    typedef typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type value_type;
+    std::hash<value_type> hasher;
+    std::uint64_t h = std::uint64_t(seed) ^ hash_k0;
+    for(;first != last;++first) h = detail::hash_fold(h ^ hash_k1, std::uint64_t(hasher(*first)) ^ hash_k2);
+    return std::size_t(h);
+}
+
+}
+
+template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+std::size_t hash_range(InputIterator first, InputIterator last, std::size_t seed = 0)
+{
+    return detail::hash_range(first, last, seed, detail::hash_range_kind<InputIterator>());
+}
+
+}
+
+#endif
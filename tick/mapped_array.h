@@ -0,0 +1,377 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    mapped_array.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_MAPPED_ARRAY_H
+#define TICK_GUARD_MAPPED_ARRAY_H
+
+/// mapped_array
+/// ============
+///
+/// Description
+/// -----------
+///
+/// A file viewed as an array of `T`, by mapping it into memory with `mmap`.
+/// Nothing is read up front: the operating system loads pages as they are
+/// touched and can drop them again under memory pressure, so files larger
+/// than memory can be scanned, and opening one is constant time. The
+/// element type must satisfy both
+/// [`is_trivially_copyable`](is_trivially_copyable) and
+/// [`is_standard_layout`](is_standard_layout), since the elements are the
+/// bytes of the file as they are.
+///
+/// A `mapped_array<const T>` maps the file read only. A `mapped_array<T>`
+/// maps it read write and shared, so changes to the elements are written
+/// back to the file, and it can also create a file of a given size. The
+/// size of the array is the size of the file divided by `sizeof(T)`, and
+/// any bytes after the last whole element are left out.
+///
+/// The iterators are pointers, so they satisfy
+/// [`is_random_access_iterator`](is_random_access_iterator) and
+/// [`is_contiguous_iterator`](is_contiguous_iterator), and the array
+/// satisfies [`is_range`](is_range), so the algorithms constrained on
+/// these traits work on the file directly.
+///
+/// `advise` tells the operating system how the elements will be accessed
+/// with `madvise`. With `mapped_advice::sequential`, pages are read ahead
+/// aggressively and dropped soon after they are used; with
+/// `mapped_advice::random`, no pages are read ahead; and with
+/// `mapped_advice::will_need`, reading the pages starts right away. The
+/// advice is only a hint, so errors are ignored.
+///
+/// Errors from the system calls are thrown as `std::system_error`. The
+/// file must not be truncated while it is mapped, or touching the missing
+/// pages raises `SIGBUS`. Only available on POSIX systems.
+///
+/// Synopsis
+/// --------
+///
+///     enum class mapped_advice
+///     {
+///         normal,
+///         sequential,
+///         random,
+///         will_need
+///     };
+///
+///     template<class T>
+///     class mapped_array
+///     {
+///     public:
+///         typedef T* iterator;
+///         typedef const T* const_iterator;
+///
+///         mapped_array() noexcept;
+///         // Maps the whole file
+///         explicit mapped_array(const std::string& path);
+///         // Creates or resizes the file to hold `n` elements, only when `T` is not const
+///         mapped_array(const std::string& path, size_type n);
+///
+///         mapped_array(mapped_array&& rhs) noexcept;
+///         mapped_array& operator=(mapped_array&& rhs) noexcept;
+///         void swap(mapped_array& rhs) noexcept;
+///
+///         iterator begin() const noexcept;
+///         iterator end() const noexcept;
+///         const_iterator cbegin() const noexcept;
+///         const_iterator cend() const noexcept;
+///         reverse_iterator rbegin() const noexcept;
+///         reverse_iterator rend() const noexcept;
+///
+///         T* data() const noexcept;
+///         size_type size() const noexcept;
+///         bool empty() const noexcept;
+///         T& operator[](size_type i) const;
+///         T& at(size_type i) const;
+///         T& front() const;
+///         T& back() const;
+///
+///         void advise(mapped_advice a) const;
+///         void advise(mapped_advice a, size_type pos, size_type n) const;
+///         // Writes the changes back to the file, only when `T` is not const
+///         void flush() const;
+///     };
+///
+/// Example
+/// -------
+///
+///     struct packet
+///     {
+///         std::uint64_t time;
+///         std::uint32_t length;
+///         std::uint32_t flags;
+///     };
+///
+///     tick::mapped_array<const packet> capture("capture.bin");
+///     capture.advise(tick::mapped_advice::sequential);
+///     std::uint64_t bytes = 0;
+///     for(const packet& p:capture) bytes += p.length;
+///
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <tick/requires.h>
+#include <tick/traits/is_standard_layout.h>
+#include <tick/traits/is_trivially_copyable.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tick {
+
+enum class mapped_advice
+{
+    normal,
+    sequential,
+    random,
+    will_need
+};
+
+namespace detail {
+
+// Closes the file when the mapping is done with it, since the mapping
+// stays valid without it
+class mapped_file
+{
+    int fd;
+public:
+    mapped_file(const std::string& path, int flags) : fd(::open(path.c_str(), flags | O_CLOEXEC, 0666))
+    {
+        if (fd == -1) throw std::system_error(errno, std::generic_category(), "mapped_array: " + path);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+        ::close(fd);
+    }
+
+    std::size_t size() const
+    {
+        struct stat s;
+        if (::fstat(fd, &s) == -1) throw std::system_error(errno, std::generic_category(), "mapped_array");
+        if (static_cast<unsigned long long>(s.st_size) > std::numeric_limits<std::size_t>::max())
+            throw std::length_error("mapped_array");
+        return s.st_size;
+    }
+
+    void resize(std::size_t n) const
+    {
+        if (n > static_cast<unsigned long long>(std::numeric_limits<off_t>::max())) throw std::length_error("mapped_array");
+        if (::ftruncate(fd, n) == -1) throw std::system_error(errno, std::generic_category(), "mapped_array");
+    }
+
+    void* map(std::size_t n, int prot) const
+    {
+        if (n == 0) return nullptr;
+        void* p = ::mmap(nullptr, n, prot, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) throw std::system_error(errno, std::generic_category(), "mapped_array");
+        return p;
+    }
+};
+
+inline int mapped_advice_flag(mapped_advice a)
+{
+    switch(a)
+    {
+        case mapped_advice::sequential: return MADV_SEQUENTIAL;
+        case mapped_advice::random: return MADV_RANDOM;
+        case mapped_advice::will_need: return MADV_WILLNEED;
+        default: return MADV_NORMAL;
+    }
+}
+
+}
+
+template<class T>
+class mapped_array
+{
+    static_assert(is_trivially_copyable<typename std::remove_const<T>::type>() and is_standard_layout<typename std::remove_const<T>::type>(),
+        "The elements must be trivially copyable and standard layout");
+    static_assert(not std::is_volatile<T>::value, "The elements must not be volatile");
+public:
+    typedef typename std::remove_const<T>::type value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    mapped_array() noexcept : first(nullptr), count(0)
+    {}
+
+    explicit mapped_array(const std::string& path) : first(nullptr), count(0)
+    {
+        detail::mapped_file f(path, std::is_const<T>::value ? O_RDONLY : O_RDWR);
+        this->map(f, f.size() / sizeof(T));
+    }
+
+    TICK_MEMBER_REQUIRES(not std::is_const<T>::value)
+    mapped_array(const std::string& path, size_type n) : first(nullptr), count(0)
+    {
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) throw std::length_error("mapped_array");
+        detail::mapped_file f(path, O_RDWR | O_CREAT);
+        f.resize(n * sizeof(T));
+        this->map(f, n);
+    }
+
+    mapped_array(const mapped_array&) = delete;
+    mapped_array& operator=(const mapped_array&) = delete;
+
+    mapped_array(mapped_array&& rhs) noexcept : first(rhs.first), count(rhs.count)
+    {
+        rhs.first = nullptr;
+        rhs.count = 0;
+    }
+
+    mapped_array& operator=(mapped_array&& rhs) noexcept
+    {
+        mapped_array(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~mapped_array()
+    {
+        if (first != nullptr) ::munmap(const_cast<value_type*>(first), count * sizeof(T));
+    }
+
+    void swap(mapped_array& rhs) noexcept
+    {
+        std::swap(first, rhs.first);
+        std::swap(count, rhs.count);
+    }
+
+    friend void swap(mapped_array& x, mapped_array& y) noexcept
+    {
+        x.swap(y);
+    }
+
+    // Like a span, the constness of the elements is in `T` rather than in
+    // the array
+    iterator begin() const noexcept
+    {
+        return first;
+    }
+
+    iterator end() const noexcept
+    {
+        return first + count;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return first;
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return first + count;
+    }
+
+    reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(this->end());
+    }
+
+    reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(this->begin());
+    }
+
+    T* data() const noexcept
+    {
+        return first;
+    }
+
+    size_type size() const noexcept
+    {
+        return count;
+    }
+
+    bool empty() const noexcept
+    {
+        return count == 0;
+    }
+
+    T& operator[](size_type i) const
+    {
+        return first[i];
+    }
+
+    T& at(size_type i) const
+    {
+        if (i >= count) throw std::out_of_range("mapped_array::at");
+        return first[i];
+    }
+
+    T& front() const
+    {
+        return first[0];
+    }
+
+    T& back() const
+    {
+        return first[count - 1];
+    }
+
+    void advise(mapped_advice a) const
+    {
+        this->advise(a, 0, count);
+    }
+
+    // Advises on the elements in `[pos, pos + n)`, widened to whole pages
+    void advise(mapped_advice a, size_type pos, size_type n) const
+    {
+        if (pos >= count or n == 0) return;
+        n = std::min(n, count - pos);
+        char* base = const_cast<char*>(reinterpret_cast<const char*>(first));
+        std::size_t page = ::sysconf(_SC_PAGESIZE);
+        std::size_t begin = pos * sizeof(T) / page * page;
+        std::size_t end = (pos + n) * sizeof(T);
+        ::madvise(base + begin, end - begin, detail::mapped_advice_flag(a));
+    }
+
+    TICK_MEMBER_REQUIRES(not std::is_const<T>::value)
+    void flush() const
+    {
+        if (first != nullptr and ::msync(first, count * sizeof(T), MS_SYNC) == -1)
+            throw std::system_error(errno, std::generic_category(), "mapped_array");
+    }
+
+private:
+    T* first;
+    size_type count;
+
+    void map(const detail::mapped_file& f, size_type n)
+    {
+        first = static_cast<T*>(f.map(n * sizeof(T), std::is_const<T>::value ? PROT_READ : PROT_READ | PROT_WRITE));
+        count = n;
+    }
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,315 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    mpmc_queue.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_MPMC_QUEUE_H
+#define TICK_GUARD_MPMC_QUEUE_H
+
+/// mpmc_queue
+/// ==========
+///
+/// Description
+/// -----------
+///
+/// A bounded lock free queue for any number of producer and consumer
+/// threads, stored as a ring buffer. Pushing and popping never block or
+/// allocate: `try_push` returns false when the queue is full and `try_pop`
+/// returns false when it is empty.
+///
+/// Each slot has a sequence number that says whether it is free or holds an
+/// element for a given position, so producers and consumers only contend on
+/// the position they claim with a compare and swap, and a slot is handed
+/// over with a single store. The push and pop positions are on separate
+/// cache lines.
+///
+/// `push_n` and `pop_n` claim a run of consecutive slots with a single
+/// compare and swap. They move fewer elements than asked for when the run
+/// is shorter, such as when another thread has not finished with a slot
+/// yet.
+///
+/// A claimed slot has to be filled or emptied, or the threads after it
+/// wait forever, so pushing requires the element to be nothrow
+/// constructible from the argument, and popping requires
+/// [`is_nothrow_move_assignable`](is_nothrow_move_assignable). With a
+/// single producer and a single consumer, [`spsc_queue`](spsc_queue) is
+/// faster.
+///
+/// The capacity is rounded up to a power of two, and to at least 2, since
+/// with a single slot the sequence number of a full slot is the same as
+/// that of the free slot on the next lap.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T, class Allocator=std::allocator<T>>
+///     class mpmc_queue
+///     {
+///     public:
+///         explicit mpmc_queue(size_type capacity, const Allocator& a=Allocator());
+///
+///         bool try_push(const T& x);
+///         bool try_push(T&& x);
+///         template<class... Ts>
+///         bool try_emplace(Ts&&... xs);
+///         template<class InputIterator>
+///         size_type push_n(InputIterator first, size_type n);
+///
+///         bool try_pop(T& x);
+///         template<class OutputIterator>
+///         size_type pop_n(OutputIterator out, size_type n);
+///
+///         size_type size() const;
+///         bool empty() const;
+///         size_type capacity() const;
+///     };
+///
+/// Example
+/// -------
+///
+///     tick::mpmc_queue<task*> q(1024);
+///     // On any producer
+///     while(!q.try_push(t)) {}
+///     // On any consumer
+///     task* next;
+///     if (q.try_pop(next)) next->run();
+///
+
+#include <tick/detail/backoff.h>
+#include <tick/detail/cache_line.h>
+#include <tick/detail/ring_buffer.h>
+#include <tick/requires.h>
+#include <tick/traits/is_input_iterator.h>
+#include <tick/traits/is_iterator.h>
+#include <tick/traits/is_nothrow_move_assignable.h>
+#include <tick/traits/is_nothrow_move_constructible.h>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace tick {
+
+template<class T, class Allocator=std::allocator<T>>
+class mpmc_queue
+{
+    typedef std::allocator_traits<Allocator> alloc_traits;
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename alloc_traits::size_type size_type;
+
+    explicit mpmc_queue(size_type capacity, const Allocator& a=Allocator())
+    : m(a, detail::ring_capacity(capacity == 1 ? 2 : capacity, "mpmc_queue"))
+    {
+        slot_allocator sa(this->alloc());
+        m.slots = slot_traits::allocate(sa, m.mask + 1);
+        for(size_type i=0;i<=m.mask;i++) slot_traits::construct(sa, m.slots + i, i);
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue()
+    {
+        for(size_type i = consumer.position.load(std::memory_order_relaxed);i != producer.position.load(std::memory_order_relaxed);i++)
+            alloc_traits::destroy(this->alloc(), this->slot(i).get());
+        slot_allocator sa(this->alloc());
+        for(size_type i=0;i<=m.mask;i++) slot_traits::destroy(sa, m.slots + i);
+        slot_traits::deallocate(sa, m.slots, m.mask + 1);
+    }
+
+    allocator_type get_allocator() const
+    {
+        return this->alloc();
+    }
+
+    TICK_MEMBER_REQUIRES(std::is_nothrow_copy_constructible<T>::value)
+    bool try_push(const T& x)
+    {
+        return this->try_emplace(x);
+    }
+
+    TICK_MEMBER_REQUIRES(is_nothrow_move_constructible<T>())
+    bool try_push(T&& x)
+    {
+        return this->try_emplace(std::move(x));
+    }
+
+    template<class... Ts, TICK_REQUIRES(std::is_nothrow_constructible<T, Ts&&...>::value)>
+    bool try_emplace(Ts&&... xs)
+    {
+        size_type position;
+        if (this->claim(producer, 0, 1, position) == 0) return false;
+        slot_type& s = this->slot(position);
+        alloc_traits::construct(this->alloc(), s.get(), std::forward<Ts>(xs)...);
+        s.sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pushes up to `n` elements from `first`, and returns how many were
+    // pushed
+    template<class InputIterator, TICK_REQUIRES(
+        is_input_iterator<InputIterator>() and
+        std::is_nothrow_constructible<T, typename std::iterator_traits<InputIterator>::reference>::value
+    )>
+    size_type push_n(InputIterator first, size_type n)
+    {
+        size_type position;
+        n = this->claim(producer, 0, n, position);
+        for(size_type i=0;i<n;++i, ++first)
+        {
+            slot_type& s = this->slot(position + i);
+            alloc_traits::construct(this->alloc(), s.get(), *first);
+            s.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    TICK_MEMBER_REQUIRES(is_nothrow_move_assignable<T>())
+    bool try_pop(T& x)
+    {
+        size_type position;
+        if (this->claim(consumer, 1, 1, position) == 0) return false;
+        this->release(x, position);
+        return true;
+    }
+
+    // Pops up to `n` elements into `out`, and returns how many were popped
+    template<class OutputIterator, TICK_REQUIRES(
+        is_iterator<OutputIterator>() and
+        std::is_nothrow_assignable<decltype(*std::declval<OutputIterator&>()), T&&>::value
+    )>
+    size_type pop_n(OutputIterator out, size_type n)
+    {
+        size_type position;
+        n = this->claim(consumer, 1, n, position);
+        for(size_type i=0;i<n;++i, ++out) this->release(*out, position + i);
+        return n;
+    }
+
+    // Only a snapshot, since other threads may push or pop at any time
+    size_type size() const
+    {
+        size_type head = consumer.position.load(std::memory_order_acquire);
+        size_type tail = producer.position.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const
+    {
+        return this->size() == 0;
+    }
+
+    size_type capacity() const
+    {
+        return m.mask + 1;
+    }
+
+private:
+    // The sequence of the slot for position `i` is `i` while it is free for
+    // the producer of `i`, and `i + 1` once it holds the element, until the
+    // consumer frees it for `i + capacity`.
+    struct slot_type
+    {
+        explicit slot_type(size_type i) : sequence(i)
+        {}
+        std::atomic<size_type> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* get()
+        {
+            return reinterpret_cast<T*>(&storage);
+        }
+    };
+    typedef typename alloc_traits::template rebind_alloc<slot_type> slot_allocator;
+    typedef std::allocator_traits<slot_allocator> slot_traits;
+
+    struct impl : Allocator
+    {
+        impl(const Allocator& a, size_type capacity) : Allocator(a), slots(nullptr), mask(capacity - 1)
+        {}
+        slot_type* slots;
+        size_type mask;
+    };
+    impl m;
+
+    struct alignas(detail::cache_line_size) position_type
+    {
+        position_type() : position(0)
+        {}
+        std::atomic<size_type> position;
+    };
+    position_type producer;
+    position_type consumer;
+
+    Allocator& alloc()
+    {
+        return m;
+    }
+
+    const Allocator& alloc() const
+    {
+        return m;
+    }
+
+    slot_type& slot(size_type i) const
+    {
+        return m.slots[i & m.mask];
+    }
+
+    // Claims up to `n` consecutive positions from `side` whose slots are
+    // ready, which is when their sequence is the position plus `offset`. It
+    // returns how many were claimed, and the first position claimed.
+    //
+    // No thread can change the sequence of a slot for a position that has
+    // not been claimed yet, so the slots that are ready when the positions
+    // are read are still ready when the compare and swap succeeds.
+    size_type claim(position_type& side, size_type offset, size_type n, size_type& position)
+    {
+        detail::backoff<> wait;
+        position = side.position.load(std::memory_order_relaxed);
+        if (n == 0) return 0;
+        for(;;)
+        {
+            size_type ready = 0;
+            for(;ready < n;ready++)
+            {
+                size_type sequence = this->slot(position + ready).sequence.load(std::memory_order_acquire);
+                if (sequence != position + ready + offset) break;
+            }
+            if (ready > 0)
+            {
+                if (side.position.compare_exchange_weak(position, position + ready, std::memory_order_relaxed, std::memory_order_relaxed))
+                    return ready;
+                wait.pause();
+            }
+            else
+            {
+                // The slot is behind, so the queue is full or empty
+                size_type sequence = this->slot(position).sequence.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(sequence - (position + offset)) < 0) return 0;
+                // Another thread claimed the position already
+                position = side.position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<class U>
+    void release(U&& out, size_type position)
+    {
+        slot_type& s = this->slot(position);
+        T* p = s.get();
+        out = std::move(*p);
+        alloc_traits::destroy(this->alloc(), p);
+        s.sequence.store(position + m.mask + 1, std::memory_order_release);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,434 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    pool_allocator.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_POOL_ALLOCATOR_H
+#define TICK_GUARD_POOL_ALLOCATOR_H
+
+/// pool_allocator
+/// ==============
+///
+/// Description
+/// -----------
+///
+/// A `pool` is a memory resource for many small allocations of the same
+/// sizes, such as the nodes of `std::map` or `std::set`. Requests are
+/// rounded up to a size class (a multiple of 16 bytes, up to 512 bytes) and
+/// served from a free list for that class. The free lists are refilled from
+/// slabs that are aligned to a cache line, and the slabs are only given back
+/// when the pool is destroyed. Larger or over-aligned requests go straight
+/// to `operator new`.
+///
+/// A `pool` does no locking, so it must only be used by one thread at a
+/// time, and it must outlive the memory allocated from it.
+///
+/// A default constructed `pool_allocator` uses a pool shared by the whole
+/// program instead, which is never destroyed, so a container using it can
+/// be handed to another thread, or be a static that is destroyed at exit.
+/// Each thread keeps a cache of free chunks for each size class in front
+/// of the shared pool, and moves chunks between them in batches, so the
+/// lock on the shared pool is rarely taken. When a thread exits, its cache
+/// is given back to the shared pool.
+///
+/// The `pool_allocator<T>` satisfies
+/// [`is_size_feedback_allocator`](is_size_feedback_allocator), since an
+/// allocation can use the rest of its size class. Two pool allocators are
+/// equal when they use the same pool, and the allocator is not propagated on
+/// copy assignment, move assignment or swap.
+///
+/// Synopsis
+/// --------
+///
+///     class pool
+///     {
+///     public:
+///         explicit pool(std::size_t slab_size=default_slab_size);
+///
+///         void* allocate(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t));
+///         void deallocate(void* p, std::size_t bytes, std::size_t alignment=alignof(std::max_align_t)) noexcept;
+///
+///         // The number of bytes that can be used by an allocation of `bytes`
+///         static std::size_t usable_size(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t)) noexcept;
+///
+///         // The number of bytes held in slabs
+///         std::size_t bytes_reserved() const noexcept;
+///     };
+///
+///     template<class T>
+///     class pool_allocator
+///     {
+///     public:
+///         // Uses the shared pool
+///         pool_allocator() noexcept;
+///         pool_allocator(pool& p) noexcept;
+///
+///         // The pool that is used, or null for the shared pool
+///         pool* get_pool() const noexcept;
+///     };
+///
+/// Example
+/// -------
+///
+///     std::map<int, int, std::less<int>, tick::pool_allocator<std::pair<const int, int>>> m;
+///     m[1] = 2;
+///
+
+#include <tick/allocate_at_least.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace tick {
+
+namespace detail {
+
+inline void* aligned_new(std::size_t bytes, std::size_t alignment)
+{
+    if (alignment <= alignof(std::max_align_t)) return ::operator new(bytes);
+    // Store the pointer returned by operator new just before the aligned
+    // block, so it can be found again to delete it
+    void* raw = ::operator new(bytes + alignment + sizeof(void*));
+    std::uintptr_t p = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    std::uintptr_t aligned = (p + alignment - 1) & ~std::uintptr_t(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void aligned_delete(void* p, std::size_t alignment) noexcept
+{
+    if (alignment <= alignof(std::max_align_t)) ::operator delete(p);
+    else ::operator delete(static_cast<void**>(p)[-1]);
+}
+
+class shared_pool;
+
+}
+
+class pool
+{
+    friend class detail::shared_pool;
+
+    struct node
+    {
+        node* next;
+    };
+    struct size_class
+    {
+        node* free;
+        unsigned char* first;
+        unsigned char* last;
+    };
+public:
+    static const std::size_t cache_line_size = 64;
+    static const std::size_t granularity = 16;
+    static const std::size_t max_chunk_size = 512;
+    static const std::size_t default_slab_size = 64 * 1024;
+
+    explicit pool(std::size_t slab_size=default_slab_size)
+    : slabs(nullptr), slab_count(0), slab_size(slab_size < cache_line_size + max_chunk_size ? cache_line_size + max_chunk_size : slab_size)
+    {
+        for(size_class& c:classes) c.free = nullptr, c.first = c.last = nullptr;
+    }
+
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+
+    ~pool()
+    {
+        while(slabs != nullptr)
+        {
+            node* next = slabs->next;
+            detail::aligned_delete(slabs, cache_line_size);
+            slabs = next;
+        }
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t))
+    {
+        if (!pool::is_pooled(bytes, alignment)) return detail::aligned_new(bytes, alignment);
+        size_class& c = classes[pool::class_index(bytes)];
+        if (c.free != nullptr)
+        {
+            node* n = c.free;
+            c.free = n->next;
+            return n;
+        }
+        std::size_t chunk = pool::chunk_size(bytes);
+        if (std::size_t(c.last - c.first) < chunk) this->refill(c);
+        void* p = c.first;
+        c.first += chunk;
+        return p;
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment=alignof(std::max_align_t)) noexcept
+    {
+        if (!pool::is_pooled(bytes, alignment)) return detail::aligned_delete(p, alignment);
+        size_class& c = classes[pool::class_index(bytes)];
+        node* n = static_cast<node*>(p);
+        n->next = c.free;
+        c.free = n;
+    }
+
+    // The number of bytes that can be used by an allocation of `bytes`
+    static std::size_t usable_size(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t)) noexcept
+    {
+        if (!pool::is_pooled(bytes, alignment)) return bytes;
+        return pool::chunk_size(bytes);
+    }
+
+    std::size_t bytes_reserved() const noexcept
+    {
+        return slab_count * slab_size;
+    }
+
+private:
+    size_class classes[max_chunk_size / granularity];
+    node* slabs;
+    std::size_t slab_count;
+    std::size_t slab_size;
+
+    static bool is_pooled(std::size_t bytes, std::size_t alignment)
+    {
+        return bytes > 0 and bytes <= max_chunk_size and alignment <= granularity;
+    }
+
+    static std::size_t class_index(std::size_t bytes)
+    {
+        return (bytes - 1) / granularity;
+    }
+
+    static std::size_t chunk_size(std::size_t bytes)
+    {
+        return (pool::class_index(bytes) + 1) * granularity;
+    }
+
+    void refill(size_class& c)
+    {
+        // The first cache line holds the link to the next slab, so the
+        // chunks start on a cache line boundary
+        unsigned char* slab = static_cast<unsigned char*>(detail::aligned_new(slab_size, cache_line_size));
+        node* n = reinterpret_cast<node*>(slab);
+        n->next = slabs;
+        slabs = n;
+        slab_count++;
+        c.first = slab + cache_line_size;
+        c.last = slab + slab_size;
+    }
+};
+
+namespace detail {
+
+class shared_pool
+{
+    struct node
+    {
+        node* next;
+    };
+    static const std::size_t class_count = pool::max_chunk_size / pool::granularity;
+    static const std::size_t batch = 32;
+
+    struct backing
+    {
+        std::mutex m;
+        pool p;
+    };
+
+    // It is trivially destructible, so it can still be used after the
+    // destructors of the thread have run, such as by a static container
+    // that is destroyed at exit
+    struct cache
+    {
+        node* free[class_count];
+        std::size_t count[class_count];
+        bool registered;
+        bool closed;
+    };
+
+    struct flusher
+    {
+        ~flusher()
+        {
+            shared_pool::flush(shared_pool::local());
+        }
+    };
+
+    // Never destroyed, so memory can be freed into it at any time
+    static backing& shared()
+    {
+        static backing* b = new backing();
+        return *b;
+    }
+
+    // The cache is flushed when the thread exits, whether it has allocated
+    // chunks or only freed the ones other threads allocated
+    static cache& local()
+    {
+        static thread_local cache c;
+        if (!c.registered)
+        {
+            static thread_local flusher f;
+            (void)f;
+            c.registered = true;
+        }
+        return c;
+    }
+
+    static std::size_t chunk_size(std::size_t i)
+    {
+        return (i + 1) * pool::granularity;
+    }
+
+    static void refill(cache& c, std::size_t i)
+    {
+        backing& b = shared();
+        std::lock_guard<std::mutex> lock(b.m);
+        // The chunks are handed out in the order they come from the pool,
+        // so nodes allocated one after another stay next to each other
+        node** tail = &c.free[i];
+        for(std::size_t k=0;k<batch;k++)
+        {
+            node* n = static_cast<node*>(b.p.allocate(shared_pool::chunk_size(i)));
+            *tail = n;
+            tail = &n->next;
+        }
+        *tail = nullptr;
+        c.count[i] += batch;
+    }
+
+    static void release(cache& c, std::size_t i, std::size_t n)
+    {
+        backing& b = shared();
+        std::lock_guard<std::mutex> lock(b.m);
+        for(;n > 0 and c.free[i] != nullptr;n--)
+        {
+            node* x = c.free[i];
+            c.free[i] = x->next;
+            c.count[i]--;
+            b.p.deallocate(x, shared_pool::chunk_size(i));
+        }
+    }
+
+    static void flush(cache& c)
+    {
+        for(std::size_t i=0;i<class_count;i++) shared_pool::release(c, i, c.count[i]);
+        c.closed = true;
+    }
+public:
+    static void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (!pool::is_pooled(bytes, alignment)) return detail::aligned_new(bytes, alignment);
+        cache& c = local();
+        std::size_t i = pool::class_index(bytes);
+        if (c.closed)
+        {
+            backing& b = shared();
+            std::lock_guard<std::mutex> lock(b.m);
+            return b.p.allocate(bytes, alignment);
+        }
+        if (c.free[i] == nullptr) shared_pool::refill(c, i);
+        node* n = c.free[i];
+        c.free[i] = n->next;
+        c.count[i]--;
+        return n;
+    }
+
+    static void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if (!pool::is_pooled(bytes, alignment)) return detail::aligned_delete(p, alignment);
+        cache& c = local();
+        std::size_t i = pool::class_index(bytes);
+        if (c.closed)
+        {
+            backing& b = shared();
+            std::lock_guard<std::mutex> lock(b.m);
+            return b.p.deallocate(p, bytes, alignment);
+        }
+        node* n = static_cast<node*>(p);
+        n->next = c.free[i];
+        c.free[i] = n;
+        // A thread that frees what others allocate gives the chunks back
+        if (++c.count[i] > 2 * batch) shared_pool::release(c, i, batch);
+    }
+};
+
+}
+
+template<class T>
+class pool_allocator
+{
+public:
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template<class U>
+    struct rebind
+    {
+        typedef pool_allocator<U> other;
+    };
+
+    pool_allocator() noexcept : resource(nullptr)
+    {}
+
+    pool_allocator(pool& p) noexcept : resource(&p)
+    {}
+
+    template<class U>
+    pool_allocator(const pool_allocator<U>& rhs) noexcept : resource(rhs.get_pool())
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T)) throw std::bad_alloc();
+        if (resource == nullptr) return static_cast<T*>(detail::shared_pool::allocate(n * sizeof(T), alignof(T)));
+        return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // The whole size class is handed out, so report it back
+    allocation_result<T*> allocate_at_least(std::size_t n)
+    {
+        allocation_result<T*> result = { this->allocate(n), n };
+        std::size_t bytes = pool::usable_size(n * sizeof(T), alignof(T));
+        if (bytes / sizeof(T) > n) result.count = bytes / sizeof(T);
+        return result;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (resource == nullptr) detail::shared_pool::deallocate(p, n * sizeof(T), alignof(T));
+        else resource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // The pool that is used, or null for the shared pool
+    pool* get_pool() const noexcept
+    {
+        return resource;
+    }
+
+    template<class U>
+    friend bool operator==(const pool_allocator& x, const pool_allocator<U>& y) noexcept
+    {
+        return x.get_pool() == y.get_pool();
+    }
+
+    template<class U>
+    friend bool operator!=(const pool_allocator& x, const pool_allocator<U>& y) noexcept
+    {
+        return x.get_pool() != y.get_pool();
+    }
+
+private:
+    pool* resource;
+};
+
+}
+
+#endif
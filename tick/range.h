@@ -0,0 +1,143 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    range.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_RANGE_H
+#define TICK_GUARD_RANGE_H
+
+/// range
+/// =====
+///
+/// Description
+/// -----------
+///
+/// Bulk operations that put the elements of a range into a sequence
+/// container. When the range satisfies [`is_sized_range`](is_sized_range)
+/// and the container satisfies [`is_reservable`](is_reservable), the room
+/// for the elements is reserved once up front, even when the range only has
+/// input iterators, so filling the container never reallocates.
+///
+/// * `range_size` returns the number of elements of a sized range, using
+///   its `size()` member function or the distance between its iterators.
+/// * `append` adds the elements at the end of the container. When it has to
+///   reserve, it at least doubles the capacity, so appending many ranges in
+///   a row stays linear.
+/// * `assign` replaces the elements of the container, reserving exactly the
+///   size of the range.
+/// * `insert_range` inserts the elements before `pos`, and returns an
+///   iterator to the first inserted element.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Range>
+///     std::size_t range_size(Range&& r);
+///
+///     template<class Container, class Range>
+///     void append(Container& c, Range&& r);
+///
+///     template<class Container, class Range>
+///     void assign(Container& c, Range&& r);
+///
+///     template<class Container, class Range>
+///     typename Container::iterator insert_range(Container& c, typename Container::const_iterator pos, Range&& r);
+///
+/// Example
+/// -------
+///
+///     std::vector<int> v;
+///     std::list<int> l = { 1, 2, 3 };
+///     tick::append(v, l);
+///     assert(v.capacity() >= 3);
+///
+
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_range.h>
+#include <tick/traits/is_reservable.h>
+#include <tick/traits/is_sequence_container.h>
+#include <tick/traits/is_sized_range.h>
+#include <algorithm>
+#include <iterator>
+
+namespace tick {
+
+namespace detail {
+
+template<class Range>
+std::size_t range_size_impl(Range&& r, true_type)
+{
+    return r.size();
+}
+
+template<class Range>
+std::size_t range_size_impl(Range&& r, false_type)
+{
+    using std::begin;
+    using std::end;
+    return std::size_t(std::distance(begin(r), end(r)));
+}
+
+// Makes sure the elements of the range fit without reallocating. With
+// geometric growth, the capacity is at least doubled.
+template<class Container, class Range>
+void reserve_for(Container& c, Range&& r, bool geometric, true_type)
+{
+    std::size_t n = detail::range_size_impl(r, has_size_member<Range>());
+    if (c.capacity() - c.size() < n) c.reserve(c.size() + std::max<std::size_t>(n, geometric ? c.capacity() : 0));
+}
+
+template<class Container, class Range>
+void reserve_for(Container&, Range&&, bool, false_type)
+{}
+
+template<class Container, class Range>
+void reserve_for(Container& c, Range&& r, bool geometric)
+{
+    detail::reserve_for(c, r, geometric, integral_constant<bool, (is_reservable<Container>() and is_sized_range<Range>())>());
+}
+
+}
+
+template<class Range, TICK_REQUIRES(is_sized_range<Range>())>
+std::size_t range_size(Range&& r)
+{
+    return detail::range_size_impl(r, detail::has_size_member<Range>());
+}
+
+template<class Container, class Range, TICK_REQUIRES(is_sequence_container<Container>() and is_range<Range>())>
+void append(Container& c, Range&& r)
+{
+    detail::reserve_for(c, r, true);
+    using std::begin;
+    using std::end;
+    c.insert(c.end(), begin(r), end(r));
+}
+
+template<class Container, class Range, TICK_REQUIRES(is_sequence_container<Container>() and is_range<Range>())>
+void assign(Container& c, Range&& r)
+{
+    c.clear();
+    detail::reserve_for(c, r, false);
+    using std::begin;
+    using std::end;
+    c.insert(c.end(), begin(r), end(r));
+}
+
+template<class Container, class Range, TICK_REQUIRES(is_sequence_container<Container>() and is_range<Range>())>
+typename Container::iterator insert_range(Container& c, typename Container::const_iterator pos, Range&& r)
+{
+    // Reserving invalidates pos, so it is kept as an offset
+    typename Container::difference_type offset = std::distance(c.cbegin(), pos);
+    detail::reserve_for(c, r, true);
+    using std::begin;
+    using std::end;
+    return c.insert(std::next(c.cbegin(), offset), begin(r), end(r));
+}
+
+}
+
+#endif
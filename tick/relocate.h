@@ -0,0 +1,233 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    relocate.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_RELOCATE_H
+#define TICK_GUARD_RELOCATE_H
+
+/// relocate
+/// ========
+///
+/// Description
+/// -----------
+///
+/// Relocating an object moves it into uninitialized storage and then
+/// destroys the source, so the source storage is left uninitialized. When
+/// the iterators are pointers and the value type satisfies
+/// [`is_trivially_relocatable`](is_trivially_relocatable), this is done with
+/// a single `memmove`. Otherwise each element is move constructed and then
+/// destroyed.
+///
+/// The ranges may overlap as long as `relocate` is used to shift elements
+/// towards the front (such as for `erase`), and `relocate_backward` is used
+/// to shift elements towards the back (such as for `insert`).
+///
+/// If a move constructor throws, the elements already relocated and the
+/// elements that are not yet relocated are destroyed before the exception is
+/// propagated.
+///
+/// The `relocate_if_noexcept` function is meant for growing a container
+/// with the strong exception guarantee. It relocates like `relocate` when
+/// that cannot throw, which is when the value type satisfies
+/// [`is_nothrow_move_constructible`](is_nothrow_move_constructible).
+/// Otherwise the elements are copied (or moved, if they cannot be copied)
+/// before the source is destroyed, so if an exception is thrown the source
+/// is left alive and the destination is left uninitialized.
+///
+/// Synopsis
+/// --------
+///
+///     template<class InputIterator, class ForwardIterator>
+///     ForwardIterator relocate(InputIterator first, InputIterator last, ForwardIterator d_first);
+///
+///     template<class InputIterator, class Size, class ForwardIterator>
+///     ForwardIterator uninitialized_relocate_n(InputIterator first, Size n, ForwardIterator d_first);
+///
+///     template<class BidirectionalIterator1, class BidirectionalIterator2>
+///     BidirectionalIterator2 relocate_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 d_last);
+///
+///     template<class InputIterator, class ForwardIterator>
+///     ForwardIterator relocate_if_noexcept(InputIterator first, InputIterator last, ForwardIterator d_first);
+///
+/// Example
+/// -------
+///
+///     std::unique_ptr<int>* first = ...;
+///     // Remove the first element by shifting the rest down
+///     tick::destroy_at(first);
+///     tick::relocate(first + 1, first + n, first);
+///
+
+#include <tick/builder.h>
+#include <tick/destroy.h>
+#include <tick/traits/is_nothrow_move_constructible.h>
+#include <tick/traits/is_trivially_relocatable.h>
+#include <cstring>
+#include <iterator>
+#include <memory>
+
+namespace tick {
+
+namespace detail {
+
+template<class InputIterator, class ForwardIterator>
+struct is_memmove_relocatable
+: integral_constant<bool, (
+    std::is_pointer<ForwardIterator>::value and
+    std::is_same<InputIterator, ForwardIterator>::value and
+    is_trivially_relocatable<typename std::iterator_traits<ForwardIterator>::value_type>::value
+)>
+{};
+
+template<class Iterator>
+void destroy_range(Iterator first, Iterator last)
+{
+    detail::destroy(first, last, is_trivially_destructible_range<Iterator>());
+}
+
+template<class InputIterator, class ForwardIterator>
+void relocate_one(InputIterator src, ForwardIterator dst)
+{
+    typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+    ::new(static_cast<void*>(std::addressof(*dst))) value_type(std::move(*src));
+    tick::destroy_at(std::addressof(*src));
+}
+
+template<class InputIterator, class ForwardIterator>
+ForwardIterator relocate(InputIterator first, InputIterator last, ForwardIterator d_first, false_type)
+{
+    ForwardIterator current = d_first;
+    try
+    {
+        for(;first != last; ++first, ++current) detail::relocate_one(first, current);
+    }
+    catch(...)
+    {
+        detail::destroy_range(d_first, current);
+        detail::destroy_range(first, last);
+        throw;
+    }
+    return current;
+}
+
+template<class T>
+T* relocate(T* first, T* last, T* d_first, true_type)
+{
+    std::size_t n = last - first;
+    if (n > 0) std::memmove(static_cast<void*>(d_first), static_cast<const void*>(first), n * sizeof(T));
+    return d_first + n;
+}
+
+template<class InputIterator, class Size, class ForwardIterator>
+ForwardIterator uninitialized_relocate_n(InputIterator first, Size n, ForwardIterator d_first, false_type)
+{
+    ForwardIterator current = d_first;
+    try
+    {
+        for(;n > 0; ++first, ++current, --n) detail::relocate_one(first, current);
+    }
+    catch(...)
+    {
+        detail::destroy_range(d_first, current);
+        detail::destroy_n(first, n, is_trivially_destructible_range<InputIterator>());
+        throw;
+    }
+    return current;
+}
+
+template<class T, class Size>
+T* uninitialized_relocate_n(T* first, Size n, T* d_first, true_type)
+{
+    return detail::relocate(first, first + n, d_first, true_type());
+}
+
+template<class BidirectionalIterator1, class BidirectionalIterator2>
+BidirectionalIterator2 relocate_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 d_last, false_type)
+{
+    BidirectionalIterator2 current = d_last;
+    try
+    {
+        while(first != last) detail::relocate_one(--last, --current);
+    }
+    catch(...)
+    {
+        detail::destroy_range(current, d_last);
+        detail::destroy_range(first, last);
+        throw;
+    }
+    return current;
+}
+
+template<class T>
+T* relocate_backward(T* first, T* last, T* d_last, true_type)
+{
+    T* d_first = d_last - (last - first);
+    detail::relocate(first, last, d_first, true_type());
+    return d_first;
+}
+
+template<class InputIterator, class ForwardIterator>
+ForwardIterator relocate_if_noexcept(InputIterator first, InputIterator last, ForwardIterator d_first, true_type)
+{
+    return detail::relocate(first, last, d_first, is_memmove_relocatable<InputIterator, ForwardIterator>());
+}
+
+// The source is only destroyed once every element has been constructed
+template<class InputIterator, class ForwardIterator>
+ForwardIterator relocate_if_noexcept(InputIterator first, InputIterator last, ForwardIterator d_first, false_type)
+{
+    typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+    ForwardIterator current = d_first;
+    try
+    {
+        for(InputIterator it = first; it != last; ++it, ++current)
+            ::new(static_cast<void*>(std::addressof(*current))) value_type(std::move_if_noexcept(*it));
+    }
+    catch(...)
+    {
+        detail::destroy_range(d_first, current);
+        throw;
+    }
+    detail::destroy_range(first, last);
+    return current;
+}
+
+}
+
+template<class InputIterator, class ForwardIterator>
+ForwardIterator relocate(InputIterator first, InputIterator last, ForwardIterator d_first)
+{
+    return detail::relocate(first, last, d_first,
+        detail::is_memmove_relocatable<InputIterator, ForwardIterator>());
+}
+
+template<class InputIterator, class Size, class ForwardIterator>
+ForwardIterator uninitialized_relocate_n(InputIterator first, Size n, ForwardIterator d_first)
+{
+    return detail::uninitialized_relocate_n(first, n, d_first,
+        detail::is_memmove_relocatable<InputIterator, ForwardIterator>());
+}
+
+template<class BidirectionalIterator1, class BidirectionalIterator2>
+BidirectionalIterator2 relocate_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 d_last)
+{
+    return detail::relocate_backward(first, last, d_last,
+        detail::is_memmove_relocatable<BidirectionalIterator1, BidirectionalIterator2>());
+}
+
+template<class InputIterator, class ForwardIterator>
+ForwardIterator relocate_if_noexcept(InputIterator first, InputIterator last, ForwardIterator d_first)
+{
+    typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+    return detail::relocate_if_noexcept(first, last, d_first, integral_constant<bool, (
+        detail::is_memmove_relocatable<InputIterator, ForwardIterator>() or
+        is_nothrow_move_constructible<value_type>()
+    )>());
+}
+
+}
+
+#endif
@@ -0,0 +1,260 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    serialize.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_SERIALIZE_H
+#define TICK_GUARD_SERIALIZE_H
+
+/// serialize
+/// =========
+///
+/// Description
+/// -----------
+///
+/// Scatter/gather serialization without copying. `serialize` appends to a
+/// list of `iovec` entries that point straight at the bytes of an object,
+/// so the list can be passed to `writev` or `sendmsg` without staging the
+/// object in a buffer first. `deserialize` appends entries that point at
+/// the storage of an object, for `readv` or `recvmsg` to fill in, so it
+/// rejects objects with parts that are const, such as the keys of a
+/// `std::set` or the characters of a `std::string_view`.
+///
+/// An object is laid out as follows, taking the first case that applies:
+///
+/// * A type with a `serialize_fields` function, found by argument dependent
+///   lookup, is its fields in the order the function visits them. The
+///   function is called with the object and a function object that must be
+///   called on each field, and is used to read the fields as well as to
+///   write them.
+/// * A range whose iterators yield lvalues is its elements in order, with
+///   nothing in between. The size is not written, so `deserialize` fills
+///   in the elements that are already there, and any framing is up to the
+///   caller. This includes views such as `std::string_view`, which are
+///   trivially copyable but whose bytes are only a pointer and a size.
+/// * A type that satisfies both [`is_standard_layout`](is_standard_layout)
+///   and [`is_trivially_copyable`](is_trivially_copyable) is its own bytes.
+///
+/// Any other type is a compile error, rather than silently copying it field
+/// by field. Entries that are next to each other in memory are merged, so a
+/// `std::vector` or `std::array` of trivial elements is a single entry, and
+/// a `std::deque` is one entry for each block. Each entry costs the kernel
+/// about as much as copying a few hundred bytes, so gathering only pays off
+/// when most entries are a kilobyte or more; many small objects are faster
+/// copied into one buffer.
+///
+/// Since the entries point into the objects, they must not be used after
+/// the objects are changed or destroyed. The bytes are written as they are
+/// in memory, so they can only be read back on the same kind of machine,
+/// and pointers within them are meaningless to another process. `writev`
+/// takes at most `IOV_MAX` entries at a time, and may write less than
+/// asked for.
+///
+/// Synopsis
+/// --------
+///
+///     // On POSIX systems this is the `iovec` of `<sys/uio.h>`
+///     struct iovec
+///     {
+///         void* iov_base;
+///         std::size_t iov_len;
+///     };
+///
+///     template<class T>
+///     void serialize(const T& x, std::vector<iovec>& out);
+///
+///     // Only when the object and the elements of its ranges are not const
+///     template<class T>
+///     void deserialize(T& x, std::vector<iovec>& out);
+///
+/// Example
+/// -------
+///
+///     struct sample
+///     {
+///         std::uint64_t time;
+///         double value;
+///     };
+///
+///     struct record
+///     {
+///         std::uint32_t id;
+///         std::vector<sample> samples;
+///     };
+///
+///     template<class F>
+///     void serialize_fields(record& r, F f)
+///     {
+///         f(r.id);
+///         f(r.samples);
+///     }
+///
+///     std::vector<tick::iovec> iov;
+///     tick::serialize(r, iov);
+///     writev(fd, iov.data(), iov.size());
+///
+
+#include <tick/builder.h>
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_range.h>
+#include <tick/traits/is_standard_layout.h>
+#include <tick/traits/is_trivially_copyable.h>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#endif
+
+namespace tick {
+
+#if defined(__unix__) || defined(__APPLE__)
+using ::iovec;
+#else
+struct iovec
+{
+    void* iov_base;
+    std::size_t iov_len;
+};
+#endif
+
+namespace detail {
+
+struct serialize_field_probe
+{
+    template<class T>
+    void operator()(T&) const
+    {}
+};
+
+TICK_TRAIT(has_serialize_fields)
+{
+    template<class T>
+    auto require(T&& x) -> valid<
+        decltype(serialize_fields(x, serialize_field_probe()))
+    >;
+};
+
+TICK_TRAIT(is_lvalue_range, is_range<_>)
+{
+    template<class T>
+    auto require(T&& x) -> valid<
+        is_true<std::is_lvalue_reference<decltype(*tick_adl::begin(x))>>
+    >;
+};
+
+// How an object is laid out: 0 for its own bytes, 1 for its fields, 2 for
+// its elements, and 3 when it can't be serialized. Ranges are checked
+// before the bytes, so a view is written as what it refers to.
+template<class T, class U = typename std::remove_const<T>::type>
+struct serialize_kind
+: std::integral_constant<int, (
+    has_serialize_fields<U>() ? 1 :
+    is_lvalue_range<T&>() ? 2 :
+    is_standard_layout<U>() and is_trivially_copyable<U>() ? 0 : 3
+)>
+{};
+
+// Whether an object can be read into. Its bytes and the elements of its
+// ranges must not be const, such as the characters of a `string_view` or
+// the keys of a `std::set`. Fields are checked as they are visited.
+template<class T, int Kind = serialize_kind<T>::value>
+struct is_deserializable
+: integral_constant<bool, (Kind != 3 and not std::is_const<T>::value)>
+{};
+
+template<class T>
+struct is_deserializable<T, 2>
+: is_deserializable<typename std::remove_reference<decltype(*tick_adl::begin(std::declval<T&>()))>::type>
+{};
+
+inline void append_iovec(std::vector<iovec>& out, const void* p, std::size_t n)
+{
+    if (n == 0) return;
+    void* base = const_cast<void*>(p);
+    if (!out.empty() and static_cast<char*>(out.back().iov_base) + out.back().iov_len == base)
+    {
+        out.back().iov_len += n;
+    }
+    else
+    {
+        iovec v;
+        v.iov_base = base;
+        v.iov_len = n;
+        out.push_back(v);
+    }
+}
+
+// The entries are read into when `Read` is true
+template<bool Read, class T>
+void append_iovecs(T& x, std::vector<iovec>& out);
+
+template<bool Read>
+struct serialize_field
+{
+    std::vector<iovec>* out;
+
+    template<class T>
+    void operator()(T& x) const
+    {
+        static_assert(not Read or is_deserializable<T>(), "The field must not be const, nor have const elements, to be read into");
+        detail::append_iovecs<Read>(x, *out);
+    }
+};
+
+template<bool Read, class T>
+void append_iovecs(T& x, std::vector<iovec>& out, std::integral_constant<int, 0>)
+{
+    detail::append_iovec(out, std::addressof(x), sizeof(T));
+}
+
+// The fields are only read when serializing, so the object can be used as
+// mutable
+template<bool Read, class T>
+void append_iovecs(T& x, std::vector<iovec>& out, std::integral_constant<int, 1>)
+{
+    serialize_field<Read> f = { &out };
+    serialize_fields(const_cast<typename std::remove_const<T>::type&>(x), f);
+}
+
+template<bool Read, class T>
+void append_iovecs(T& x, std::vector<iovec>& out, std::integral_constant<int, 2>)
+{
+    for(auto&& e:x) detail::append_iovecs<Read>(e, out);
+}
+
+template<bool Read, class T>
+void append_iovecs(T&, std::vector<iovec>&, std::integral_constant<int, 3>)
+{
+    static_assert(std::is_void<T>::value and not std::is_void<T>::value,
+        "The type must be standard layout and trivially copyable, a range, or have a serialize_fields function");
+}
+
+template<bool Read, class T>
+void append_iovecs(T& x, std::vector<iovec>& out)
+{
+    detail::append_iovecs<Read>(x, out, serialize_kind<T>());
+}
+
+}
+
+template<class T>
+void serialize(const T& x, std::vector<iovec>& out)
+{
+    detail::append_iovecs<false>(x, out);
+}
+
+template<class T, TICK_REQUIRES(detail::is_deserializable<T>())>
+void deserialize(T& x, std::vector<iovec>& out)
+{
+    detail::append_iovecs<true>(x, out);
+}
+
+}
+
+#endif
@@ -0,0 +1,231 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    sharded.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_SHARDED_H
+#define TICK_GUARD_SHARDED_H
+
+/// sharded
+/// =======
+///
+/// Description
+/// -----------
+///
+/// A value that many threads update at a high rate, such as a counter. It
+/// is split into shards, one per hardware thread by default, each on its
+/// own cache line. A thread only updates its own shard, so threads do not
+/// contend with each other, and `load` combines all the shards with the
+/// `Reducer`. Updates are cheap and reads are slow, so a `sharded` suits
+/// values that are written far more often than they are read.
+///
+/// Each thread is given the next shard in order when it first updates a
+/// `sharded`, so there is no contention until there are more threads than
+/// shards. Threads that share a shard stay correct, since the shards are
+/// synchronized:
+///
+/// * If `T` satisfies [`is_lock_free_atomic`](is_lock_free_atomic), each
+///   shard is a `std::atomic<T>`, updated with a compare and swap, or with
+///   `fetch_add` when `T` is an integer and the reducer is `std::plus<T>`.
+/// * Otherwise each shard is guarded by an
+///   [`adaptive_mutex`](adaptive_mutex).
+///
+/// The `Reducer` must satisfy [`is_binary_operation`](is_binary_operation)
+/// and be associative and commutative, since the updates are combined in
+/// no particular order, and a default constructed `T` must be its identity.
+/// `load` is not a snapshot: updates that run at the same time may or may
+/// not be included, and updates do not order other memory accesses, as
+/// with relaxed atomics.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T, class Reducer=std::plus<T>>
+///     class sharded
+///     {
+///     public:
+///         explicit sharded(const Reducer& r=Reducer());
+///         explicit sharded(std::size_t shards, const Reducer& r=Reducer());
+///
+///         void update(const T& x);
+///         T load() const;
+///
+///         std::size_t shards() const;
+///         reducer_type reducer() const;
+///     };
+///
+/// Example
+/// -------
+///
+///     tick::sharded<std::uint64_t> bytes_sent;
+///     // On each thread
+///     bytes_sent.update(n);
+///     // On the thread that reports
+///     std::uint64_t total = bytes_sent.load();
+///
+
+#include <tick/adaptive_mutex.h>
+#include <tick/cache_padded.h>
+#include <tick/detail/cache_line.h>
+#include <tick/detail/ring_buffer.h>
+#include <tick/integral_constant.h>
+#include <tick/traits/is_binary_operation.h>
+#include <tick/traits/is_default_constructible.h>
+#include <tick/traits/is_lock_free_atomic.h>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace tick {
+
+namespace detail {
+
+// Numbers the threads in the order they first ask
+inline std::size_t thread_shard_index()
+{
+    static std::atomic<std::size_t> next(0);
+    static thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+template<class T, class Reducer>
+struct is_shard_fetch_add
+: integral_constant<bool, (
+    std::is_integral<T>::value and
+    not std::is_same<T, bool>::value and
+    std::is_same<Reducer, std::plus<T>>::value
+)>
+{};
+
+template<class T, class Reducer, bool = is_lock_free_atomic<T>()>
+class shard;
+
+template<class T, class Reducer>
+class shard<T, Reducer, true>
+{
+    std::atomic<T> value;
+
+    void update(const Reducer&, const T& x, true_type)
+    {
+        value.fetch_add(x, std::memory_order_relaxed);
+    }
+
+    void update(const Reducer& r, const T& x, false_type)
+    {
+        T old = value.load(std::memory_order_relaxed);
+        while(!value.compare_exchange_weak(old, r(old, x), std::memory_order_relaxed, std::memory_order_relaxed))
+        {}
+    }
+public:
+    shard() : value(T())
+    {}
+
+    void update(const Reducer& r, const T& x)
+    {
+        this->update(r, x, is_shard_fetch_add<T, Reducer>());
+    }
+
+    T load() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+};
+
+template<class T, class Reducer>
+class shard<T, Reducer, false>
+{
+    mutable adaptive_mutex m;
+    T value;
+public:
+    shard() : value()
+    {}
+
+    void update(const Reducer& r, const T& x)
+    {
+        std::lock_guard<adaptive_mutex> lock(m);
+        value = r(static_cast<const T&>(value), x);
+    }
+
+    T load() const
+    {
+        std::lock_guard<adaptive_mutex> lock(m);
+        return value;
+    }
+};
+
+}
+
+template<class T, class Reducer=std::plus<T>>
+class sharded
+{
+    static_assert(is_default_constructible<T>(), "The value must be default constructible");
+    static_assert(is_binary_operation<const Reducer, T>(), "The reducer must be a binary operation on the value");
+
+    typedef cache_padded<detail::shard<T, Reducer>> shard_type;
+public:
+    typedef T value_type;
+    typedef Reducer reducer_type;
+
+    explicit sharded(const Reducer& r=Reducer())
+    : sharded(sharded::default_shards(), r)
+    {}
+
+    explicit sharded(std::size_t shards, const Reducer& r=Reducer())
+    : m(r, detail::ring_capacity(shards, "sharded"))
+    {}
+
+    sharded(const sharded&) = delete;
+    sharded& operator=(const sharded&) = delete;
+
+    void update(const T& x)
+    {
+        m.shards[detail::thread_shard_index() & m.mask]->update(this->op(), x);
+    }
+
+    T load() const
+    {
+        T result = T();
+        for(std::size_t i=0;i<=m.mask;i++) result = this->op()(static_cast<const T&>(result), m.shards[i]->load());
+        return result;
+    }
+
+    std::size_t shards() const
+    {
+        return m.mask + 1;
+    }
+
+    reducer_type reducer() const
+    {
+        return m;
+    }
+
+private:
+    struct impl : Reducer
+    {
+        impl(const Reducer& r, std::size_t n) : Reducer(r), shards(n), mask(n - 1)
+        {}
+        detail::cache_aligned_array<shard_type> shards;
+        std::size_t mask;
+    };
+    impl m;
+
+    const Reducer& op() const
+    {
+        return m;
+    }
+
+    static std::size_t default_shards()
+    {
+        std::size_t n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+};
+
+}
+
+#endif
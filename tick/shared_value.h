@@ -0,0 +1,254 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    shared_value.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_SHARED_VALUE_H
+#define TICK_GUARD_SHARED_VALUE_H
+
+/// shared_value
+/// ============
+///
+/// Description
+/// -----------
+///
+/// A value that is read and written by several threads, where each `load`
+/// returns a copy of a whole value from some `store`, never a mix of two.
+/// The synchronization is picked from the type:
+///
+/// * If `T` satisfies [`is_lock_free_atomic`](is_lock_free_atomic), the
+///   value is a `std::atomic<T>`.
+/// * Otherwise if `T` satisfies
+///   [`is_trivially_copyable`](is_trivially_copyable), the value is
+///   guarded by a sequence lock. Readers copy the value without writing to
+///   shared memory, and retry if a store ran at the same time, so any
+///   number of readers can run at once without slowing each other down or
+///   the writer. Stores are serialized with each other.
+/// * Otherwise the value is guarded by a reader writer lock, which is
+///   `std::shared_timed_mutex`, or a `std::mutex` before C++14.
+///
+/// A sequence lock suits values of up to a few cache lines that are read
+/// much more often than they are written. Readers spin while a store is in
+/// progress, so a `shared_value` should not be stored in a tight loop by
+/// many threads.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T>
+///     class shared_value
+///     {
+///     public:
+///         shared_value();
+///         explicit shared_value(const T& x);
+///
+///         T load() const;
+///         void store(const T& x);
+///     };
+///
+/// Example
+/// -------
+///
+///     struct quote { double bid, ask; std::uint64_t time; };
+///     tick::shared_value<quote> last;
+///     // On the writer
+///     last.store(quote{ 100.25, 100.5, now });
+///     // On the readers
+///     quote q = last.load();
+///
+
+#include <tick/detail/backoff.h>
+#include <tick/integral_constant.h>
+#include <tick/traits/is_lock_free_atomic.h>
+#include <tick/traits/is_trivially_copyable.h>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#if __cplusplus >= 201402L
+#include <shared_mutex>
+#endif
+
+namespace tick {
+
+namespace detail {
+
+enum class shared_value_kind
+{
+    atomic,
+    seqlock,
+    locked
+};
+
+template<class T>
+struct shared_value_kind_of
+: std::integral_constant<shared_value_kind,
+    is_lock_free_atomic<T>() ? shared_value_kind::atomic :
+    is_trivially_copyable<T>() ? shared_value_kind::seqlock :
+    shared_value_kind::locked
+>
+{};
+
+template<class T, shared_value_kind Kind = shared_value_kind_of<T>::value>
+class shared_value_storage;
+
+template<class T>
+class shared_value_storage<T, shared_value_kind::atomic>
+{
+    std::atomic<T> value;
+public:
+    shared_value_storage() : value(T())
+    {}
+
+    explicit shared_value_storage(const T& x) : value(x)
+    {}
+
+    T load() const
+    {
+        return value.load(std::memory_order_acquire);
+    }
+
+    void store(const T& x)
+    {
+        value.store(x, std::memory_order_release);
+    }
+};
+
+// The value is copied as relaxed atomic words, so a reader that overlaps a
+// store reads a torn copy that it then discards, rather than racing on the
+// memory. The sequence number is odd while a store is in progress.
+template<class T>
+class shared_value_storage<T, shared_value_kind::seqlock>
+{
+    typedef std::size_t word;
+    static const std::size_t word_count = (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+
+    struct buffer
+    {
+        union
+        {
+            word words[word_count];
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        };
+    };
+
+    std::atomic<word> sequence;
+    std::atomic<word> words[word_count];
+
+    void assign(const T& x)
+    {
+        buffer b;
+        b.words[word_count - 1] = 0;
+        std::memcpy(&b, &x, sizeof(T));
+        for(std::size_t i=0;i<word_count;i++) words[i].store(b.words[i], std::memory_order_relaxed);
+    }
+public:
+    shared_value_storage() : sequence(0)
+    {
+        this->assign(T());
+    }
+
+    explicit shared_value_storage(const T& x) : sequence(0)
+    {
+        this->assign(x);
+    }
+
+    T load() const
+    {
+        buffer b;
+        detail::backoff<> wait;
+        for(;;)
+        {
+            word before = sequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0)
+            {
+                for(std::size_t i=0;i<word_count;i++) b.words[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) break;
+            }
+            wait.pause();
+        }
+        return *reinterpret_cast<const T*>(&b.storage);
+    }
+
+    void store(const T& x)
+    {
+        word before = sequence.load(std::memory_order_relaxed);
+        detail::backoff<> wait;
+        while((before & 1) != 0 or !sequence.compare_exchange_weak(before, before + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            wait.pause();
+            before = sequence.load(std::memory_order_relaxed);
+        }
+        // Keeps the words from being written before the sequence is odd
+        std::atomic_thread_fence(std::memory_order_release);
+        this->assign(x);
+        sequence.store(before + 2, std::memory_order_release);
+    }
+};
+
+template<class T>
+class shared_value_storage<T, shared_value_kind::locked>
+{
+#if __cplusplus >= 201402L
+    typedef std::shared_timed_mutex mutex_type;
+    typedef std::shared_lock<mutex_type> read_lock;
+#else
+    typedef std::mutex mutex_type;
+    typedef std::unique_lock<mutex_type> read_lock;
+#endif
+    mutable mutex_type m;
+    T value;
+public:
+    shared_value_storage() : value()
+    {}
+
+    explicit shared_value_storage(const T& x) : value(x)
+    {}
+
+    T load() const
+    {
+        read_lock lock(m);
+        return value;
+    }
+
+    void store(const T& x)
+    {
+        std::lock_guard<mutex_type> lock(m);
+        value = x;
+    }
+};
+
+}
+
+template<class T>
+class shared_value
+{
+    detail::shared_value_storage<T> s;
+public:
+    shared_value()
+    {}
+
+    explicit shared_value(const T& x) : s(x)
+    {}
+
+    shared_value(const shared_value&) = delete;
+    shared_value& operator=(const shared_value&) = delete;
+
+    T load() const
+    {
+        return s.load();
+    }
+
+    void store(const T& x)
+    {
+        s.store(x);
+    }
+};
+
+}
+
+#endif
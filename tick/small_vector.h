@@ -0,0 +1,725 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    small_vector.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_SMALL_VECTOR_H
+#define TICK_GUARD_SMALL_VECTOR_H
+
+/// small_vector
+/// ============
+///
+/// Description
+/// -----------
+///
+/// A `small_vector` is a sequence container that stores up to `N` elements
+/// inline, and only allocates from `Allocator` once it grows past that. It
+/// satisfies [`is_sequence_container`](is_sequence_container) and
+/// [`is_reversible_container`](is_reversible_container), and its iterators
+/// are pointers.
+///
+/// Growing the storage relocates the elements with
+/// [`relocate_if_noexcept`](relocate), so types that are trivially copyable
+/// (or otherwise [`is_trivially_relocatable`](is_trivially_relocatable)) are
+/// moved with `memcpy`, and other types are moved when that cannot throw.
+/// Types whose move constructor can throw are copied instead, so if growing
+/// the storage throws, the vector is left unchanged.
+/// The storage is allocated with [`allocate_at_least`](allocate_at_least),
+/// so any extra room handed out by the allocator becomes capacity.
+///
+/// Allocators that satisfy
+/// [`is_always_equal_allocator`](is_always_equal_allocator), or that
+/// propagate on move assignment or swap, let those operations take over the
+/// heap storage without comparing the allocators.
+///
+/// The move constructor is `noexcept` when the move constructor of `T` is.
+/// Move assignment is as well when the allocator also propagates on move
+/// assignment or is always equal, so a `std::vector` of small vectors moves
+/// them rather than copying them when it grows, and so is `swap` when the
+/// allocator propagates on swap or is always equal. Otherwise vectors with
+/// unequal allocators are swapped element by element, and keep their
+/// allocators.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T, std::size_t N, class Allocator=std::allocator<T>>
+///     class small_vector;
+///
+/// Example
+/// -------
+///
+///     tick::small_vector<int, 8> v;
+///     for(int i=0;i<8;i++) v.push_back(i);
+///     assert(v.is_inline());
+///     v.push_back(8);
+///     assert(!v.is_inline());
+///
+
+#include <tick/allocate_at_least.h>
+#include <tick/destroy.h>
+#include <tick/relocate.h>
+#include <tick/requires.h>
+#include <tick/traits/is_always_equal_allocator.h>
+#include <tick/traits/is_input_iterator.h>
+#include <tick/traits/is_forward_iterator.h>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+namespace tick {
+
+namespace detail {
+
+template<class T, std::size_t N>
+struct small_vector_buffer
+{
+    alignas(T) unsigned char bytes[sizeof(T) * N];
+
+    T* data()
+    {
+        return reinterpret_cast<T*>(bytes);
+    }
+
+    const T* data() const
+    {
+        return reinterpret_cast<const T*>(bytes);
+    }
+};
+
+template<class T>
+struct small_vector_buffer<T, 0>
+{
+    T* data() const
+    {
+        return nullptr;
+    }
+};
+
+}
+
+template<class T, std::size_t N, class Allocator=std::allocator<T>>
+class small_vector
+{
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    // Moving the inline elements can't throw, and assigning or swapping
+    // never falls back to copying element by element
+    typedef integral_constant<bool, std::is_nothrow_move_constructible<T>::value> is_nothrow_move;
+    typedef integral_constant<bool, (
+        is_nothrow_move::value and
+        (alloc_traits::propagate_on_container_move_assignment::value or is_always_equal_allocator<Allocator>::value)
+    )> is_nothrow_move_assign;
+    typedef integral_constant<bool, (
+        is_nothrow_move::value and
+        (alloc_traits::propagate_on_container_swap::value or is_always_equal_allocator<Allocator>::value)
+    )> is_nothrow_swap;
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename alloc_traits::size_type size_type;
+    typedef typename alloc_traits::difference_type difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static const size_type inline_capacity = N;
+
+    small_vector() : small_vector(Allocator())
+    {}
+
+    explicit small_vector(const Allocator& a) : m(a)
+    {
+        this->reset();
+    }
+
+    explicit small_vector(size_type n, const Allocator& a=Allocator()) : small_vector(a)
+    {
+        this->resize(n);
+    }
+
+    small_vector(size_type n, const T& x, const Allocator& a=Allocator()) : small_vector(a)
+    {
+        this->insert(this->end(), n, x);
+    }
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    small_vector(InputIterator first, InputIterator last, const Allocator& a=Allocator()) : small_vector(a)
+    {
+        this->insert(this->end(), first, last);
+    }
+
+    small_vector(std::initializer_list<T> il, const Allocator& a=Allocator()) : small_vector(il.begin(), il.end(), a)
+    {}
+
+    small_vector(const small_vector& rhs)
+    : small_vector(rhs.begin(), rhs.end(), alloc_traits::select_on_container_copy_construction(rhs.get_allocator()))
+    {}
+
+    small_vector(small_vector&& rhs) noexcept(is_nothrow_move::value) : small_vector(rhs.alloc())
+    {
+        this->steal(rhs);
+    }
+
+    ~small_vector()
+    {
+        this->clear();
+        this->deallocate();
+    }
+
+    small_vector& operator=(const small_vector& rhs)
+    {
+        if (this == &rhs) return *this;
+        if (alloc_traits::propagate_on_container_copy_assignment::value and this->alloc() != rhs.alloc())
+        {
+            this->clear();
+            this->deallocate();
+            this->reset();
+        }
+        this->copy_allocator(rhs, typename alloc_traits::propagate_on_container_copy_assignment());
+        this->assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& rhs) noexcept(is_nothrow_move_assign::value)
+    {
+        if (this != &rhs) this->move_assign(rhs, integral_constant<bool, (
+            alloc_traits::propagate_on_container_move_assignment::value or
+            is_always_equal_allocator<Allocator>::value
+        )>());
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<T> il)
+    {
+        this->assign(il.begin(), il.end());
+        return *this;
+    }
+
+    void assign(size_type n, const T& x)
+    {
+        value_type y(x);
+        this->clear();
+        this->insert(this->end(), n, y);
+    }
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    void assign(InputIterator first, InputIterator last)
+    {
+        this->clear();
+        this->insert(this->end(), first, last);
+    }
+
+    void assign(std::initializer_list<T> il)
+    {
+        this->assign(il.begin(), il.end());
+    }
+
+    allocator_type get_allocator() const
+    {
+        return this->alloc();
+    }
+
+    reference at(size_type i)
+    {
+        if (i >= this->size()) throw std::out_of_range("small_vector::at");
+        return m.first[i];
+    }
+
+    const_reference at(size_type i) const
+    {
+        if (i >= this->size()) throw std::out_of_range("small_vector::at");
+        return m.first[i];
+    }
+
+    reference operator[](size_type i)
+    {
+        return m.first[i];
+    }
+
+    const_reference operator[](size_type i) const
+    {
+        return m.first[i];
+    }
+
+    reference front()
+    {
+        return *m.first;
+    }
+
+    const_reference front() const
+    {
+        return *m.first;
+    }
+
+    reference back()
+    {
+        return *(m.last - 1);
+    }
+
+    const_reference back() const
+    {
+        return *(m.last - 1);
+    }
+
+    T* data()
+    {
+        return m.first;
+    }
+
+    const T* data() const
+    {
+        return m.first;
+    }
+
+    iterator begin() { return m.first; }
+    const_iterator begin() const { return m.first; }
+    const_iterator cbegin() const { return m.first; }
+
+    iterator end() { return m.last; }
+    const_iterator end() const { return m.last; }
+    const_iterator cend() const { return m.last; }
+
+    reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(this->end()); }
+
+    reverse_iterator rend() { return reverse_iterator(this->begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(this->begin()); }
+
+    bool empty() const
+    {
+        return m.first == m.last;
+    }
+
+    size_type size() const
+    {
+        return m.last - m.first;
+    }
+
+    size_type max_size() const
+    {
+        return alloc_traits::max_size(this->alloc());
+    }
+
+    size_type capacity() const
+    {
+        return m.end_cap - m.first;
+    }
+
+    bool is_inline() const
+    {
+        return m.first == buffer.data();
+    }
+
+    void reserve(size_type n)
+    {
+        if (n > this->capacity()) this->reallocate(n);
+    }
+
+    void shrink_to_fit()
+    {
+        if (this->is_inline() or this->size() == this->capacity()) return;
+        if (this->size() <= N)
+        {
+            T* first = m.first;
+            size_type cap = this->capacity();
+            m.last = tick::relocate_if_noexcept(m.first, m.last, buffer.data());
+            m.first = buffer.data();
+            m.end_cap = m.first + N;
+            alloc_traits::deallocate(this->alloc(), first, cap);
+        }
+        else this->reallocate(this->size());
+    }
+
+    void clear()
+    {
+        this->destroy(m.first, m.last);
+        m.last = m.first;
+    }
+
+    iterator insert(const_iterator pos, const T& x)
+    {
+        return this->emplace(pos, x);
+    }
+
+    iterator insert(const_iterator pos, T&& x)
+    {
+        return this->emplace(pos, std::move(x));
+    }
+
+    iterator insert(const_iterator pos, size_type n, const T& x)
+    {
+        size_type i = pos - this->cbegin();
+        if (n == 0) return this->begin() + i;
+        value_type y(x);
+        if (this->capacity() - this->size() < n) this->reserve(this->recommend(this->size() + n));
+        size_type old_size = this->size();
+        for(;n > 0;--n) this->emplace_back(y);
+        return this->rotate_tail(i, old_size);
+    }
+
+    template<class InputIterator, TICK_REQUIRES(is_input_iterator<InputIterator>())>
+    iterator insert(const_iterator pos, InputIterator first, InputIterator last)
+    {
+        size_type i = pos - this->cbegin();
+        size_type old_size = this->size();
+        this->reserve_for(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+        for(;first != last;++first) this->emplace_back(*first);
+        return this->rotate_tail(i, old_size);
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> il)
+    {
+        return this->insert(pos, il.begin(), il.end());
+    }
+
+    template<class... Ts>
+    iterator emplace(const_iterator pos, Ts&&... xs)
+    {
+        size_type i = pos - this->cbegin();
+        size_type old_size = this->size();
+        this->emplace_back(std::forward<Ts>(xs)...);
+        return this->rotate_tail(i, old_size);
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return this->erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        iterator p = this->begin() + (first - this->cbegin());
+        if (first != last)
+        {
+            iterator new_last = std::move(p + (last - first), m.last, p);
+            this->destroy(new_last, m.last);
+            m.last = new_last;
+        }
+        return p;
+    }
+
+    void push_back(const T& x)
+    {
+        this->emplace_back(x);
+    }
+
+    void push_back(T&& x)
+    {
+        this->emplace_back(std::move(x));
+    }
+
+    template<class... Ts>
+    reference emplace_back(Ts&&... xs)
+    {
+        if (m.last == m.end_cap) return this->grow_emplace_back(std::forward<Ts>(xs)...);
+        alloc_traits::construct(this->alloc(), m.last, std::forward<Ts>(xs)...);
+        return *m.last++;
+    }
+
+    void pop_back()
+    {
+        --m.last;
+        alloc_traits::destroy(this->alloc(), m.last);
+    }
+
+    void resize(size_type n)
+    {
+        if (n < this->size()) this->erase(this->begin() + n, this->end());
+        else
+        {
+            this->reserve(n);
+            while(this->size() < n) this->emplace_back();
+        }
+    }
+
+    void resize(size_type n, const T& x)
+    {
+        if (n < this->size()) this->erase(this->begin() + n, this->end());
+        else this->insert(this->end(), n - this->size(), x);
+    }
+
+    void swap(small_vector& rhs) noexcept(is_nothrow_swap::value)
+    {
+        if (this == &rhs) return;
+        if (this->can_share_storage(rhs, integral_constant<bool, (
+            alloc_traits::propagate_on_container_swap::value or
+            is_always_equal_allocator<Allocator>::value
+        )>()))
+        {
+            this->swap_storage(rhs);
+            this->swap_allocator(rhs, typename alloc_traits::propagate_on_container_swap());
+        }
+        else this->swap_elements(rhs);
+    }
+
+    friend void swap(small_vector& x, small_vector& y) noexcept(is_nothrow_swap::value)
+    {
+        x.swap(y);
+    }
+
+    friend bool operator==(const small_vector& x, const small_vector& y)
+    {
+        return x.size() == y.size() and std::equal(x.begin(), x.end(), y.begin());
+    }
+
+    friend bool operator!=(const small_vector& x, const small_vector& y)
+    {
+        return !(x == y);
+    }
+
+    friend bool operator<(const small_vector& x, const small_vector& y)
+    {
+        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    }
+
+    friend bool operator>(const small_vector& x, const small_vector& y)
+    {
+        return y < x;
+    }
+
+    friend bool operator<=(const small_vector& x, const small_vector& y)
+    {
+        return !(y < x);
+    }
+
+    friend bool operator>=(const small_vector& x, const small_vector& y)
+    {
+        return !(x < y);
+    }
+
+private:
+    struct impl : Allocator
+    {
+        impl(const Allocator& a) : Allocator(a), first(nullptr), last(nullptr), end_cap(nullptr)
+        {}
+        T* first;
+        T* last;
+        T* end_cap;
+    };
+    impl m;
+    detail::small_vector_buffer<T, N> buffer;
+
+    Allocator& alloc()
+    {
+        return m;
+    }
+
+    const Allocator& alloc() const
+    {
+        return m;
+    }
+
+    void reset()
+    {
+        m.first = m.last = buffer.data();
+        m.end_cap = m.first + N;
+    }
+
+    void deallocate()
+    {
+        if (!this->is_inline()) alloc_traits::deallocate(this->alloc(), m.first, this->capacity());
+    }
+
+    void destroy(T* first, T* last)
+    {
+        tick::destroy(this->alloc(), first, last);
+    }
+
+    size_type recommend(size_type n) const
+    {
+        size_type ms = this->max_size();
+        if (n > ms) throw std::length_error("small_vector");
+        size_type cap = this->capacity();
+        if (cap >= ms / 2) return ms;
+        return std::max(2 * cap, n);
+    }
+
+    // Move the elements into `first`, which has room for `cap` elements and
+    // already holds `extra` constructed elements past the current size
+    void adopt(T* first, size_type cap, size_type extra=0)
+    {
+        size_type n = this->size();
+        try
+        {
+            tick::relocate_if_noexcept(m.first, m.last, first);
+        }
+        catch(...)
+        {
+            // The elements are still in the old storage
+            this->destroy(first + n, first + n + extra);
+            alloc_traits::deallocate(this->alloc(), first, cap);
+            throw;
+        }
+        this->deallocate();
+        m.first = first;
+        m.last = first + n + extra;
+        m.end_cap = first + cap;
+    }
+
+    void reallocate(size_type cap)
+    {
+        auto r = tick::allocate_at_least(this->alloc(), cap);
+        this->adopt(r.ptr, r.count);
+    }
+
+    template<class... Ts>
+    reference grow_emplace_back(Ts&&... xs)
+    {
+        size_type n = this->size();
+        auto r = tick::allocate_at_least(this->alloc(), this->recommend(n + 1));
+        T* first = r.ptr;
+        size_type cap = r.count;
+        // Construct the new element first, since it may refer to an element
+        // of this vector
+        try
+        {
+            alloc_traits::construct(this->alloc(), first + n, std::forward<Ts>(xs)...);
+        }
+        catch(...)
+        {
+            alloc_traits::deallocate(this->alloc(), first, cap);
+            throw;
+        }
+        this->adopt(first, cap, 1);
+        return this->back();
+    }
+
+    iterator rotate_tail(size_type i, size_type old_size)
+    {
+        iterator p = this->begin() + i;
+        std::rotate(p, this->begin() + old_size, this->end());
+        return p;
+    }
+
+    template<class Iterator>
+    void reserve_for(Iterator first, Iterator last, std::forward_iterator_tag)
+    {
+        size_type n = std::distance(first, last);
+        if (this->capacity() - this->size() < n) this->reserve(this->recommend(this->size() + n));
+    }
+
+    template<class Iterator>
+    void reserve_for(Iterator, Iterator, std::input_iterator_tag)
+    {}
+
+    void steal(small_vector& rhs)
+    {
+        if (rhs.is_inline())
+        {
+            // The elements of rhs are destroyed even when relocating throws
+            T* last = rhs.m.last;
+            rhs.m.last = rhs.m.first;
+            m.last = tick::relocate(rhs.m.first, last, m.first);
+        }
+        else
+        {
+            m.first = rhs.m.first;
+            m.last = rhs.m.last;
+            m.end_cap = rhs.m.end_cap;
+            rhs.reset();
+        }
+    }
+
+    // Hands the heap storage or the inline elements over without touching
+    // the allocators
+    void swap_storage(small_vector& rhs)
+    {
+        if (!this->is_inline() and !rhs.is_inline())
+        {
+            using std::swap;
+            swap(m.first, rhs.m.first);
+            swap(m.last, rhs.m.last);
+            swap(m.end_cap, rhs.m.end_cap);
+            return;
+        }
+        small_vector tmp(std::move(rhs));
+        rhs.steal(*this);
+        this->steal(tmp);
+    }
+
+    // The storage can't be handed over, so the elements are exchanged one by
+    // one and the longer vector moves its extra elements to the shorter one
+    void swap_elements(small_vector& rhs)
+    {
+        small_vector& x = this->size() <= rhs.size() ? *this : rhs;
+        small_vector& y = this->size() <= rhs.size() ? rhs : *this;
+        size_type n = x.size();
+        std::swap_ranges(x.begin(), x.end(), y.begin());
+        x.insert(x.end(), std::make_move_iterator(y.begin() + n), std::make_move_iterator(y.end()));
+        y.erase(y.begin() + n, y.end());
+    }
+
+    void copy_allocator(const small_vector& rhs, std::true_type)
+    {
+        this->alloc() = rhs.alloc();
+    }
+
+    void copy_allocator(const small_vector&, std::false_type)
+    {}
+
+    void move_allocator(small_vector& rhs, std::true_type)
+    {
+        this->alloc() = std::move(rhs.alloc());
+    }
+
+    void move_allocator(small_vector&, std::false_type)
+    {}
+
+    void swap_allocator(small_vector& rhs, std::true_type)
+    {
+        using std::swap;
+        swap(this->alloc(), rhs.alloc());
+    }
+
+    void swap_allocator(small_vector&, std::false_type)
+    {}
+
+    // Storage can be handed over without comparing the allocators when they
+    // propagate or are always equal
+    bool can_share_storage(const small_vector&, true_type) const
+    {
+        return true;
+    }
+
+    bool can_share_storage(const small_vector& rhs, false_type) const
+    {
+        return this->alloc() == rhs.alloc();
+    }
+
+    void move_assign(small_vector& rhs, true_type)
+    {
+        this->clear();
+        this->deallocate();
+        this->reset();
+        this->move_allocator(rhs, typename alloc_traits::propagate_on_container_move_assignment());
+        this->steal(rhs);
+    }
+
+    void move_assign(small_vector& rhs, false_type)
+    {
+        if (this->can_share_storage(rhs, false_type())) this->move_assign(rhs, true_type());
+        else
+        {
+            this->assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+            rhs.clear();
+        }
+    }
+};
+
+template<class T, std::size_t N, class Allocator>
+const typename small_vector<T, N, Allocator>::size_type small_vector<T, N, Allocator>::inline_capacity;
+
+}
+
+#endif
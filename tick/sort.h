@@ -0,0 +1,528 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    sort.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_SORT_H
+#define TICK_GUARD_SORT_H
+
+/// sort
+/// ====
+///
+/// Description
+/// -----------
+///
+/// Sorts the elements of a random access range, like `std::sort`, picking
+/// the algorithm from the element type and the comparison.
+///
+/// When the elements are integers or IEEE floating point numbers, and they
+/// are compared with `std::less` or `std::greater` (including the
+/// transparent `std::less<>` and `std::greater<>`), large ranges are sorted
+/// with a least significant digit radix sort. It makes one pass to count
+/// the digits of every key, and then one pass for each digit that is not
+/// the same in all the keys, so it runs in linear time. A range that is
+/// already sorted is left as it is. The radix sort needs a
+/// buffer as large as the range. If the buffer cannot be allocated, the
+/// range is sorted in place instead.
+///
+/// Every other range is sorted with a pattern-defeating quicksort. This is
+/// a quicksort that finds sorted and reverse sorted runs in linear time. It
+/// switches to heapsort when the pivots keep being bad, so the worst case
+/// is `O(n log n)`.
+///
+/// Like `std::sort`, the sort is not stable. For floating point numbers
+/// with the radix sort, `-0.0` is placed before `0.0`. A NaN is not ordered
+/// by `std::less`, so its position is unspecified.
+///
+/// Synopsis
+/// --------
+///
+///     template<class RandomAccessIterator>
+///     void sort(RandomAccessIterator first, RandomAccessIterator last);
+///
+///     template<class RandomAccessIterator, class Compare>
+///     void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp);
+///
+/// Example
+/// -------
+///
+///     std::vector<std::uint64_t> v = ...;
+///     // Uses the radix sort
+///     tick::sort(v.begin(), v.end());
+///     // Uses the pattern-defeating quicksort
+///     tick::sort(v.begin(), v.end(), [](std::uint64_t x, std::uint64_t y) { return x % 10 < y % 10; });
+///
+
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_compare.h>
+#include <tick/traits/is_random_access_iterator.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tick {
+
+namespace detail {
+
+static const std::ptrdiff_t pdq_insertion_sort_threshold = 24;
+static const std::ptrdiff_t pdq_ninther_threshold = 128;
+static const std::size_t pdq_partial_insertion_sort_limit = 8;
+// Below this size the radix sort does not pay for its counting pass
+static const std::ptrdiff_t radix_sort_threshold = 256;
+
+template<class Iterator, class Compare>
+void insertion_sort(Iterator first, Iterator last, Compare& comp)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    if (first == last) return;
+    for(Iterator i = first + 1;i != last;++i)
+    {
+        Iterator sift = i;
+        Iterator sift_1 = i - 1;
+        if (comp(*sift, *sift_1))
+        {
+            value_type x = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); }
+            while(sift != first and comp(x, *--sift_1));
+            *sift = std::move(x);
+        }
+    }
+}
+
+// The element before first must not be greater than any element of the
+// range, so the inner loop needs no bounds check
+template<class Iterator, class Compare>
+void unguarded_insertion_sort(Iterator first, Iterator last, Compare& comp)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    if (first == last) return;
+    for(Iterator i = first + 1;i != last;++i)
+    {
+        Iterator sift = i;
+        Iterator sift_1 = i - 1;
+        if (comp(*sift, *sift_1))
+        {
+            value_type x = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); }
+            while(comp(x, *--sift_1));
+            *sift = std::move(x);
+        }
+    }
+}
+
+// Gives up once more than a few elements had to be moved, and returns
+// whether the range was sorted
+template<class Iterator, class Compare>
+bool partial_insertion_sort(Iterator first, Iterator last, Compare& comp)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    if (first == last) return true;
+    std::size_t moved = 0;
+    for(Iterator i = first + 1;i != last;++i)
+    {
+        Iterator sift = i;
+        Iterator sift_1 = i - 1;
+        if (comp(*sift, *sift_1))
+        {
+            value_type x = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); }
+            while(sift != first and comp(x, *--sift_1));
+            *sift = std::move(x);
+            moved += i - sift;
+        }
+        if (moved > pdq_partial_insertion_sort_limit) return false;
+    }
+    return true;
+}
+
+template<class Iterator, class Compare>
+void sort2(Iterator a, Iterator b, Compare& comp)
+{
+    if (comp(*b, *a)) std::iter_swap(a, b);
+}
+
+template<class Iterator, class Compare>
+void sort3(Iterator a, Iterator b, Iterator c, Compare& comp)
+{
+    detail::sort2(a, b, comp);
+    detail::sort2(b, c, comp);
+    detail::sort2(a, b, comp);
+}
+
+// Partitions around the pivot at first, with the elements equal to the
+// pivot put on the right. Also returns whether no elements were swapped.
+template<class Iterator, class Compare>
+std::pair<Iterator, bool> partition_right(Iterator first, Iterator last, Compare& comp)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    value_type pivot = std::move(*first);
+    Iterator i = first;
+    Iterator j = last;
+    while(comp(*++i, pivot));
+    if (i - 1 == first) while(i < j and !comp(*--j, pivot));
+    else while(!comp(*--j, pivot));
+    bool already_partitioned = i >= j;
+    while(i < j)
+    {
+        std::iter_swap(i, j);
+        while(comp(*++i, pivot));
+        while(!comp(*--j, pivot));
+    }
+    Iterator pivot_pos = i - 1;
+    *first = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return std::make_pair(pivot_pos, already_partitioned);
+}
+
+// Partitions around the pivot at first, with the elements equal to the
+// pivot put on the left. This is used when the pivot is equal to the
+// element before the range, so every element equal to it is already in
+// place.
+template<class Iterator, class Compare>
+Iterator partition_left(Iterator first, Iterator last, Compare& comp)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    value_type pivot = std::move(*first);
+    Iterator i = first;
+    Iterator j = last;
+    while(comp(pivot, *--j));
+    if (j + 1 == last) while(i < j and !comp(pivot, *++i));
+    else while(!comp(pivot, *++i));
+    while(i < j)
+    {
+        std::iter_swap(i, j);
+        while(comp(pivot, *--j));
+        while(!comp(pivot, *++i));
+    }
+    *first = std::move(*j);
+    *j = std::move(pivot);
+    return j;
+}
+
+// Swaps some elements around after a bad partition, to break up the
+// pattern that caused it
+template<class Iterator>
+void pdq_shuffle(Iterator first, Iterator pivot_pos, Iterator last)
+{
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+    difference_type l = pivot_pos - first;
+    difference_type r = last - (pivot_pos + 1);
+    if (l >= pdq_insertion_sort_threshold)
+    {
+        std::iter_swap(first, first + l / 4);
+        std::iter_swap(pivot_pos - 1, pivot_pos - l / 4);
+        if (l > pdq_ninther_threshold)
+        {
+            std::iter_swap(first + 1, first + (l / 4 + 1));
+            std::iter_swap(first + 2, first + (l / 4 + 2));
+            std::iter_swap(pivot_pos - 2, pivot_pos - (l / 4 + 1));
+            std::iter_swap(pivot_pos - 3, pivot_pos - (l / 4 + 2));
+        }
+    }
+    if (r >= pdq_insertion_sort_threshold)
+    {
+        std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r / 4));
+        std::iter_swap(last - 1, last - r / 4);
+        if (r > pdq_ninther_threshold)
+        {
+            std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r / 4));
+            std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r / 4));
+            std::iter_swap(last - 2, last - (1 + r / 4));
+            std::iter_swap(last - 3, last - (2 + r / 4));
+        }
+    }
+}
+
+template<class Iterator, class Compare>
+void pdqsort_loop(Iterator first, Iterator last, Compare& comp, int bad_allowed, bool leftmost)
+{
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+    while(true)
+    {
+        difference_type n = last - first;
+        if (n < pdq_insertion_sort_threshold)
+        {
+            if (leftmost) detail::insertion_sort(first, last, comp);
+            else detail::unguarded_insertion_sort(first, last, comp);
+            return;
+        }
+
+        // The pivot is the median of 3, or the pseudomedian of 9 for
+        // larger ranges, and is moved to the front
+        difference_type half = n / 2;
+        if (n > pdq_ninther_threshold)
+        {
+            detail::sort3(first, first + half, last - 1, comp);
+            detail::sort3(first + 1, first + (half - 1), last - 2, comp);
+            detail::sort3(first + 2, first + (half + 1), last - 3, comp);
+            detail::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            std::iter_swap(first, first + half);
+        }
+        else
+        {
+            detail::sort3(first + half, first, last - 1, comp);
+        }
+
+        // Many equal elements are put in place at once
+        if (!leftmost and !comp(*(first - 1), *first))
+        {
+            first = detail::partition_left(first, last, comp) + 1;
+            continue;
+        }
+
+        std::pair<Iterator, bool> part = detail::partition_right(first, last, comp);
+        Iterator pivot_pos = part.first;
+        difference_type l = pivot_pos - first;
+        difference_type r = last - (pivot_pos + 1);
+        if (l < n / 8 or r < n / 8)
+        {
+            if (--bad_allowed == 0)
+            {
+                std::make_heap(first, last, comp);
+                std::sort_heap(first, last, comp);
+                return;
+            }
+            detail::pdq_shuffle(first, pivot_pos, last);
+        }
+        else if (part.second and
+            detail::partial_insertion_sort(first, pivot_pos, comp) and
+            detail::partial_insertion_sort(pivot_pos + 1, last, comp))
+        {
+            return;
+        }
+
+        detail::pdqsort_loop(first, pivot_pos, comp, bad_allowed, leftmost);
+        first = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template<class Iterator, class Compare>
+void pdqsort(Iterator first, Iterator last, Compare& comp)
+{
+    std::size_t n = last - first;
+    int log2 = 0;
+    while(n >>= 1) log2++;
+    detail::pdqsort_loop(first, last, comp, log2 + 1, true);
+}
+
+// The unsigned integer with the same size as an arithmetic type
+template<std::size_t Size>
+struct radix_unsigned;
+
+template<>
+struct radix_unsigned<1>
+{
+    typedef std::uint8_t type;
+};
+
+template<>
+struct radix_unsigned<2>
+{
+    typedef std::uint16_t type;
+};
+
+template<>
+struct radix_unsigned<4>
+{
+    typedef std::uint32_t type;
+};
+
+template<>
+struct radix_unsigned<8>
+{
+    typedef std::uint64_t type;
+};
+
+template<class T>
+struct is_radix_sortable
+: integral_constant<bool, (
+    (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8) and (
+        (std::is_integral<T>::value and not std::is_same<T, bool>::value) or
+        (std::is_floating_point<T>::value and std::numeric_limits<T>::is_iec559)
+    )
+)>
+{};
+
+// Maps a value to an unsigned key with the same order
+template<class T, class Key>
+Key radix_key(T x, std::true_type, std::false_type)
+{
+    return Key(x);
+}
+
+template<class T, class Key>
+Key radix_key(T x, std::false_type, std::false_type)
+{
+    return Key(x) ^ (Key(1) << (sizeof(Key) * 8 - 1));
+}
+
+// Negative floating point numbers have all their bits flipped, since a
+// larger magnitude is a smaller number
+template<class T, class Key>
+Key radix_key(T x, std::false_type, std::true_type)
+{
+    Key k;
+    std::memcpy(&k, &x, sizeof(k));
+    Key sign = Key(1) << (sizeof(Key) * 8 - 1);
+    return (k & sign) ? Key(~k) : Key(k | sign);
+}
+
+template<class T, bool Descending>
+struct radix_traits
+{
+    typedef typename radix_unsigned<sizeof(T)>::type key_type;
+    // Wider digits mean fewer passes, as long as the counts of a digit
+    // stay in the cache
+    static const int digit_bits = sizeof(T) <= 2 ? 8 : 11;
+
+    static key_type key(T x)
+    {
+        key_type k = detail::radix_key<T, key_type>(x, std::is_unsigned<T>(), std::is_floating_point<T>());
+        return Descending ? key_type(~k) : k;
+    }
+};
+
+// Sorts [first, last) using a buffer of the same size, and leaves the
+// result in [first, last). The counts for every digit are taken in a
+// single pass.
+template<class T, bool Descending>
+void radix_sort(T* first, T* last, T* buffer)
+{
+    typedef radix_traits<T, Descending> traits;
+    typedef typename traits::key_type key_type;
+    static const int bits = traits::digit_bits;
+    static const std::size_t buckets = std::size_t(1) << bits;
+    static const int passes = (sizeof(T) * 8 + bits - 1) / bits;
+    std::size_t n = last - first;
+    std::unique_ptr<std::size_t[]> counts(new std::size_t[passes * buckets]());
+    for(T* p = first;p != last;++p)
+    {
+        key_type k = traits::key(*p);
+        for(int b=0;b<passes;b++) counts[b * buckets + ((k >> (bits * b)) & (buckets - 1))]++;
+    }
+    T* src = first;
+    T* dst = buffer;
+    for(int b=0;b<passes;b++)
+    {
+        std::size_t* count = counts.get() + b * buckets;
+        // Every key has the same digit here, so there is nothing to do
+        if (count[(traits::key(*src) >> (bits * b)) & (buckets - 1)] == n) continue;
+        std::size_t offset = 0;
+        for(std::size_t d=0;d<buckets;d++)
+        {
+            std::size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for(T* p = src;p != src + n;++p) dst[count[(traits::key(*p) >> (bits * b)) & (buckets - 1)]++] = *p;
+        std::swap(src, dst);
+    }
+    if (src != first) std::memcpy(static_cast<void*>(first), static_cast<const void*>(src), n * sizeof(T));
+}
+
+template<bool Descending, class T>
+bool radix_sort_buffered(T* first, T* last)
+{
+    std::unique_ptr<T[]> buffer(new(std::nothrow) T[last - first]);
+    if (!buffer) return false;
+    detail::radix_sort<T, Descending>(first, last, buffer.get());
+    return true;
+}
+
+// Other iterators are copied into a buffer that is twice as large
+template<bool Descending, class Iterator>
+bool radix_sort_buffered(Iterator first, Iterator last)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    std::size_t n = last - first;
+    std::unique_ptr<value_type[]> buffer(new(std::nothrow) value_type[2 * n]);
+    if (!buffer) return false;
+    std::copy(first, last, buffer.get());
+    detail::radix_sort<value_type, Descending>(buffer.get(), buffer.get() + n, buffer.get() + n);
+    std::copy(buffer.get(), buffer.get() + n, first);
+    return true;
+}
+
+// The order of a comparison that a radix sort can reproduce: 1 for
+// ascending, -1 for descending and 0 for any other comparison
+template<class Compare, class T>
+struct radix_order
+: std::integral_constant<int, 0>
+{};
+
+template<class T>
+struct radix_order<std::less<T>, T>
+: std::integral_constant<int, 1>
+{};
+
+template<class T>
+struct radix_order<std::less<void>, T>
+: std::integral_constant<int, 1>
+{};
+
+template<class T>
+struct radix_order<std::greater<T>, T>
+: std::integral_constant<int, -1>
+{};
+
+template<class T>
+struct radix_order<std::greater<void>, T>
+: std::integral_constant<int, -1>
+{};
+
+template<class Iterator, class Compare>
+struct sort_order
+: std::integral_constant<int, (
+    is_radix_sortable<typename std::iterator_traits<Iterator>::value_type>::value ?
+    radix_order<Compare, typename std::iterator_traits<Iterator>::value_type>::value : 0
+)>
+{};
+
+template<class Iterator, class Compare, int Order>
+void sort(Iterator first, Iterator last, Compare& comp, std::integral_constant<int, Order>)
+{
+    // A sorted range is found by the quicksort in linear time, while the
+    // radix sort would still make all its passes
+    if (last - first >= radix_sort_threshold and
+        !std::is_sorted(first, last, comp) and
+        detail::radix_sort_buffered<(Order < 0)>(first, last)) return;
+    detail::pdqsort(first, last, comp);
+}
+
+template<class Iterator, class Compare>
+void sort(Iterator first, Iterator last, Compare& comp, std::integral_constant<int, 0>)
+{
+    detail::pdqsort(first, last, comp);
+}
+
+}
+
+template<class RandomAccessIterator, class Compare, TICK_REQUIRES(
+    is_random_access_iterator<RandomAccessIterator>() and
+    is_compare<Compare, typename std::iterator_traits<RandomAccessIterator>::reference>()
+)>
+void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    detail::sort(first, last, comp, detail::sort_order<RandomAccessIterator, Compare>());
+}
+
+template<class RandomAccessIterator, TICK_REQUIRES(is_random_access_iterator<RandomAccessIterator>())>
+void sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    tick::sort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+}
+
+#endif
@@ -0,0 +1,345 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    spsc_queue.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_SPSC_QUEUE_H
+#define TICK_GUARD_SPSC_QUEUE_H
+
+/// spsc_queue
+/// ==========
+///
+/// Description
+/// -----------
+///
+/// A bounded lock free queue for one producer thread and one consumer
+/// thread, stored as a ring buffer. Pushing and popping never block or
+/// allocate: `try_push` returns false when the queue is full and `try_pop`
+/// returns false when it is empty.
+///
+/// The position written by the producer and the position written by the
+/// consumer are on separate cache lines, and each side keeps a copy of the
+/// other side's position, which it only reloads when the queue looks full
+/// or empty. So in the steady state each side only touches its own cache
+/// line and the slots.
+///
+/// `push_n` and `pop_n` move a batch of elements with a single update of
+/// the position. When the elements are
+/// [`is_trivially_copyable`](is_trivially_copyable) and the other side of
+/// the transfer is a pointer, the batch is copied with `memcpy`.
+///
+/// The capacity is rounded up to a power of two. `size` and `empty` are
+/// exact on the producer and consumer threads only when the other side is
+/// idle.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T, class Allocator=std::allocator<T>>
+///     class spsc_queue
+///     {
+///     public:
+///         explicit spsc_queue(size_type capacity, const Allocator& a=Allocator());
+///
+///         bool try_push(const T& x);
+///         bool try_push(T&& x);
+///         template<class... Ts>
+///         bool try_emplace(Ts&&... xs);
+///         template<class InputIterator>
+///         size_type push_n(InputIterator first, size_type n);
+///
+///         bool try_pop(T& x);
+///         template<class OutputIterator>
+///         size_type pop_n(OutputIterator out, size_type n);
+///
+///         size_type size() const;
+///         bool empty() const;
+///         size_type capacity() const;
+///     };
+///
+/// Example
+/// -------
+///
+///     tick::spsc_queue<int> q(1024);
+///     // On the producer
+///     while(!q.try_push(42)) {}
+///     // On the consumer
+///     int x;
+///     while(!q.try_pop(x)) {}
+///
+
+#include <tick/detail/cache_line.h>
+#include <tick/detail/ring_buffer.h>
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_copy_constructible.h>
+#include <tick/traits/is_input_iterator.h>
+#include <tick/traits/is_iterator.h>
+#include <tick/traits/is_move_assignable.h>
+#include <tick/traits/is_move_constructible.h>
+#include <tick/traits/is_trivially_copyable.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace tick {
+
+namespace detail {
+
+// Whether a batch can be copied between a ring of `T` and the iterator
+// with `memcpy`
+template<class T, class Iterator>
+struct is_memcpy_transfer
+: integral_constant<bool, (
+    std::is_pointer<Iterator>::value and
+    std::is_same<typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type, T>::value and
+    is_trivially_copyable<T>::value
+)>
+{};
+
+}
+
+template<class T, class Allocator=std::allocator<T>>
+class spsc_queue
+{
+    typedef std::allocator_traits<Allocator> alloc_traits;
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename alloc_traits::size_type size_type;
+
+    explicit spsc_queue(size_type capacity, const Allocator& a=Allocator())
+    : m(a, detail::ring_capacity(capacity, "spsc_queue"))
+    {
+        m.buffer = alloc_traits::allocate(this->alloc(), m.mask + 1);
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue()
+    {
+        for(size_type i = c.head.load(std::memory_order_relaxed);i != p.tail.load(std::memory_order_relaxed);i++)
+            alloc_traits::destroy(this->alloc(), this->slot(i));
+        alloc_traits::deallocate(this->alloc(), m.buffer, m.mask + 1);
+    }
+
+    allocator_type get_allocator() const
+    {
+        return this->alloc();
+    }
+
+    TICK_MEMBER_REQUIRES(is_copy_constructible<T>())
+    bool try_push(const T& x)
+    {
+        return this->try_emplace(x);
+    }
+
+    TICK_MEMBER_REQUIRES(is_move_constructible<T>())
+    bool try_push(T&& x)
+    {
+        return this->try_emplace(std::move(x));
+    }
+
+    template<class... Ts, TICK_REQUIRES(std::is_constructible<T, Ts&&...>::value)>
+    bool try_emplace(Ts&&... xs)
+    {
+        size_type tail = p.tail.load(std::memory_order_relaxed);
+        if (this->free_slots(tail) == 0) return false;
+        alloc_traits::construct(this->alloc(), this->slot(tail), std::forward<Ts>(xs)...);
+        p.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pushes up to `n` elements from `first`, and returns how many were
+    // pushed
+    template<class InputIterator, TICK_REQUIRES(
+        is_input_iterator<InputIterator>() and
+        std::is_constructible<T, typename std::iterator_traits<InputIterator>::reference>::value
+    )>
+    size_type push_n(InputIterator first, size_type n)
+    {
+        size_type tail = p.tail.load(std::memory_order_relaxed);
+        n = std::min(n, this->free_slots(tail, n));
+        if (n > 0) this->push_batch(first, tail, n, detail::is_memcpy_transfer<T, InputIterator>());
+        return n;
+    }
+
+    TICK_MEMBER_REQUIRES(is_move_assignable<T>())
+    bool try_pop(T& x)
+    {
+        size_type head = c.head.load(std::memory_order_relaxed);
+        if (this->ready_slots(head) == 0) return false;
+        T* s = this->slot(head);
+        x = std::move(*s);
+        alloc_traits::destroy(this->alloc(), s);
+        c.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pops up to `n` elements into `out`, and returns how many were popped
+    template<class OutputIterator, TICK_REQUIRES(
+        is_iterator<OutputIterator>() and
+        std::is_assignable<decltype(*std::declval<OutputIterator&>()), T&&>::value
+    )>
+    size_type pop_n(OutputIterator out, size_type n)
+    {
+        size_type head = c.head.load(std::memory_order_relaxed);
+        n = std::min(n, this->ready_slots(head, n));
+        if (n > 0) this->pop_batch(out, head, n, detail::is_memcpy_transfer<T, OutputIterator>());
+        return n;
+    }
+
+    size_type size() const
+    {
+        // The head is loaded first, so it can not be past the tail
+        size_type head = c.head.load(std::memory_order_acquire);
+        return p.tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool empty() const
+    {
+        return this->size() == 0;
+    }
+
+    size_type capacity() const
+    {
+        return m.mask + 1;
+    }
+
+private:
+    struct impl : Allocator
+    {
+        impl(const Allocator& a, size_type capacity) : Allocator(a), buffer(nullptr), mask(capacity - 1)
+        {}
+        T* buffer;
+        size_type mask;
+    };
+    impl m;
+
+    // Written by the producer
+    struct alignas(detail::cache_line_size) producer
+    {
+        producer() : tail(0), cached_head(0)
+        {}
+        std::atomic<size_type> tail;
+        size_type cached_head;
+    };
+    producer p;
+
+    // Written by the consumer
+    struct alignas(detail::cache_line_size) consumer
+    {
+        consumer() : head(0), cached_tail(0)
+        {}
+        std::atomic<size_type> head;
+        size_type cached_tail;
+    };
+    consumer c;
+
+    Allocator& alloc()
+    {
+        return m;
+    }
+
+    const Allocator& alloc() const
+    {
+        return m;
+    }
+
+    T* slot(size_type i) const
+    {
+        return m.buffer + (i & m.mask);
+    }
+
+    // The number of free slots, reloading the consumer's position only when
+    // fewer than `wanted` are known to be free
+    size_type free_slots(size_type tail, size_type wanted = 1)
+    {
+        size_type n = this->capacity() - (tail - p.cached_head);
+        if (n >= wanted) return n;
+        p.cached_head = c.head.load(std::memory_order_acquire);
+        return this->capacity() - (tail - p.cached_head);
+    }
+
+    size_type ready_slots(size_type head, size_type wanted = 1)
+    {
+        size_type n = c.cached_tail - head;
+        if (n >= wanted) return n;
+        c.cached_tail = p.tail.load(std::memory_order_acquire);
+        return c.cached_tail - head;
+    }
+
+    // The number of slots from `i` to the end of the buffer
+    size_type contiguous(size_type i) const
+    {
+        return this->capacity() - (i & m.mask);
+    }
+
+    template<class Iterator>
+    void push_batch(Iterator first, size_type tail, size_type n, true_type)
+    {
+        size_type k = std::min(n, this->contiguous(tail));
+        std::memcpy(static_cast<void*>(this->slot(tail)), first, k * sizeof(T));
+        std::memcpy(static_cast<void*>(this->slot(tail + k)), first + k, (n - k) * sizeof(T));
+        p.tail.store(tail + n, std::memory_order_release);
+    }
+
+    // If a constructor throws, the elements constructed before it are
+    // still pushed
+    template<class Iterator>
+    void push_batch(Iterator first, size_type tail, size_type n, false_type)
+    {
+        size_type i = 0;
+        try
+        {
+            for(;i < n;++i, ++first) alloc_traits::construct(this->alloc(), this->slot(tail + i), *first);
+        }
+        catch(...)
+        {
+            p.tail.store(tail + i, std::memory_order_release);
+            throw;
+        }
+        p.tail.store(tail + n, std::memory_order_release);
+    }
+
+    template<class Iterator>
+    void pop_batch(Iterator out, size_type head, size_type n, true_type)
+    {
+        size_type k = std::min(n, this->contiguous(head));
+        std::memcpy(out, this->slot(head), k * sizeof(T));
+        std::memcpy(out + k, this->slot(head + k), (n - k) * sizeof(T));
+        c.head.store(head + n, std::memory_order_release);
+    }
+
+    template<class Iterator>
+    void pop_batch(Iterator out, size_type head, size_type n, false_type)
+    {
+        size_type i = 0;
+        try
+        {
+            for(;i < n;++i, ++out)
+            {
+                T* s = this->slot(head + i);
+                *out = std::move(*s);
+                alloc_traits::destroy(this->alloc(), s);
+            }
+        }
+        catch(...)
+        {
+            c.head.store(head + i, std::memory_order_release);
+            throw;
+        }
+        c.head.store(head + n, std::memory_order_release);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,496 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    task.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_TASK_H
+#define TICK_GUARD_TASK_H
+
+/// task
+/// ====
+///
+/// Description
+/// -----------
+///
+/// A lazy coroutine that produces a value of type `T`, or nothing when `T`
+/// is `void`. Calling the coroutine only creates it, and it starts running
+/// when it is awaited with `co_await`. When it finishes, the awaiting
+/// coroutine is resumed through symmetric transfer: the finishing coroutine
+/// hands over to the awaiting one instead of returning to a caller, so a
+/// long chain of tasks that finish without suspending runs in constant
+/// stack space. This relies on the compiler making the transfer a tail
+/// call, which GCC only does when optimizing. `sync_wait` runs a task from
+/// a function that is not a coroutine, and blocks until it has finished.
+///
+/// A task is awaited at most once, as an rvalue, and the result is moved
+/// out. An exception that escapes the coroutine is thrown again from the
+/// `co_await` expression.
+///
+/// The coroutine frame is allocated with `::operator new` by default. When
+/// the first parameter of the coroutine is `std::allocator_arg`, or the
+/// second one for a member function, and the parameter after it satisfies
+/// [`is_allocator`](is_allocator), the frame is allocated with that
+/// allocator instead. A copy of the allocator is kept at the end of the
+/// frame to free it. With an [`arena_allocator`](arena), creating a task
+/// then no longer allocates from the heap.
+///
+/// GCC 11 and later warn with `-Wmismatched-new-delete` in such a coroutine
+/// when not optimizing, since the frame is allocated with a template
+/// `operator new` and freed with the usual `operator delete`. The frame is
+/// freed correctly, and since GCC reports it where the coroutine is
+/// defined, it can only be turned off around the coroutine.
+///
+/// This needs C++20 coroutines, and is empty without them.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T=void>
+///     class task
+///     {
+///     public:
+///         task() noexcept;
+///         task(task&& rhs) noexcept;
+///         task& operator=(task&& rhs) noexcept;
+///
+///         bool is_ready() const noexcept;
+///
+///         // Awaits the result
+///         awaiter operator co_await() && noexcept;
+///         // Awaits the task to finish, without taking the result
+///         awaiter when_ready() const noexcept;
+///     };
+///
+///     template<class T>
+///     T sync_wait(task<T> t);
+///
+/// Example
+/// -------
+///
+///     tick::task<int> parse(std::allocator_arg_t, tick::arena_allocator<char>, const std::string& s)
+///     {
+///         co_return std::stoi(s);
+///     }
+///
+///     tick::task<int> sum(tick::arena& a, const std::vector<std::string>& v)
+///     {
+///         int result = 0;
+///         for(const std::string& s:v)
+///             result += co_await parse(std::allocator_arg, tick::arena_allocator<char>(a), s);
+///         co_return result;
+///     }
+///
+///     tick::arena a;
+///     int n = tick::sync_wait(sum(a, { "1", "2", "3" }));
+///
+
+#include <tick/detail/coroutine.h>
+
+#if TICK_HAS_COROUTINES
+
+#include <tick/integral_constant.h>
+#include <tick/requires.h>
+#include <tick/traits/is_allocator.h>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace tick {
+
+template<class T=void>
+class task;
+
+namespace detail {
+
+typedef void (*task_frame_free)(void* frame, std::size_t size);
+
+constexpr std::size_t task_frame_align(std::size_t n, std::size_t alignment)
+{
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+// The unit the frames are allocated in, so that they are aligned like
+// memory from `::operator new`
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) task_frame_block
+{
+    unsigned char bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+};
+
+// A frame is laid out as the frame itself, then the function that frees
+// it, then the allocator it was allocated with
+template<class Allocator>
+struct task_frame_allocator
+{
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<task_frame_block> block_allocator;
+    typedef std::allocator_traits<block_allocator> block_traits;
+    static_assert(alignof(block_allocator) <= alignof(task_frame_block), "The allocator is over aligned");
+
+    static std::size_t free_offset(std::size_t n)
+    {
+        return task_frame_align(n, alignof(task_frame_free));
+    }
+
+    static std::size_t allocator_offset(std::size_t n)
+    {
+        return task_frame_align(free_offset(n) + sizeof(task_frame_free), alignof(block_allocator));
+    }
+
+    static std::size_t blocks(std::size_t n)
+    {
+        return (allocator_offset(n) + sizeof(block_allocator) + sizeof(task_frame_block) - 1) / sizeof(task_frame_block);
+    }
+
+    static void* allocate(const Allocator& a, std::size_t n)
+    {
+        block_allocator ba(a);
+        unsigned char* frame = reinterpret_cast<unsigned char*>(block_traits::allocate(ba, blocks(n)));
+        ::new(static_cast<void*>(frame + free_offset(n))) task_frame_free(&task_frame_allocator::deallocate);
+        ::new(static_cast<void*>(frame + allocator_offset(n))) block_allocator(std::move(ba));
+        return frame;
+    }
+
+    static void deallocate(void* p, std::size_t n)
+    {
+        unsigned char* frame = static_cast<unsigned char*>(p);
+        block_allocator& stored = *reinterpret_cast<block_allocator*>(frame + allocator_offset(n));
+        block_allocator ba(std::move(stored));
+        stored.~block_allocator();
+        block_traits::deallocate(ba, reinterpret_cast<task_frame_block*>(frame), blocks(n));
+    }
+};
+
+inline void task_frame_deallocate(void* p, std::size_t n)
+{
+    unsigned char* frame = static_cast<unsigned char*>(p);
+    task_frame_free f = *reinterpret_cast<task_frame_free*>(frame + task_frame_align(n, alignof(task_frame_free)));
+    f(p, n);
+}
+
+class task_promise_base
+{
+    struct final_awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        // Resuming the continuation from here, rather than returning to
+        // the caller of `resume`, is what keeps the stack from growing
+        template<class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+        {
+            return h.promise().continuation;
+        }
+
+        void await_resume() const noexcept
+        {}
+    };
+public:
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    final_awaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    static void* operator new(std::size_t n)
+    {
+        return task_frame_allocator<std::allocator<char>>::allocate(std::allocator<char>(), n);
+    }
+
+    template<class Allocator, class... Ts, TICK_REQUIRES(is_allocator<Allocator>())>
+    static void* operator new(std::size_t n, std::allocator_arg_t, const Allocator& a, const Ts&...)
+    {
+        return task_frame_allocator<Allocator>::allocate(a, n);
+    }
+
+    template<class This, class Allocator, class... Ts, TICK_REQUIRES(is_allocator<Allocator>())>
+    static void* operator new(std::size_t n, const This&, std::allocator_arg_t, const Allocator& a, const Ts&...)
+    {
+        return task_frame_allocator<Allocator>::allocate(a, n);
+    }
+
+    static void operator delete(void* p, std::size_t n) noexcept
+    {
+        task_frame_deallocate(p, n);
+    }
+};
+
+template<class T>
+class task_promise : public task_promise_base
+{
+    std::variant<std::monostate, T, std::exception_ptr> result;
+public:
+    task<T> get_return_object() noexcept;
+
+    template<class U=T, TICK_REQUIRES(std::is_constructible<T, U&&>::value)>
+    void return_value(U&& x)
+    {
+        result.template emplace<1>(std::forward<U>(x));
+    }
+
+    void unhandled_exception() noexcept
+    {
+        result.template emplace<2>(std::current_exception());
+    }
+
+    T get()
+    {
+        if (result.index() == 2) std::rethrow_exception(std::get<2>(result));
+        return std::move(std::get<1>(result));
+    }
+};
+
+template<>
+class task_promise<void> : public task_promise_base
+{
+    std::exception_ptr error;
+public:
+    task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept
+    {}
+
+    void unhandled_exception() noexcept
+    {
+        error = std::current_exception();
+    }
+
+    void get()
+    {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// Notifies under the lock, so the waiting thread can not return and
+// destroy the event before `set` is done with it
+class sync_wait_event
+{
+    std::mutex m;
+    std::condition_variable cv;
+    bool done = false;
+public:
+    void set()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        done = true;
+        cv.notify_one();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return done; });
+    }
+};
+
+// The coroutine that awaits the task for `sync_wait`, and sets the event
+// once the task has finished
+class sync_wait_task
+{
+public:
+    class promise_type
+    {
+        struct notifier
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+            {
+                h.promise().event->set();
+            }
+
+            void await_resume() const noexcept
+            {}
+        };
+    public:
+        sync_wait_event* event = nullptr;
+
+        sync_wait_task get_return_object() noexcept
+        {
+            return sync_wait_task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        notifier final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept
+        {}
+
+        // The task keeps its own exception, so none can get here
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    sync_wait_task(const sync_wait_task&) = delete;
+    sync_wait_task& operator=(const sync_wait_task&) = delete;
+
+    ~sync_wait_task()
+    {
+        h.destroy();
+    }
+
+    void run(sync_wait_event& e)
+    {
+        h.promise().event = &e;
+        h.resume();
+        e.wait();
+    }
+
+private:
+    explicit sync_wait_task(std::coroutine_handle<promise_type> x) : h(x)
+    {}
+    std::coroutine_handle<promise_type> h;
+};
+
+template<class Awaitable>
+sync_wait_task make_sync_wait_task(Awaitable a)
+{
+    co_await std::move(a);
+}
+
+}
+
+template<class T>
+class task
+{
+    static_assert(std::is_void<T>::value or std::is_object<T>::value, "The result of a task must be void or an object type");
+public:
+    typedef T value_type;
+    typedef detail::task_promise<T> promise_type;
+private:
+    typedef std::coroutine_handle<promise_type> handle_type;
+
+    template<bool TakeResult>
+    struct awaiter
+    {
+        handle_type h;
+
+        bool await_ready() const noexcept
+        {
+            return h.done();
+        }
+
+        // Starts the task, and has it resume the awaiting coroutine when it
+        // finishes
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) const noexcept
+        {
+            h.promise().continuation = continuation;
+            return h;
+        }
+
+        typename std::conditional<TakeResult, T, void>::type await_resume() const
+        {
+            return this->result(integral_constant<bool, TakeResult>());
+        }
+
+        T result(true_type) const
+        {
+            return h.promise().get();
+        }
+
+        void result(false_type) const noexcept
+        {}
+    };
+public:
+    task() noexcept : h(nullptr)
+    {}
+
+    task(task&& rhs) noexcept : h(std::exchange(rhs.h, nullptr))
+    {}
+
+    task& operator=(task&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            if (h) h.destroy();
+            h = std::exchange(rhs.h, nullptr);
+        }
+        return *this;
+    }
+
+    ~task()
+    {
+        if (h) h.destroy();
+    }
+
+    bool is_ready() const noexcept
+    {
+        return !h or h.done();
+    }
+
+    awaiter<true> operator co_await() && noexcept
+    {
+        return awaiter<true>{ h };
+    }
+
+    awaiter<false> when_ready() const noexcept
+    {
+        return awaiter<false>{ h };
+    }
+
+private:
+    friend promise_type;
+    template<class U>
+    friend U sync_wait(task<U> t);
+
+    explicit task(handle_type x) noexcept : h(x)
+    {}
+    handle_type h;
+};
+
+template<class T>
+task<T> detail::task_promise<T>::get_return_object() noexcept
+{
+    return task<T>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+inline task<void> detail::task_promise<void>::get_return_object() noexcept
+{
+    return task<void>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+// Runs the task on this thread until it first suspends, and then waits for
+// whichever thread resumes it to finish it
+template<class T>
+T sync_wait(task<T> t)
+{
+    detail::sync_wait_event e;
+    {
+        detail::sync_wait_task w = detail::make_sync_wait_task(t.when_ready());
+        w.run(e);
+    }
+    return t.h.promise().get();
+}
+
+}
+
+#endif
+
+#endif
@@ -10,10 +10,18 @@
 
 #include <tick/traits/bare.h>
 #include <tick/traits/is_allocator.h>
+#include <tick/traits/is_always_equal_allocator.h>
 #include <tick/traits/is_associative_container.h>
+#include <tick/traits/is_awaitable.h>
+#include <tick/traits/is_awaiter.h>
+#include <tick/traits/is_basic_lockable.h>
 #include <tick/traits/is_bidirectional_iterator.h>
+#include <tick/traits/is_binary_operation.h>
+#include <tick/traits/is_bitwise_comparable.h>
 #include <tick/traits/is_compare.h>
 #include <tick/traits/is_container.h>
+#include <tick/traits/is_contiguous_iterator.h>
+#include <tick/traits/is_coroutine_handle.h>
 #include <tick/traits/is_copy_assignable.h>
 #include <tick/traits/is_copy_constructible.h>
 #include <tick/traits/is_copy_insertable.h>
@@ -23,28 +31,46 @@
 #include <tick/traits/is_equality_comparable.h>
 #include <tick/traits/is_erasable.h>
 #include <tick/traits/is_forward_iterator.h>
+#include <tick/traits/is_hash.h>
+#include <tick/traits/is_hashable.h>
 #include <tick/traits/is_input_iterator.h>
 #include <tick/traits/is_iterator.h>
 #include <tick/traits/is_less_than_comparable.h>
+#include <tick/traits/is_lock_free_atomic.h>
+#include <tick/traits/is_lockable.h>
 #include <tick/traits/is_move_assignable.h>
 #include <tick/traits/is_move_constructible.h>
 #include <tick/traits/is_move_insertable.h>
 #include <tick/traits/is_mutable_bidirectional_iterator.h>
 #include <tick/traits/is_mutable_forward_iterator.h>
 #include <tick/traits/is_mutable_random_access_iterator.h>
+#include <tick/traits/is_nothrow_destructible.h>
+#include <tick/traits/is_nothrow_move_assignable.h>
+#include <tick/traits/is_nothrow_move_constructible.h>
+#include <tick/traits/is_nothrow_swappable.h>
 #include <tick/traits/is_nullable_pointer.h>
 #include <tick/traits/is_output_iterator.h>
 #include <tick/traits/is_pod.h>
 #include <tick/traits/is_predicate.h>
+#include <tick/traits/is_propagating_allocator.h>
 #include <tick/traits/is_random_access_iterator.h>
 #include <tick/traits/is_range.h>
+#include <tick/traits/is_reservable.h>
 #include <tick/traits/is_reversible_container.h>
+#include <tick/traits/is_segmented_iterator.h>
 #include <tick/traits/is_sequence_container.h>
+#include <tick/traits/is_shared_lockable.h>
+#include <tick/traits/is_size_feedback_allocator.h>
+#include <tick/traits/is_sized_range.h>
 #include <tick/traits/is_standard_layout.h>
 #include <tick/traits/is_swappable.h>
+#include <tick/traits/is_timed_lockable.h>
 #include <tick/traits/is_totally_ordered.h>
 #include <tick/traits/is_trivial.h>
 #include <tick/traits/is_trivially_copyable.h>
+#include <tick/traits/is_trivially_destructible.h>
+#include <tick/traits/is_trivially_relocatable.h>
+#include <tick/traits/is_unordered_associative_container.h>
 #include <tick/traits/is_value_swappable.h>
 #include <tick/traits/is_weakly_ordered.h>
 
@@ -0,0 +1,67 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_always_equal_allocator.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_ALWAYS_EQUAL_ALLOCATOR_H
+#define TICK_GUARD_IS_ALWAYS_EQUAL_ALLOCATOR_H
+
+/// is_always_equal_allocator
+/// =========================
+/// 
+/// Description
+/// -----------
+/// 
+/// An allocator where any two instances compare equal, so memory allocated
+/// by one can always be deallocated by another. A container can then skip
+/// comparing allocators on move assignment and swap.
+/// 
+/// This uses `A::is_always_equal` when it is present, otherwise an empty
+/// allocator is always equal, just like `std::allocator_traits`.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_always_equal_allocator, is_allocator<_>)
+///     {
+///         template<class A>
+///         auto require(const A&) -> valid<
+///             is_true<typename A::is_always_equal> // or std::is_empty<A>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_allocator.h>
+
+namespace tick {
+
+namespace detail {
+
+template<class A, class=void>
+struct allocator_is_always_equal
+: integral_constant<bool, std::is_empty<A>::value>
+{};
+
+template<class A>
+struct allocator_is_always_equal<A, typename holder<
+    typename A::is_always_equal
+>::type>
+: integral_constant<bool, A::is_always_equal::value>
+{};
+
+}
+
+TICK_TRAIT(is_always_equal_allocator, is_allocator<_>)
+{
+    template<class A>
+    auto require(const A&) -> valid<
+        is_true<detail::allocator_is_always_equal<A>>
+    >;
+};
+
+}
+
+#endif
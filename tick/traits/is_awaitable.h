@@ -0,0 +1,103 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_awaitable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_AWAITABLE_H
+#define TICK_GUARD_IS_AWAITABLE_H
+
+/// is_awaitable
+/// ============
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if a value of the type can be the operand of `co_await` in a
+/// coroutine whose promise has no `await_transform`. The awaiter is the
+/// result of a member `operator co_await` if there is one, otherwise of a
+/// free `operator co_await` if there is one, otherwise the value itself.
+/// 
+/// This needs C++20 coroutines, and is always false without them.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `T` satisfies `is_awaitable` if, given:
+/// 
+/// * `x`, a value of type `T`
+/// * `awaiter(x)`, the result of `x.operator co_await()`, or
+///   `operator co_await(x)`, or `x` itself, as described above
+/// 
+/// +--------------------+-------------------------------------------------+
+/// | Expression         | Requirement                                     |
+/// +====================+=================================================+
+/// | `awaiter(x)`       | satisfies [`is_awaiter`](is_awaiter)            |
+/// +--------------------+-------------------------------------------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_awaitable)
+///     {
+///         template<class T>
+///         auto require(T&& x) -> valid<
+///             is_true<is_awaiter<decltype(awaiter(std::forward<T>(x)))>>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/detail/coroutine.h>
+#include <tick/traits/is_awaiter.h>
+#include <utility>
+
+namespace tick {
+
+#if TICK_HAS_COROUTINES
+
+namespace detail {
+
+template<int N>
+struct awaiter_rank : awaiter_rank<N-1>
+{};
+
+template<>
+struct awaiter_rank<0>
+{};
+
+template<class T>
+auto get_awaiter(T&& x, awaiter_rank<2>) -> decltype(std::forward<T>(x).operator co_await());
+
+template<class T>
+auto get_awaiter(T&& x, awaiter_rank<1>) -> decltype(operator co_await(std::forward<T>(x)));
+
+template<class T>
+auto get_awaiter(T&& x, awaiter_rank<0>) -> T&&;
+
+}
+
+TICK_TRAIT(is_awaitable)
+{
+    template<class T>
+    auto require(T&& x) -> valid<
+        is_true<is_awaiter<decltype(detail::get_awaiter(std::forward<T>(x), detail::awaiter_rank<2>()))>>
+    >;
+};
+
+#else
+
+TICK_TRAIT(is_awaitable)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true_c<false and sizeof(T) != 0>
+    >;
+};
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_awaiter.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_AWAITER_H
+#define TICK_GUARD_IS_AWAITER_H
+
+/// is_awaiter
+/// ==========
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the type can be the awaiter of a `co_await` expression, which
+/// is what `co_await` calls to decide whether to suspend the coroutine and
+/// what value to produce. The handle type `H` passed to `await_suspend`
+/// defaults to `std::coroutine_handle<>`, which any coroutine handle
+/// converts to.
+/// 
+/// The default handle is only available with C++20 coroutines. Without them,
+/// `is_awaiter<A>` is false, but `is_awaiter<A, H>` can still be checked for
+/// a handle type `H`.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `A` satisfies `is_awaiter<A, H>` if
+/// 
+/// * The type `H` satisfies [`is_coroutine_handle`](is_coroutine_handle)
+/// 
+/// And, given:
+/// 
+/// * `a`, an lvalue of type `A`
+/// * `h`, a value of type `H`
+/// 
+/// +---------------------+------------------------------------------------------------------------------------------------+
+/// | Expression          | Return type                                                                                    |
+/// +=====================+================================================================================================+
+/// | `a.await_ready()`   | implicitly convertible to `bool`                                                               |
+/// +---------------------+------------------------------------------------------------------------------------------------+
+/// | `a.await_suspend(h)`| `void`, `bool` or a type that satisfies [`is_coroutine_handle`](is_coroutine_handle)           |
+/// +---------------------+------------------------------------------------------------------------------------------------+
+/// | `a.await_resume()`  |                                                                                                |
+/// +---------------------+------------------------------------------------------------------------------------------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_awaiter)
+///     {
+///         template<class A>
+///         auto require(A&& a) -> valid<
+///             decltype(require(std::forward<A>(a), std::declval<std::coroutine_handle<>>()))
+///         >;
+///     
+///         template<class A, class H>
+///         auto require(A&& a, H&& h) -> valid<
+///             is_true<is_coroutine_handle<H>>,
+///             decltype(returns<bool>(a.await_ready())),
+///             is_true<is_await_suspend_result<decltype(a.await_suspend(h))>>,
+///             decltype(a.await_resume())
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/detail/coroutine.h>
+#include <tick/integral_constant.h>
+#include <tick/traits/is_coroutine_handle.h>
+#include <type_traits>
+
+namespace tick {
+
+namespace detail {
+
+// What `await_suspend` may return: void or true to stay suspended, false
+// to resume at once, or a handle to resume next
+template<class R>
+struct is_await_suspend_result
+: integral_constant<bool, (
+    std::is_void<R>::value or
+    std::is_same<R, bool>::value or
+    is_coroutine_handle<typename std::conditional<std::is_void<R>::value, int, R>::type>::value
+)>
+{};
+
+}
+
+TICK_TRAIT(is_awaiter)
+{
+    template<class A, class H>
+    static auto req_impl(A&& a, H&& h) -> valid<
+        is_true<is_coroutine_handle<typename std::decay<H>::type>>,
+        TICK_RETURNS(a.await_ready(), bool),
+        is_true<detail::is_await_suspend_result<decltype(a.await_suspend(h))>>,
+        decltype(a.await_resume())
+    >;
+
+#if TICK_HAS_COROUTINES
+    template<class A>
+    auto require(A&& a) -> valid<
+        decltype(req_impl(std::forward<A>(a), std::declval<std::coroutine_handle<>>()))
+    >;
+#endif
+
+    template<class A, class H>
+    auto require(A&& a, H&& h) -> valid<
+        decltype(req_impl(std::forward<A>(a), std::forward<H>(h)))
+    >;
+};
+
+}
+
+#endif
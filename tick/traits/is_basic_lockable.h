@@ -0,0 +1,65 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_basic_lockable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_BASIC_LOCKABLE_H
+#define TICK_GUARD_IS_BASIC_LOCKABLE_H
+
+/// is_basic_lockable
+/// =================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the type provides exclusive blocking ownership for an execution
+/// agent, as required by `std::lock_guard`.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `L` satisfies `is_basic_lockable` if
+/// 
+/// Given:
+/// 
+/// * `m`, a value of type `L`
+/// 
+/// +--------------+-------------+
+/// | Expression   | Return type |
+/// +==============+=============+
+/// | `m.lock()`   |             |
+/// +--------------+-------------+
+/// | `m.unlock()` |             |
+/// +--------------+-------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_basic_lockable)
+///     {
+///         template<class L>
+///         auto require(L& m) -> valid<
+///             decltype(m.lock()),
+///             decltype(m.unlock())
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+
+namespace tick {
+
+TICK_TRAIT(is_basic_lockable)
+{
+    template<class L>
+    auto require(L&& m) -> valid<
+        decltype(m.lock()),
+        decltype(m.unlock())
+    >;
+};
+
+}
+
+#endif
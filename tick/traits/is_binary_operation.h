@@ -0,0 +1,61 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_binary_operation.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_BINARY_OPERATION_H
+#define TICK_GUARD_IS_BINARY_OPERATION_H
+
+/// is_binary_operation
+/// ===================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the function combines two values of a type into another value
+/// of that type, as `std::plus<T>` does. This is what is needed of the
+/// operation of a fold or a reduction.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `F` satisfies `is_binary_operation<F, T>` if, given:
+/// 
+/// * `f`, a value of type `F`
+/// * `x`, `y`, values of type `const T`
+/// 
+/// +------------+-------------------------------+
+/// | Expression | Return type                   |
+/// +============+===============================+
+/// | `f(x, y)`  | implicitly convertible to `T` |
+/// +------------+-------------------------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_binary_operation)
+///     {
+///         template<class F, class T>
+///         auto require(F&& f, const T& x) -> valid<
+///             decltype(returns<T>(f(x, x)))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+
+namespace tick {
+
+TICK_TRAIT(is_binary_operation)
+{
+    template<class F, class T>
+    auto require(F&& f, const T& x) -> valid<
+        TICK_RETURNS(f(x, x), T)
+    >;
+};
+
+}
+
+#endif
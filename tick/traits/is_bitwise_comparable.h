@@ -0,0 +1,78 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_bitwise_comparable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_BITWISE_COMPARABLE_H
+#define TICK_GUARD_IS_BITWISE_COMPARABLE_H
+
+/// is_bitwise_comparable
+/// =====================
+///
+/// Description
+/// -----------
+///
+/// If two objects of a type are equal exactly when their bytes are equal,
+/// so they can be compared with `memcmp` and hashed from their raw bytes.
+/// This requires that the type has no padding and that every value has a
+/// single representation.
+///
+/// Integers, enumerations and pointers are bitwise comparable, as are
+/// arrays, `std::array` and `std::pair` of bitwise comparable types without
+/// padding. Floating point types are not, since `0.0 == -0.0` and a NaN is
+/// not equal to itself. Other types can opt in by specializing the trait:
+///
+///     namespace tick {
+///     template<>
+///     struct is_bitwise_comparable<key128>
+///     : true_type
+///     {};
+///     }
+///
+/// Synopsis
+/// --------
+///
+///     template<class T>
+///     struct is_bitwise_comparable;
+///
+
+#include <tick/builder.h>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace tick {
+
+template<class T>
+struct is_bitwise_comparable
+: integral_constant<bool, (
+    std::is_integral<T>::value or
+    std::is_enum<T>::value or
+    std::is_pointer<T>::value
+)>
+{};
+
+template<class T, std::size_t N>
+struct is_bitwise_comparable<T[N]>
+: is_bitwise_comparable<T>
+{};
+
+template<class T, std::size_t N>
+struct is_bitwise_comparable<std::array<T, N>>
+: integral_constant<bool, (is_bitwise_comparable<T>::value and sizeof(std::array<T, N>) == N * sizeof(T))>
+{};
+
+template<class T, class U>
+struct is_bitwise_comparable<std::pair<T, U>>
+: integral_constant<bool, (
+    is_bitwise_comparable<T>::value and
+    is_bitwise_comparable<U>::value and
+    sizeof(std::pair<T, U>) == sizeof(T) + sizeof(U)
+)>
+{};
+
+}
+
+#endif
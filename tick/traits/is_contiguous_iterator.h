@@ -0,0 +1,117 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_contiguous_iterator.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_CONTIGUOUS_ITERATOR_H
+#define TICK_GUARD_IS_CONTIGUOUS_ITERATOR_H
+
+/// is_contiguous_iterator
+/// ======================
+///
+/// Description
+/// -----------
+///
+/// A contiguous iterator is a random access iterator whose elements are
+/// stored next to each other in memory, so a range of them can be used
+/// through a plain pointer, such as to copy it with `std::memcpy` or to
+/// pass it to a C function.
+///
+/// An iterator is made contiguous by specializing
+/// `tick::contiguous_iterator_traits`. Specializations are provided for
+/// pointers, for the iterators of `std::vector` and `std::basic_string`
+/// with libstdc++, and, from C++20, for every iterator whose
+/// `iterator_concept` is `std::contiguous_iterator_tag`.
+///
+/// Requirements
+/// ------------
+///
+/// The type `It` satisfies `is_contiguous_iterator` if
+///
+/// * The type `It` satisfies [`is_random_access_iterator`](is_random_access_iterator)
+///
+/// And, given
+///
+/// * `Traits`, the type `contiguous_iterator_traits<It>`
+/// * `pointer`, the type `std::add_pointer<std::iterator_traits<It>::reference>::type`
+/// * `i`, a dereferenceable value of type `It` or `const It`
+/// * `n`, a value of type `std::iterator_traits<It>::difference_type` such that `i + n` is valid
+///
+/// +-------------------------+-------------+----------------------------------------------------------------------------------------+
+/// | Expression              | Return type | Description                                                                            |
+/// +=========================+=============+========================================================================================+
+/// | `Traits::to_address(i)` | `pointer`   | Equal to `std::addressof(*i)`, and `to_address(i) + n` is equal to `to_address(i + n)` |
+/// +-------------------------+-------------+----------------------------------------------------------------------------------------+
+///
+/// Synopsis
+/// --------
+///
+///     template<class Iterator>
+///     struct contiguous_iterator_traits;
+///
+///     TICK_TRAIT(is_contiguous_iterator, is_random_access_iterator<_>)
+///     {
+///         template<class I>
+///         auto require(const I& i) -> valid<
+///             decltype(returns<typename std::add_pointer<typename std::iterator_traits<I>::reference>::type>(contiguous_iterator_traits<I>::to_address(i)))
+///         >;
+///     };
+///
+
+#include <tick/builder.h>
+#include <tick/traits/is_random_access_iterator.h>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace tick {
+
+template<class Iterator, class=void>
+struct contiguous_iterator_traits
+{};
+
+template<class T>
+struct contiguous_iterator_traits<T*>
+{
+    static T* to_address(T* p)
+    {
+        return p;
+    }
+};
+
+#if __cplusplus > 201703L && defined(__cpp_lib_concepts)
+template<class Iterator>
+struct contiguous_iterator_traits<Iterator, typename std::enable_if<
+    std::is_base_of<std::contiguous_iterator_tag, typename Iterator::iterator_concept>::value
+>::type>
+{
+    static auto to_address(const Iterator& i) -> decltype(std::to_address(i))
+    {
+        return std::to_address(i);
+    }
+};
+#elif defined(__GLIBCXX__)
+// Only used by the containers that store their elements contiguously
+template<class T, class Container>
+struct contiguous_iterator_traits<__gnu_cxx::__normal_iterator<T*, Container>>
+{
+    static T* to_address(const __gnu_cxx::__normal_iterator<T*, Container>& i)
+    {
+        return i.base();
+    }
+};
+#endif
+
+TICK_TRAIT(is_contiguous_iterator, is_random_access_iterator<_>)
+{
+    template<class I>
+    auto require(const I& i) -> valid<
+        TICK_RETURNS(contiguous_iterator_traits<I>::to_address(i), typename std::add_pointer<typename std::iterator_traits<I>::reference>::type)
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_coroutine_handle.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_COROUTINE_HANDLE_H
+#define TICK_GUARD_IS_COROUTINE_HANDLE_H
+
+/// is_coroutine_handle
+/// ===================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the type refers to a suspended coroutine the way
+/// `std::coroutine_handle` does. The check only uses the expressions below,
+/// so it also works before C++20 and with other coroutine handle types.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `H` satisfies `is_coroutine_handle` if
+/// 
+/// * The type `H` satisfies [`is_copy_constructible`](is_copy_constructible)
+/// 
+/// And, given:
+/// 
+/// * `h`, a value of type `H`
+/// 
+/// +-----------------------+----------------------------------+
+/// | Expression            | Return type                      |
+/// +=======================+==================================+
+/// | `h.address()`         | implicitly convertible to `void*`|
+/// +-----------------------+----------------------------------+
+/// | `h.done()`            | implicitly convertible to `bool` |
+/// +-----------------------+----------------------------------+
+/// | `h.resume()`          |                                  |
+/// +-----------------------+----------------------------------+
+/// | `h.destroy()`         |                                  |
+/// +-----------------------+----------------------------------+
+/// | `bool(h)`             |                                  |
+/// +-----------------------+----------------------------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_coroutine_handle, is_copy_constructible<_>)
+///     {
+///         template<class H>
+///         auto require(const H& h) -> valid<
+///             decltype(returns<void*>(h.address())),
+///             decltype(returns<bool>(h.done())),
+///             decltype(h.resume()),
+///             decltype(h.destroy()),
+///             decltype(static_cast<bool>(h))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_copy_constructible.h>
+
+namespace tick {
+
+TICK_TRAIT(is_coroutine_handle, is_copy_constructible<_>)
+{
+    template<class H>
+    auto require(const H& h) -> valid<
+        TICK_RETURNS(h.address(), void*),
+        TICK_RETURNS(h.done(), bool),
+        decltype(h.resume()),
+        decltype(h.destroy()),
+        decltype(static_cast<bool>(h))
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_hash.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_HASH_H
+#define TICK_GUARD_IS_HASH_H
+
+/// is_hash
+/// =======
+/// 
+/// Description
+/// -----------
+/// 
+/// A hash is a function object that computes a `std::size_t` hash value
+/// for a key, where equal keys always produce the same hash value.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `H` satisfies `is_hash` for a key type `Key` if
+/// 
+/// * The type `H` satisfies [`is_copy_constructible`](is_copy_constructible)
+/// * The type `H` satisfies [`is_destructible`](is_destructible)
+/// 
+/// And, given
+/// 
+/// * `h`, a value of type `H` or `const H`
+/// * `k`, a value of type `Key` or `const Key`
+/// 
+/// +--------------+---------------+
+/// | Expression   | Return type   |
+/// +==============+===============+
+/// | `h(k)`       | `std::size_t` |
+/// +--------------+---------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_hash,
+///         is_copy_constructible<_1>,
+///         is_destructible<_1>
+///     )
+///     {
+///         template<class H, class Key>
+///         auto require(const H& h, const Key& k) -> valid<
+///             decltype(returns<std::size_t>(h(k)))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_copy_constructible.h>
+#include <tick/traits/is_destructible.h>
+
+namespace tick {
+
+TICK_TRAIT(is_hash,
+    is_copy_constructible<_1>,
+    is_destructible<_1>
+)
+{
+    template<class H, class Key>
+    auto require(const H& h, const Key& k) -> valid<
+        TICK_RETURNS(h(k), std::size_t)
+    >;
+};
+
+}
+
+#endif
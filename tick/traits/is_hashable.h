@@ -0,0 +1,50 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_hashable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_HASHABLE_H
+#define TICK_GUARD_IS_HASHABLE_H
+
+/// is_hashable
+/// ===========
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if type `T` can be hashed with `std::hash<T>`, either because it
+/// is provided by the standard library or because it has been specialized.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_hashable)
+///     {
+///         template<class T>
+///         auto require(const T& x) -> valid<
+///             decltype(returns<std::size_t>(std::hash<T>()(x))),
+///             is_true<is_hash<std::hash<T>, T>>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_hash.h>
+#include <functional>
+
+namespace tick {
+
+TICK_TRAIT(is_hashable)
+{
+    template<class T>
+    auto require(const T& x) -> valid<
+        TICK_RETURNS(std::hash<T>()(x), std::size_t),
+        is_true<is_hash<std::hash<T>, T>>
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_lock_free_atomic.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_LOCK_FREE_ATOMIC_H
+#define TICK_GUARD_IS_LOCK_FREE_ATOMIC_H
+
+/// is_lock_free_atomic
+/// ===================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if `std::atomic<T>` is always lock free, so that loading and
+/// storing a `T` atomically are single instructions rather than calls that
+/// take a hidden lock.
+/// 
+/// Before C++17, where `std::atomic<T>::is_always_lock_free` is not
+/// available, this is decided from the size of `T` and the
+/// `ATOMIC_*_LOCK_FREE` macros for the integer of the same size.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `T` satisfies `is_lock_free_atomic` if
+/// 
+/// * The type `T` satisfies [`is_trivially_copyable`](is_trivially_copyable)
+/// * `std::atomic<T>::is_always_lock_free` is true
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_lock_free_atomic, is_trivially_copyable<_>)
+///     {
+///         template<class T>
+///         auto require(T&&) -> valid<
+///             is_true_c<std::atomic<T>::is_always_lock_free>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_trivially_copyable.h>
+#include <atomic>
+#include <type_traits>
+
+namespace tick {
+
+namespace detail {
+
+// The types that `std::atomic` can be instantiated with, which leaves out
+// arrays
+template<class T>
+struct is_atomic_value
+: integral_constant<bool, (
+    is_trivially_copyable<T>::value and
+    std::is_copy_constructible<T>::value and
+    std::is_copy_assignable<T>::value
+)>
+{};
+
+#if defined(__cpp_lib_atomic_is_always_lock_free)
+
+template<class T, bool=is_atomic_value<T>::value>
+struct is_always_lock_free
+: integral_constant<bool, std::atomic<T>::is_always_lock_free>
+{};
+
+#else
+
+template<std::size_t N>
+struct is_always_lock_free_size
+: false_type
+{};
+
+template<>
+struct is_always_lock_free_size<1>
+: integral_constant<bool, ATOMIC_CHAR_LOCK_FREE == 2>
+{};
+
+template<>
+struct is_always_lock_free_size<2>
+: integral_constant<bool, ATOMIC_SHORT_LOCK_FREE == 2>
+{};
+
+template<>
+struct is_always_lock_free_size<4>
+: integral_constant<bool, ATOMIC_INT_LOCK_FREE == 2>
+{};
+
+template<>
+struct is_always_lock_free_size<8>
+: integral_constant<bool, ATOMIC_LLONG_LOCK_FREE == 2>
+{};
+
+template<class T, bool=is_atomic_value<T>::value>
+struct is_always_lock_free
+: is_always_lock_free_size<sizeof(T)>
+{};
+
+#endif
+
+template<class T>
+struct is_always_lock_free<T, false>
+: false_type
+{};
+
+}
+
+TICK_TRAIT(is_lock_free_atomic, is_trivially_copyable<_>)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true<detail::is_always_lock_free<typename std::remove_cv<typename std::remove_reference<T>::type>::type>>
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_lockable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_LOCKABLE_H
+#define TICK_GUARD_IS_LOCKABLE_H
+
+/// is_lockable
+/// ===========
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the type can also try to take ownership without blocking, as
+/// required by `std::unique_lock` and `std::lock`.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `L` satisfies `is_lockable` if
+/// 
+/// * The type `L` satisfies [`is_basic_lockable`](is_basic_lockable)
+/// 
+/// And, given:
+/// 
+/// * `m`, a value of type `L`
+/// 
+/// +----------------+----------------------------------+
+/// | Expression     | Return type                      |
+/// +================+==================================+
+/// | `m.try_lock()` | implicitly convertible to `bool` |
+/// +----------------+----------------------------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_lockable, is_basic_lockable<_>)
+///     {
+///         template<class L>
+///         auto require(L& m) -> valid<
+///             decltype(returns<bool>(m.try_lock()))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_basic_lockable.h>
+
+namespace tick {
+
+TICK_TRAIT(is_lockable, is_basic_lockable<_>)
+{
+    template<class L>
+    auto require(L&& m) -> valid<
+        TICK_RETURNS(m.try_lock(), bool)
+    >;
+};
+
+}
+
+#endif
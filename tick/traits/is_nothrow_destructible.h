@@ -0,0 +1,47 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_nothrow_destructible.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_NOTHROW_DESTRUCTIBLE_H
+#define TICK_GUARD_IS_NOTHROW_DESTRUCTIBLE_H
+
+/// is_nothrow_destructible
+/// =======================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if type `T` can be destructed without throwing an exception.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_nothrow_destructible, is_destructible<_>)
+///     {
+///         template<class T>
+///         auto require(T&& x) -> valid<
+///             is_true_c<noexcept(x.~T())>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_destructible.h>
+#include <type_traits>
+
+namespace tick {
+
+TICK_TRAIT(is_nothrow_destructible, is_destructible<_>)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true<std::is_nothrow_destructible<T>>
+    >;
+};
+
+}
+
+#endif
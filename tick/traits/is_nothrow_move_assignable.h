@@ -0,0 +1,48 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_nothrow_move_assignable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_NOTHROW_MOVE_ASSIGNABLE_H
+#define TICK_GUARD_IS_NOTHROW_MOVE_ASSIGNABLE_H
+
+/// is_nothrow_move_assignable
+/// ==========================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if type `T` can be assigned from an rvalue without throwing an
+/// exception.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_nothrow_move_assignable, is_move_assignable<_>)
+///     {
+///         template<class T>
+///         auto require(T&& x) -> valid<
+///             is_true_c<noexcept(x = std::declval<T>())>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_move_assignable.h>
+#include <type_traits>
+
+namespace tick {
+
+TICK_TRAIT(is_nothrow_move_assignable, is_move_assignable<_>)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true<std::is_nothrow_move_assignable<T>>
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_nothrow_move_constructible.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_NOTHROW_MOVE_CONSTRUCTIBLE_H
+#define TICK_GUARD_IS_NOTHROW_MOVE_CONSTRUCTIBLE_H
+
+/// is_nothrow_move_constructible
+/// =============================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if type `T` can be constructed from an rvalue without throwing an
+/// exception. Containers use it to decide whether their elements can be moved,
+/// rather than copied, when they grow.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_nothrow_move_constructible, is_move_constructible<_>)
+///     {
+///         template<class T>
+///         auto require(T&& x) -> valid<
+///             is_true_c<noexcept(T(std::declval<T>()))>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_move_constructible.h>
+#include <type_traits>
+
+namespace tick {
+
+TICK_TRAIT(is_nothrow_move_constructible, is_move_constructible<_>)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true<std::is_nothrow_move_constructible<T>>
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_nothrow_swappable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_NOTHROW_SWAPPABLE_H
+#define TICK_GUARD_IS_NOTHROW_SWAPPABLE_H
+
+/// is_nothrow_swappable
+/// ====================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if type `T` can be swapped, with either `std::swap` or an ADL
+/// overload of `swap`, without throwing an exception.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_nothrow_swappable, is_swappable<_>)
+///     {
+///         using std::swap;
+///         template<class T>
+///         auto require(T&& x) -> valid<
+///             is_true_c<noexcept(swap(x, x))>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_swappable.h>
+
+namespace tick_adl { namespace nothrow_swap {
+
+// The swap declared in tick_adl has no exception specification, so the
+// check is done in a scope that only sees std::swap and ADL overloads
+using std::swap;
+
+template<class T>
+struct is_nothrow_swappable_impl
+: std::integral_constant<bool, noexcept(swap(std::declval<T&>(), std::declval<T&>()))>
+{};
+
+}}
+
+namespace tick {
+
+TICK_TRAIT(is_nothrow_swappable, is_swappable<_>)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true<tick_adl::nothrow_swap::is_nothrow_swappable_impl<T>>
+    >;
+};
+
+}
+
+#endif
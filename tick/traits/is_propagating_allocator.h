@@ -0,0 +1,51 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_propagating_allocator.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_PROPAGATING_ALLOCATOR_H
+#define TICK_GUARD_IS_PROPAGATING_ALLOCATOR_H
+
+/// is_propagating_allocator
+/// ========================
+/// 
+/// Description
+/// -----------
+/// 
+/// An allocator that is carried along with the storage when a container is
+/// move assigned or swapped. A container can then take over the storage of
+/// another container without comparing their allocators.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_propagating_allocator, is_allocator<_>)
+///     {
+///         template<class A>
+///         auto require(const A&) -> valid<
+///             is_true<typename std::allocator_traits<A>::propagate_on_container_move_assignment>,
+///             is_true<typename std::allocator_traits<A>::propagate_on_container_swap>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_allocator.h>
+#include <memory>
+
+namespace tick {
+
+TICK_TRAIT(is_propagating_allocator, is_allocator<_>)
+{
+    template<class A>
+    auto require(const A&) -> valid<
+        is_true<typename std::allocator_traits<A>::propagate_on_container_move_assignment>,
+        is_true<typename std::allocator_traits<A>::propagate_on_container_swap>
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_reservable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_RESERVABLE_H
+#define TICK_GUARD_IS_RESERVABLE_H
+
+/// is_reservable
+/// =============
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the container can allocate room for its elements ahead of
+/// time, so that adding elements up to its `capacity()` does not allocate.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `C` satisfies `is_reservable` if
+/// 
+/// * The type `C` satisfies [`is_container`](is_container)
+/// 
+/// And, given
+/// 
+/// * `size_type`, the type denoted by `C::size_type`
+/// * `a`, a value of type `C`
+/// * `n`, a value of type `size_type`
+/// 
+/// +------------------+---------------+
+/// | Expression       | Return type   |
+/// +==================+===============+
+/// | `a.reserve(n)`   |               |
+/// +------------------+---------------+
+/// | `a.capacity()`   | `size_type`   |
+/// +------------------+---------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_reservable, is_container<_>)
+///     {
+///         template<class C>
+///         auto require(const C& x) -> valid<
+///             decltype(as_mutable(x).reserve(std::declval<typename C::size_type>())),
+///             decltype(returns<typename C::size_type>(x.capacity()))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_container.h>
+
+namespace tick {
+
+TICK_TRAIT(is_reservable, is_container<_>)
+{
+    template<class C>
+    auto require(const C& x) -> valid<
+        decltype(as_mutable(x).reserve(std::declval<typename C::size_type>())),
+        TICK_RETURNS(x.capacity(), typename C::size_type)
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_segmented_iterator.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_SEGMENTED_ITERATOR_H
+#define TICK_GUARD_IS_SEGMENTED_ITERATOR_H
+
+/// is_segmented_iterator
+/// =====================
+///
+/// Description
+/// -----------
+///
+/// A segmented iterator walks a sequence that is stored as a series of
+/// contiguous segments, such as the blocks of a `std::deque`. Besides
+/// iterating element by element, it can be split into an iterator to its
+/// segment and a local iterator within that segment, so an algorithm can run
+/// a simple loop over each segment instead of checking for the end of a
+/// segment on every increment.
+///
+/// An iterator is made segmented by specializing
+/// `tick::segmented_iterator_traits`. A specialization for the iterators of
+/// `std::deque` is provided with libstdc++.
+///
+/// Requirements
+/// ------------
+///
+/// The type `It` satisfies `is_segmented_iterator` if
+///
+/// * The type `It` satisfies [`is_forward_iterator`](is_forward_iterator)
+///
+/// And, given
+///
+/// * `Traits`, the type `segmented_iterator_traits<It>`
+/// * `segment_iterator`, the type denoted by `Traits::segment_iterator`, which satisfies [`is_forward_iterator`](is_forward_iterator)
+/// * `local_iterator`, the type denoted by `Traits::local_iterator`, which satisfies [`is_random_access_iterator`](is_random_access_iterator)
+/// * `i`, a value of type `It` or `const It`
+/// * `s`, a value of type `segment_iterator`
+/// * `l`, a value of type `local_iterator` in `[Traits::begin(s), Traits::end(s)]`
+///
+/// +-------------------------+--------------------+---------------------------------------------------------------------------------------+
+/// | Expression              | Return type        | Description                                                                           |
+/// +=========================+====================+=======================================================================================+
+/// | `Traits::segment(i)`    | `segment_iterator` | The segment that `i` points into                                                      |
+/// +-------------------------+--------------------+---------------------------------------------------------------------------------------+
+/// | `Traits::local(i)`      | `local_iterator`   | The position of `i` within its segment                                                |
+/// +-------------------------+--------------------+---------------------------------------------------------------------------------------+
+/// | `Traits::begin(s)`      | `local_iterator`   | The first element of the segment                                                      |
+/// +-------------------------+--------------------+---------------------------------------------------------------------------------------+
+/// | `Traits::end(s)`        | `local_iterator`   | One past the last element of the segment                                              |
+/// +-------------------------+--------------------+---------------------------------------------------------------------------------------+
+/// | `Traits::compose(s, l)` | `It`               | The iterator at `l` within `s`, where the end of `s` is the start of the next segment |
+/// +-------------------------+--------------------+---------------------------------------------------------------------------------------+
+///
+/// Synopsis
+/// --------
+///
+///     template<class Iterator>
+///     struct segmented_iterator_traits;
+///
+///     TICK_TRAIT(is_segmented_iterator, is_forward_iterator<_>)
+///     {
+///         template<class I>
+///         auto require(const I& i) -> valid<
+///             has_type<typename segmented_iterator_traits<I>::segment_iterator, is_forward_iterator<_>>,
+///             has_type<typename segmented_iterator_traits<I>::local_iterator, is_random_access_iterator<_>>,
+///             decltype(returns<typename segmented_iterator_traits<I>::segment_iterator>(segmented_iterator_traits<I>::segment(i))),
+///             decltype(returns<typename segmented_iterator_traits<I>::local_iterator>(segmented_iterator_traits<I>::local(i))),
+///             decltype(returns<typename segmented_iterator_traits<I>::local_iterator>(segmented_iterator_traits<I>::begin(segmented_iterator_traits<I>::segment(i)))),
+///             decltype(returns<typename segmented_iterator_traits<I>::local_iterator>(segmented_iterator_traits<I>::end(segmented_iterator_traits<I>::segment(i)))),
+///             decltype(returns<I>(segmented_iterator_traits<I>::compose(segmented_iterator_traits<I>::segment(i), segmented_iterator_traits<I>::local(i))))
+///         >;
+///     };
+///
+
+#include <tick/builder.h>
+#include <tick/traits/is_forward_iterator.h>
+#include <tick/traits/is_random_access_iterator.h>
+#include <deque>
+
+namespace tick {
+
+template<class Iterator>
+struct segmented_iterator_traits
+{};
+
+#ifdef __GLIBCXX__
+namespace detail {
+
+template<class T, class Ref, class Ptr>
+struct deque_segmented_iterator_traits
+{
+    typedef std::_Deque_iterator<T, Ref, Ptr> iterator;
+    typedef typename iterator::_Map_pointer segment_iterator;
+    typedef Ptr local_iterator;
+
+    static segment_iterator segment(const iterator& i)
+    {
+        return i._M_node;
+    }
+
+    static local_iterator local(const iterator& i)
+    {
+        return i._M_cur;
+    }
+
+    static local_iterator begin(segment_iterator s)
+    {
+        return *s;
+    }
+
+    static local_iterator end(segment_iterator s)
+    {
+        return *s + iterator::_S_buffer_size();
+    }
+
+    static iterator compose(segment_iterator s, local_iterator l)
+    {
+        if (l == end(s)) l = *++s;
+        iterator i;
+        i._M_set_node(s);
+        i._M_cur = const_cast<T*>(l);
+        return i;
+    }
+};
+
+}
+
+template<class T>
+struct segmented_iterator_traits<std::_Deque_iterator<T, T&, T*>>
+: detail::deque_segmented_iterator_traits<T, T&, T*>
+{};
+
+template<class T>
+struct segmented_iterator_traits<std::_Deque_iterator<T, const T&, const T*>>
+: detail::deque_segmented_iterator_traits<T, const T&, const T*>
+{};
+#endif
+
+TICK_TRAIT(is_segmented_iterator, is_forward_iterator<_>)
+{
+    template<class I>
+    auto require(const I& i) -> valid<
+        has_type<typename segmented_iterator_traits<I>::segment_iterator, is_forward_iterator<_>>,
+        has_type<typename segmented_iterator_traits<I>::local_iterator, is_random_access_iterator<_>>,
+        TICK_RETURNS(segmented_iterator_traits<I>::segment(i), typename segmented_iterator_traits<I>::segment_iterator),
+        TICK_RETURNS(segmented_iterator_traits<I>::local(i), typename segmented_iterator_traits<I>::local_iterator),
+        TICK_RETURNS(segmented_iterator_traits<I>::begin(segmented_iterator_traits<I>::segment(i)), typename segmented_iterator_traits<I>::local_iterator),
+        TICK_RETURNS(segmented_iterator_traits<I>::end(segmented_iterator_traits<I>::segment(i)), typename segmented_iterator_traits<I>::local_iterator),
+        TICK_RETURNS(segmented_iterator_traits<I>::compose(segmented_iterator_traits<I>::segment(i), segmented_iterator_traits<I>::local(i)), I)
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_shared_lockable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_SHARED_LOCKABLE_H
+#define TICK_GUARD_IS_SHARED_LOCKABLE_H
+
+/// is_shared_lockable
+/// ==================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the type provides shared ownership, where several execution
+/// agents may hold the lock at the same time, as required by
+/// `std::shared_lock`.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `L` satisfies `is_shared_lockable` if
+/// 
+/// Given:
+/// 
+/// * `m`, a value of type `L`
+/// 
+/// +-----------------------+----------------------------------+
+/// | Expression            | Return type                      |
+/// +=======================+==================================+
+/// | `m.lock_shared()`     |                                  |
+/// +-----------------------+----------------------------------+
+/// | `m.try_lock_shared()` | implicitly convertible to `bool` |
+/// +-----------------------+----------------------------------+
+/// | `m.unlock_shared()`   |                                  |
+/// +-----------------------+----------------------------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_shared_lockable)
+///     {
+///         template<class L>
+///         auto require(L& m) -> valid<
+///             decltype(m.lock_shared()),
+///             decltype(returns<bool>(m.try_lock_shared())),
+///             decltype(m.unlock_shared())
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+
+namespace tick {
+
+TICK_TRAIT(is_shared_lockable)
+{
+    template<class L>
+    auto require(L&& m) -> valid<
+        decltype(m.lock_shared()),
+        TICK_RETURNS(m.try_lock_shared(), bool),
+        decltype(m.unlock_shared())
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_size_feedback_allocator.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_SIZE_FEEDBACK_ALLOCATOR_H
+#define TICK_GUARD_IS_SIZE_FEEDBACK_ALLOCATOR_H
+
+/// is_size_feedback_allocator
+/// ==========================
+/// 
+/// Description
+/// -----------
+/// 
+/// An allocator that can report how much it really allocated. The
+/// `allocate_at_least(n)` member returns an object with a `ptr` to storage
+/// for at least `n` objects, and the actual number of objects in `count`.
+/// The storage is deallocated with any size between `n` and `count`.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_size_feedback_allocator, is_allocator<_>)
+///     {
+///         template<class A>
+///         auto require(const A& a) -> valid<
+///             decltype(returns<typename std::allocator_traits<A>::pointer>(
+///                 as_mutable(a).allocate_at_least(std::declval<std::size_t>()).ptr
+///             )),
+///             decltype(returns<std::size_t>(
+///                 as_mutable(a).allocate_at_least(std::declval<std::size_t>()).count
+///             ))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_allocator.h>
+#include <memory>
+
+namespace tick {
+
+TICK_TRAIT(is_size_feedback_allocator, is_allocator<_>)
+{
+    template<class A>
+    auto require(const A& a) -> valid<
+        TICK_RETURNS(as_mutable(a).allocate_at_least(std::declval<std::size_t>()).ptr, typename std::allocator_traits<A>::pointer),
+        TICK_RETURNS(as_mutable(a).allocate_at_least(std::declval<std::size_t>()).count, std::size_t)
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_sized_range.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_SIZED_RANGE_H
+#define TICK_GUARD_IS_SIZED_RANGE_H
+
+/// is_sized_range
+/// ==============
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the type is a range whose number of elements is known in
+/// constant time, either because it has a `size()` member function or
+/// because its iterators are random access.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_sized_range, is_range<_>)
+///     {
+///         template<class T>
+///         auto require(T&& x) -> valid<
+///             is_true_c<(
+///                 // x.size() is convertible to std::size_t
+///                 has_size_member<T>() or
+///                 // begin(x) is a random access iterator
+///                 has_random_access_iterator<T>()
+///             )>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_random_access_iterator.h>
+#include <tick/traits/is_range.h>
+
+namespace tick {
+
+namespace detail {
+
+TICK_TRAIT(has_size_member)
+{
+    template<class T>
+    auto require(const T& x) -> valid<
+        TICK_RETURNS(x.size(), std::size_t)
+    >;
+};
+
+TICK_TRAIT(has_random_access_iterator)
+{
+    template<class T>
+    auto require(T&& x) -> valid<
+        TICK_RETURNS(tick_adl::begin(std::forward<T>(x)), is_random_access_iterator<_>)
+    >;
+};
+
+}
+
+TICK_TRAIT(is_sized_range, is_range<_>)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true_c<(detail::has_size_member<T>() or detail::has_random_access_iterator<T>())>
+    >;
+};
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_timed_lockable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_TIMED_LOCKABLE_H
+#define TICK_GUARD_IS_TIMED_LOCKABLE_H
+
+/// is_timed_lockable
+/// =================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if the type can also try to take ownership for a limited time, as
+/// `std::timed_mutex` does.
+/// 
+/// Requirements
+/// ------------
+/// 
+/// The type `L` satisfies `is_timed_lockable` if
+/// 
+/// * The type `L` satisfies [`is_lockable`](is_lockable)
+/// 
+/// And, given:
+/// 
+/// * `m`, a value of type `L`
+/// * `d`, a `std::chrono::duration`
+/// * `t`, a `std::chrono::time_point`
+/// 
+/// +-----------------------+----------------------------------+
+/// | Expression            | Return type                      |
+/// +=======================+==================================+
+/// | `m.try_lock_for(d)`   | implicitly convertible to `bool` |
+/// +-----------------------+----------------------------------+
+/// | `m.try_lock_until(t)` | implicitly convertible to `bool` |
+/// +-----------------------+----------------------------------+
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_timed_lockable, is_lockable<_>)
+///     {
+///         template<class L>
+///         auto require(L& m) -> valid<
+///             decltype(returns<bool>(m.try_lock_for(std::declval<std::chrono::milliseconds>()))),
+///             decltype(returns<bool>(m.try_lock_until(std::declval<std::chrono::steady_clock::time_point>())))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_lockable.h>
+#include <chrono>
+
+namespace tick {
+
+TICK_TRAIT(is_timed_lockable, is_lockable<_>)
+{
+    template<class L>
+    auto require(L&& m) -> valid<
+        TICK_RETURNS(m.try_lock_for(std::declval<std::chrono::milliseconds>()), bool),
+        TICK_RETURNS(m.try_lock_until(std::declval<std::chrono::steady_clock::time_point>()), bool)
+    >;
+};
+
+}
+
+#endif
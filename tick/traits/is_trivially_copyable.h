@@ -18,14 +18,22 @@
 ///
 
 #include <tick/builder.h>
+#include <type_traits>
 
 namespace tick {
 
-// We use trival for trivally copyable since isn't implemented yet in gcc
+// We use trival for trivally copyable since it isn't implemented before gcc 5
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
 template<class T>
 struct is_trivially_copyable
 : integral_constant<bool, std::is_trivial<T>::value>
 {};
+#else
+template<class T>
+struct is_trivially_copyable
+: integral_constant<bool, std::is_trivially_copyable<T>::value>
+{};
+#endif
 
 }
 
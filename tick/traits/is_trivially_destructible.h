@@ -0,0 +1,49 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_trivially_destructible.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_TRIVIALLY_DESTRUCTIBLE_H
+#define TICK_GUARD_IS_TRIVIALLY_DESTRUCTIBLE_H
+
+/// is_trivially_destructible
+/// =========================
+/// 
+/// Description
+/// -----------
+/// 
+/// Checks if type `T` can be destructed without doing anything, so storage
+/// holding objects of the type can be reused or freed without calling their
+/// destructors.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_trivially_destructible, is_destructible<_>)
+///     {
+///         template<class T>
+///         auto require(T&&) -> valid<
+///             is_true<std::is_trivially_destructible<T>>
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_destructible.h>
+#include <type_traits>
+
+namespace tick {
+
+TICK_TRAIT(is_trivially_destructible, is_destructible<_>)
+{
+    template<class T>
+    auto require(T&&) -> valid<
+        is_true<std::is_trivially_destructible<T>>
+    >;
+};
+
+}
+
+#endif
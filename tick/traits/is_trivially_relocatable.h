@@ -0,0 +1,57 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_trivially_relocatable.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_TRIVIALLY_RELOCATABLE_H
+#define TICK_GUARD_IS_TRIVIALLY_RELOCATABLE_H
+
+/// is_trivially_relocatable
+/// ========================
+/// 
+/// Description
+/// -----------
+/// 
+/// If a type can be relocated, that is moved to new storage with the old
+/// object destroyed afterwards, by copying its bytes with `memcpy` and then
+/// forgetting the old storage.
+/// 
+/// Every trivially copyable type is trivially relocatable. Other types can
+/// opt in by specializing the trait:
+/// 
+///     namespace tick {
+///     template<>
+///     struct is_trivially_relocatable<my_handle>
+///     : true_type
+///     {};
+///     }
+/// 
+/// Synopsis
+/// --------
+/// 
+///     template<class T>
+///     struct is_trivially_relocatable;
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_trivially_copyable.h>
+#include <memory>
+
+namespace tick {
+
+template<class T>
+struct is_trivially_relocatable
+: integral_constant<bool, is_trivially_copyable<T>::value>
+{};
+
+// The default deleter is empty and `unique_ptr` never points into itself
+template<class T>
+struct is_trivially_relocatable<std::unique_ptr<T>>
+: true_type
+{};
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_unordered_associative_container.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef TICK_GUARD_IS_UNORDERED_ASSOCIATIVE_CONTAINER_H
+#define TICK_GUARD_IS_UNORDERED_ASSOCIATIVE_CONTAINER_H
+
+/// is_unordered_associative_container
+/// ==================================
+/// 
+/// Description
+/// -----------
+/// 
+/// An unordered associative container provides fast lookup of objects based
+/// on keys, by hashing the keys.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     TICK_TRAIT(is_unordered_associative_container, is_container<_>)
+///     {
+///         template<class T>
+///         auto require(const T& x) -> valid<
+///             has_type<typename T::key_type, is_destructible<_>>,
+///             has_type<typename T::hasher, is_hash<_, typename T::key_type>>,
+///             has_type<typename T::key_equal, is_predicate<_, typename T::key_type, typename T::key_type>>,
+///             decltype(returns<typename T::hasher>(x.hash_function())),
+///             decltype(returns<typename T::key_equal>(x.key_eq())),
+///             decltype(returns<typename T::const_iterator>(x.find(std::declval<typename T::key_type>()))),
+///             decltype(returns<typename T::size_type>(x.count(std::declval<typename T::key_type>()))),
+///             decltype(returns<typename T::size_type>(x.bucket_count())),
+///             decltype(returns<float>(x.load_factor())),
+///             decltype(returns<float>(x.max_load_factor())),
+///             decltype(as_mutable(x).rehash(std::declval<typename T::size_type>())),
+///             decltype(as_mutable(x).reserve(std::declval<typename T::size_type>()))
+///         >;
+///     };
+/// 
+
+#include <tick/builder.h>
+#include <tick/traits/is_container.h>
+#include <tick/traits/is_hash.h>
+#include <tick/traits/is_predicate.h>
+
+namespace tick {
+
+TICK_TRAIT(is_unordered_associative_container, is_container<_>)
+{
+    template<class T>
+    auto require(const T& x) -> valid<
+        has_type<typename T::key_type, is_destructible<_>>,
+        has_type<typename T::hasher, is_hash<_, typename T::key_type>>,
+        has_type<typename T::key_equal, is_predicate<_, typename T::key_type, typename T::key_type>>,
+        TICK_RETURNS(x.hash_function(), typename T::hasher),
+        TICK_RETURNS(x.key_eq(), typename T::key_equal),
+        TICK_RETURNS(x.find(std::declval<typename T::key_type>()), typename T::const_iterator),
+        TICK_RETURNS(x.count(std::declval<typename T::key_type>()), typename T::size_type),
+        TICK_RETURNS(x.bucket_count(), typename T::size_type),
+        TICK_RETURNS(x.load_factor(), float),
+        TICK_RETURNS(x.max_load_factor(), float),
+        decltype(as_mutable(x).rehash(std::declval<typename T::size_type>())),
+        decltype(as_mutable(x).reserve(std::declval<typename T::size_type>()))
+    >;
+};
+
+}
+
+#endif